@@ -0,0 +1,93 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/adaptivetimestep.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace smash {
+
+AdaptiveTimeStep::AdaptiveTimeStep(Configuration &config, double delta_time,
+                                   double max_cross_section)
+    : min_dt_(config.take({"General", "Adaptive_Time_Step", "Min_Delta_Time"},
+                          0.1 * delta_time)),
+      max_dt_(config.take({"General", "Adaptive_Time_Step", "Max_Delta_Time"},
+                          10. * delta_time)),
+      target_actions_(config.take(
+          {"General", "Adaptive_Time_Step", "Actions_Per_Particle"}, 0.1)),
+      mean_free_time_fraction_(config.take(
+          {"General", "Adaptive_Time_Step", "Mean_Free_Time_Fraction"}, 1.)),
+      max_change_(
+          config.take({"General", "Adaptive_Time_Step", "Max_Change"}, 2.)),
+      max_cross_section_(max_cross_section) {
+  /*!\Userguide
+   * \page input_general_
+   * \n
+   * **Adaptive time steps**\n
+   * With Time_Step_Mode = Adaptive, Delta_Time is the size of the first time
+   * step. Every following step is chosen from the last one, such that the
+   * number of actions per particle approaches a target value. It is further
+   * limited by a fraction of the mean free time at the largest density in the
+   * grid and, with potentials, by a tenth of the time in which the potentials
+   * change the momenta. The output times are not affected. The parameters
+   * are given in the section \key Adaptive_Time_Step of \key General:
+   *
+   * \key Min_Delta_Time (double, optional, default = Delta_Time / 10): \n
+   * Smallest time step [fm].
+   *
+   * \key Max_Delta_Time (double, optional, default = 10 * Delta_Time): \n
+   * Largest time step [fm].
+   *
+   * \key Actions_Per_Particle (double, optional, default = 0.1): \n
+   * Desired number of performed actions per particle in a time step.
+   *
+   * \key Mean_Free_Time_Fraction (double, optional, default = 1.0): \n
+   * Largest fraction of the mean free time, computed with the largest cross
+   * section at the largest density, covered by a time step.
+   *
+   * \key Max_Change (double, optional, default = 2.0): \n
+   * Largest factor by which a time step can grow or shrink with respect to
+   * the previous one.
+   */
+  if (!(min_dt_ > 0.) || max_dt_ < min_dt_) {
+    throw std::invalid_argument(
+        "Adaptive_Time_Step: Min_Delta_Time has to be positive and not larger "
+        "than Max_Delta_Time.");
+  }
+  if (!(target_actions_ > 0.) || !(mean_free_time_fraction_ > 0.) ||
+      !(max_change_ > 1.)) {
+    throw std::invalid_argument(
+        "Adaptive_Time_Step: Actions_Per_Particle and Mean_Free_Time_Fraction "
+        "have to be positive and Max_Change larger than 1.");
+  }
+}
+
+double AdaptiveTimeStep::next_timestep(
+    double dt, const TimeStepMeasurements &measured) const {
+  // Steer the number of actions per particle towards the target.
+  double next = dt * max_change_;
+  if (measured.actions_per_particle > 0.) {
+    next = dt * std::min(max_change_,
+                         std::max(1. / max_change_,
+                                  target_actions_ /
+                                      measured.actions_per_particle));
+  }
+  // Particles moving with the speed of light collide every 1/(n sigma).
+  const double collision_rate = measured.max_density * max_cross_section_;
+  if (collision_rate > 0.) {
+    next = std::min(next, mean_free_time_fraction_ / collision_rate);
+  }
+  // The same safety factor as in update_momenta
+  constexpr double safety_factor = 0.1;
+  next = std::min(next, safety_factor * measured.force_time_scale);
+  return std::min(max_dt_, std::max(min_dt_, next));
+}
+
+}  // namespace smash
@@ -0,0 +1,177 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/arena.h"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <ostream>
+
+namespace smash {
+
+constexpr std::size_t Arena::chunk_size;
+
+/**
+ * The arena holds one reference to each of its chunks and every live object
+ * another one, such that the chunk is freed by whoever drops the last
+ * reference.
+ */
+struct Arena::Chunk {
+  /// The owning arena and the live objects
+  std::atomic<std::size_t> references{1};
+  /// Memory of the objects
+  alignas(std::max_align_t) char memory[chunk_size];
+};
+
+/// Aligned like std::max_align_t, such that the object after it is, too.
+struct alignas(std::max_align_t) Arena::Header {
+  /// Chunk of the object, nullptr if it is allocated on the heap
+  Chunk *chunk;
+};
+
+namespace {
+/// Arenas of all running threads and the statistics of finished ones
+struct Registry {
+  /// Guards the members
+  std::mutex mutex;
+  /// Arenas of the running threads
+  std::vector<const Arena *> arenas;
+  /// Statistics of the arenas of finished threads
+  Arena::Statistics finished;
+};
+
+/// \return the registry of all arenas.
+Registry &registry() {
+  static Registry instance;
+  return instance;
+}
+
+/**
+ * Increment a counter that is only written by one thread.
+ *
+ * \param[in,out] counter The counter.
+ * \param[in] n The increment.
+ */
+void add(std::atomic<std::uint64_t> &counter, std::uint64_t n = 1) {
+  counter.store(counter.load(std::memory_order_relaxed) + n,
+                std::memory_order_relaxed);
+}
+}  // namespace
+
+Arena::Arena() {
+  Registry &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  reg.arenas.push_back(this);
+}
+
+Arena::~Arena() {
+  for (Chunk *chunk : chunks_) {
+    if (chunk->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete chunk;
+    }
+  }
+  Registry &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  reg.arenas.erase(std::find(reg.arenas.begin(), reg.arenas.end(), this));
+  reg.finished.allocations += allocations_;
+  reg.finished.heap_allocations += heap_allocations_;
+  reg.finished.recycled_chunks += recycled_chunks_;
+  reg.finished.reserved_bytes += reserved_bytes_;
+}
+
+Arena &Arena::local() {
+  static thread_local Arena arena;
+  return arena;
+}
+
+void *Arena::allocate(std::size_t size) {
+  // Keep the next object aligned
+  const std::size_t alignment = alignof(std::max_align_t);
+  const std::size_t total =
+      sizeof(Header) + (size + alignment - 1) / alignment * alignment;
+  Arena &arena = local();
+  Header *header;
+  if (total > chunk_size / 8) {
+    header = static_cast<Header *>(::operator new(total));
+    header->chunk = nullptr;
+    add(arena.heap_allocations_);
+  } else {
+    header = static_cast<Header *>(arena.allocate_in_chunk(total));
+    header->chunk = arena.current_;
+    add(arena.allocations_);
+  }
+  return header + 1;
+}
+
+void *Arena::allocate_in_chunk(std::size_t size) {
+  // Start over in the current chunk if all of its objects were released.
+  if (current_ && offset_ > 0 &&
+      current_->references.load(std::memory_order_acquire) == 1) {
+    offset_ = 0;
+    add(recycled_chunks_);
+  }
+  if (!current_ || offset_ + size > chunk_size) {
+    current_ = nullptr;
+    for (Chunk *chunk : chunks_) {
+      if (chunk->references.load(std::memory_order_acquire) == 1) {
+        current_ = chunk;
+        add(recycled_chunks_);
+        break;
+      }
+    }
+    if (!current_) {
+      chunks_.push_back(new Chunk);
+      current_ = chunks_.back();
+      add(reserved_bytes_, chunk_size);
+    }
+    offset_ = 0;
+  }
+  void *ptr = current_->memory + offset_;
+  offset_ += size;
+  current_->references.fetch_add(1, std::memory_order_relaxed);
+  return ptr;
+}
+
+void Arena::deallocate(void *ptr) noexcept {
+  if (!ptr) {
+    return;
+  }
+  Header *header = static_cast<Header *>(ptr) - 1;
+  Chunk *chunk = header->chunk;
+  if (!chunk) {
+    ::operator delete(header);
+  } else if (chunk->references.fetch_sub(1, std::memory_order_acq_rel) ==
+             1) {
+    // The arena of the chunk is already gone.
+    delete chunk;
+  }
+}
+
+Arena::Statistics Arena::statistics() {
+  Registry &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  Statistics stats = reg.finished;
+  for (const Arena *arena : reg.arenas) {
+    stats.allocations += arena->allocations_;
+    stats.heap_allocations += arena->heap_allocations_;
+    stats.recycled_chunks += arena->recycled_chunks_;
+    stats.reserved_bytes += arena->reserved_bytes_;
+  }
+  return stats;
+}
+
+std::ostream &operator<<(std::ostream &out, const Arena::Statistics &stats) {
+  return out << stats.allocations << " allocations in "
+             << stats.reserved_bytes / (1 << 20) << " MiB of chunks, "
+             << stats.recycled_chunks << " chunks recycled, "
+             << stats.heap_allocations << " heap allocations";
+}
+
+}  // namespace smash
@@ -338,21 +338,27 @@ double BoxModus::initial_conditions(Particles *particles,
 int BoxModus::impose_boundary_conditions(Particles *particles,
                                          const OutputsList &output_list) {
   int wraps = 0;
+  // The entries of the particles that crossed a wall and their old positions
+  std::vector<std::pair<unsigned, FourVector>> crossed;
 
-  for (ParticleData &data : *particles) {
-    FourVector position = data.position();
+  particles->update_columns([&](ParticleColumns &columns, unsigned i) {
+    FourVector position = columns.position(i);
     bool wall_hit = enforce_periodic_boundaries(position.begin() + 1,
                                                 position.end(), length_);
     if (wall_hit) {
-      const ParticleData incoming_particle(data);
-      data.set_4position(position);
-      ++wraps;
-      ActionPtr action =
-          make_unique<WallcrossingAction>(incoming_particle, data);
-      for (const auto &output : output_list) {
-        if (!output->is_dilepton_output() && !output->is_photon_output()) {
-          output->at_interaction(*action, 0.);
-        }
+      crossed.emplace_back(i, columns.position(i));
+      columns.set_position(i, position);
+    }
+  });
+  for (const auto &entry : crossed) {
+    const ParticleData &data = particles->at_index(entry.first);
+    ParticleData incoming_particle(data);
+    incoming_particle.set_4position(entry.second);
+    ++wraps;
+    ActionPtr action = make_unique<WallcrossingAction>(incoming_particle, data);
+    for (const auto &output : output_list) {
+      if (!output->is_dilepton_output() && !output->is_photon_output()) {
+        output->at_interaction(*action, 0.);
       }
     }
   }
@@ -9,7 +9,6 @@
 
 #include "smash/bremsstrahlungaction.h"
 #include "smash/crosssectionsbrems.h"
-#include "smash/interpolation2D.h"
 #include "smash/outputinterface.h"
 #include "smash/random.h"
 
@@ -180,12 +179,6 @@ CollisionBranchList BremsstrahlungAction::brems_cross_sections() {
   static const ParticleTypePtr pi_p_particle = &ParticleType::find(pdg::pi_p);
   static const ParticleTypePtr pi_m_particle = &ParticleType::find(pdg::pi_m);
 
-  // Create interpolation objects, if not yet existent; only trigger for one
-  // of them as either all or none is created
-  if (pi0pi0_pipi_dsigma_dtheta_interpolation == nullptr) {
-    create_interpolations();
-  }
-
   // Find cross section corresponding to given sqrt(s)
   double sqrts = sqrt_s();
   double xsection;
@@ -196,8 +189,8 @@ CollisionBranchList BremsstrahlungAction::brems_cross_sections() {
 
     // In the case of two oppositely charged pions as incoming particles,
     // there are two potential final states: pi+ + pi- and pi0 + pi0
-    double xsection_pipi = (*pipi_pipi_opp_interpolation)(sqrts);
-    double xsection_pi0pi0 = (*pipi_pi0pi0_interpolation)(sqrts);
+    double xsection_pipi = brems_xs(BremsChannel::PiPi_PiPi_Opp, sqrts);
+    double xsection_pi0pi0 = brems_xs(BremsChannel::PiPi_Pi0Pi0, sqrts);
 
     // Prevent negative cross sections due to numerics in interpolation
     xsection_pipi = (xsection_pipi <= 0.0) ? really_small : xsection_pipi;
@@ -232,10 +225,10 @@ CollisionBranchList BremsstrahlungAction::brems_cross_sections() {
              reac_ == ReactionType::pi_z_pi_p) {
     // Here the final state hadrons are identical to the initial state hadrons
     if (reac_ == ReactionType::pi_m_pi_m || reac_ == ReactionType::pi_p_pi_p) {
-      xsection = (*pipi_pipi_same_interpolation)(sqrts);
+      xsection = brems_xs(BremsChannel::PiPi_PiPi_Same, sqrts);
     } else {
       // One pi0 in initial and final state
-      xsection = (*pipi0_pipi0_interpolation)(sqrts);
+      xsection = brems_xs(BremsChannel::PiPi0_PiPi0, sqrts);
     }
 
     // Prevent negative cross sections due to numerics in interpolation
@@ -248,7 +241,7 @@ CollisionBranchList BremsstrahlungAction::brems_cross_sections() {
   } else if (reac_ == ReactionType::pi_z_pi_z) {
     // Here we have a hard-coded final state that differs from the initial
     // state, namely: pi0 + pi0 -> pi+- + pi-+ + gamma
-    xsection = (*pi0pi0_pipi_interpolation)(sqrts);
+    xsection = brems_xs(BremsChannel::Pi0Pi0_PiPi, sqrts);
 
     // Prevent negative cross sections due to numerics in interpolation
     xsection = (xsection <= 0.0) ? really_small : xsection;
@@ -266,127 +259,40 @@ CollisionBranchList BremsstrahlungAction::brems_cross_sections() {
 std::pair<double, double> BremsstrahlungAction::brems_diff_cross_sections() {
   static const ParticleTypePtr pi_z_particle = &ParticleType::find(pdg::pi_z);
   const double collision_energy = sqrt_s();
-  double dsigma_dk;
-  double dsigma_dtheta;
+  BremsChannel channel;
 
   if (reac_ == ReactionType::pi_p_pi_m) {
     if (outgoing_particles_[0].type() != *pi_z_particle) {
       // pi+- + pi+-- -> pi+- + pi+- + gamma
-      dsigma_dk =
-          (*pipi_pipi_opp_dsigma_dk_interpolation)(k_, collision_energy);
-      dsigma_dtheta = (*pipi_pipi_opp_dsigma_dtheta_interpolation)(
-          theta_, collision_energy);
+      channel = BremsChannel::PiPi_PiPi_Opp;
     } else {
       // pi+- + pi+-- -> pi0 + pi0 + gamma
-      dsigma_dk = (*pipi_pi0pi0_dsigma_dk_interpolation)(k_, collision_energy);
-      dsigma_dtheta =
-          (*pipi_pi0pi0_dsigma_dtheta_interpolation)(theta_, collision_energy);
+      channel = BremsChannel::PiPi_Pi0Pi0;
     }
   } else if (reac_ == ReactionType::pi_p_pi_p ||
              reac_ == ReactionType::pi_m_pi_m) {
-    dsigma_dk = (*pipi_pipi_same_dsigma_dk_interpolation)(k_, collision_energy);
-    dsigma_dtheta =
-        (*pipi_pipi_same_dsigma_dtheta_interpolation)(theta_, collision_energy);
+    channel = BremsChannel::PiPi_PiPi_Same;
   } else if (reac_ == ReactionType::pi_z_pi_p ||
              reac_ == ReactionType::pi_z_pi_m) {
-    dsigma_dk = (*pipi0_pipi0_dsigma_dk_interpolation)(k_, collision_energy);
-    dsigma_dtheta =
-        (*pipi0_pipi0_dsigma_dtheta_interpolation)(theta_, collision_energy);
+    channel = BremsChannel::PiPi0_PiPi0;
   } else if (reac_ == ReactionType::pi_z_pi_z) {
-    dsigma_dk = (*pi0pi0_pipi_dsigma_dk_interpolation)(k_, collision_energy);
-    dsigma_dtheta =
-        (*pi0pi0_pipi_dsigma_dtheta_interpolation)(theta_, collision_energy);
+    channel = BremsChannel::Pi0Pi0_PiPi;
   } else {
     throw std::runtime_error(
         "Unkown channel when computing differential cross sections for "
         "bremsstrahlung processes.");
   }
+  double dsigma_dk = brems_dsigma_dk(channel, k_, collision_energy);
+  double dsigma_dtheta = brems_dsigma_dtheta(channel, theta_, collision_energy);
 
-  // Prevent negative cross sections due to numerics in interpolation
-  dsigma_dk = (dsigma_dk < 0.0) ? really_small : dsigma_dk;
-  dsigma_dtheta = (dsigma_dtheta < 0.0) ? really_small : dsigma_dtheta;
+  // Prevent vanishing or negative cross sections due to numerics in
+  // interpolation, like for the total cross sections
+  dsigma_dk = (dsigma_dk <= 0.0) ? really_small : dsigma_dk;
+  dsigma_dtheta = (dsigma_dtheta <= 0.0) ? really_small : dsigma_dtheta;
 
   // Combine differential cross sections to a pair
   std::pair<double, double> diff_x_sections = {dsigma_dk, dsigma_dtheta};
 
   return diff_x_sections;
 }
-
-void BremsstrahlungAction::create_interpolations() {
-  // Read in tabularized values for sqrt(s), k and theta
-  std::vector<double> sqrts = BREMS_SQRTS;
-  std::vector<double> photon_momentum = BREMS_K;
-  std::vector<double> photon_angle = BREMS_THETA;
-
-  // Read in tabularized total cross sections
-  std::vector<double> sigma_pipi_pipi_opp = BREMS_PIPI_PIPI_OPP_SIG;
-  std::vector<double> sigma_pipi_pipi_same = BREMS_PIPI_PIPI_SAME_SIG;
-  std::vector<double> sigma_pipi0_pipi0 = BREMS_PIPI0_PIPI0_SIG;
-  std::vector<double> sigma_pipi_pi0pi0 = BREMS_PIPI_PI0PI0_SIG;
-  std::vector<double> sigma_pi0pi0_pipi = BREMS_PI0PI0_PIPI_SIG;
-
-  // Read in tabularized differential cross sections dSigma/dk
-  std::vector<double> dsigma_dk_pipi_pipi_opp = BREMS_PIPI_PIPI_OPP_DIFF_SIG_K;
-  std::vector<double> dsigma_dk_pipi_pipi_same =
-      BREMS_PIPI_PIPI_SAME_DIFF_SIG_K;
-  std::vector<double> dsigma_dk_pipi0_pipi0 = BREMS_PIPI0_PIPI0_DIFF_SIG_K;
-  std::vector<double> dsigma_dk_pipi_pi0pi0 = BREMS_PIPI_PI0PI0_DIFF_SIG_K;
-  std::vector<double> dsigma_dk_pi0pi0_pipi = BREMS_PI0PI0_PIPI_DIFF_SIG_K;
-
-  // Read in tabularized differential cross sections dSigma/dtheta
-  std::vector<double> dsigma_dtheta_pipi_pipi_opp =
-      BREMS_PIPI_PIPI_OPP_DIFF_SIG_THETA;
-  std::vector<double> dsigma_dtheta_pipi_pipi_same =
-      BREMS_PIPI_PIPI_SAME_DIFF_SIG_THETA;
-  std::vector<double> dsigma_dtheta_pipi0_pipi0 =
-      BREMS_PIPI0_PIPI0_DIFF_SIG_THETA;
-  std::vector<double> dsigma_dtheta_pipi_pi0pi0 =
-      BREMS_PIPI_PI0PI0_DIFF_SIG_THETA;
-  std::vector<double> dsigma_dtheta_pi0pi0_pipi =
-      BREMS_PI0PI0_PIPI_DIFF_SIG_THETA;
-
-  // Create interpolation objects containing linear interpolations for
-  // total cross sections
-  pipi_pipi_opp_interpolation =
-      make_unique<InterpolateDataLinear<double>>(sqrts, sigma_pipi_pipi_opp);
-  pipi_pipi_same_interpolation =
-      make_unique<InterpolateDataLinear<double>>(sqrts, sigma_pipi_pipi_same);
-  pipi0_pipi0_interpolation =
-      make_unique<InterpolateDataLinear<double>>(sqrts, sigma_pipi0_pipi0);
-  pipi_pi0pi0_interpolation =
-      make_unique<InterpolateDataLinear<double>>(sqrts, sigma_pipi_pi0pi0);
-  pi0pi0_pipi_interpolation =
-      make_unique<InterpolateDataLinear<double>>(sqrts, sigma_pi0pi0_pipi);
-
-  // Create interpolation objects containing bicubic interpolations for
-  // differential dSigma/dk
-  pipi_pipi_opp_dsigma_dk_interpolation = make_unique<InterpolateData2DSpline>(
-      photon_momentum, sqrts, dsigma_dk_pipi_pipi_opp);
-  pipi_pipi_same_dsigma_dk_interpolation = make_unique<InterpolateData2DSpline>(
-      photon_momentum, sqrts, dsigma_dk_pipi_pipi_same);
-  pipi0_pipi0_dsigma_dk_interpolation = make_unique<InterpolateData2DSpline>(
-      photon_momentum, sqrts, dsigma_dk_pipi0_pipi0);
-  pipi_pi0pi0_dsigma_dk_interpolation = make_unique<InterpolateData2DSpline>(
-      photon_momentum, sqrts, dsigma_dk_pipi_pi0pi0);
-  pi0pi0_pipi_dsigma_dk_interpolation = make_unique<InterpolateData2DSpline>(
-      photon_momentum, sqrts, dsigma_dk_pi0pi0_pipi);
-
-  // Create interpolation objects containing bicubic interpolations for
-  // differential dSigma/dtheta
-  pipi_pipi_opp_dsigma_dtheta_interpolation =
-      make_unique<InterpolateData2DSpline>(photon_angle, sqrts,
-                                           dsigma_dtheta_pipi_pipi_opp);
-  pipi_pipi_same_dsigma_dtheta_interpolation =
-      make_unique<InterpolateData2DSpline>(photon_angle, sqrts,
-                                           dsigma_dtheta_pipi_pipi_same);
-  pipi0_pipi0_dsigma_dtheta_interpolation =
-      make_unique<InterpolateData2DSpline>(photon_angle, sqrts,
-                                           dsigma_dtheta_pipi0_pipi0);
-  pipi_pi0pi0_dsigma_dtheta_interpolation =
-      make_unique<InterpolateData2DSpline>(photon_angle, sqrts,
-                                           dsigma_dtheta_pipi_pi0pi0);
-  pi0pi0_pipi_dsigma_dtheta_interpolation =
-      make_unique<InterpolateData2DSpline>(photon_angle, sqrts,
-                                           dsigma_dtheta_pi0pi0_pipi);
-}
 }  // namespace smash
@@ -0,0 +1,135 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/bufferedoutput.h"
+
+#include <string>
+
+#include "smash/action.h"
+#include "smash/clock.h"
+#include "smash/cxx14compat.h"
+#include "smash/particles.h"
+
+namespace smash {
+
+namespace {
+/**
+ * Name of an output of the same kind as \p target, such that the flags set by
+ * OutputInterface are the same.
+ *
+ * \param[in] target The buffered output.
+ * \return the name.
+ */
+std::string kind_of(const OutputInterface &target) {
+  if (target.is_dilepton_output()) {
+    return "Dileptons";
+  } else if (target.is_photon_output()) {
+    return "Photons";
+  } else if (target.is_IC_output()) {
+    return "SMASH_IC";
+  }
+  return "Buffered";
+}
+
+/**
+ * An action that was already performed, storing everything the outputs need
+ * to know about it.
+ */
+class RecordedAction : public Action {
+ public:
+  /**
+   * Copy the particles, weights and type of \p action.
+   *
+   * \param[in] action The performed action.
+   */
+  explicit RecordedAction(const Action &action)
+      : Action(action.incoming_particles(), action.outgoing_particles(),
+               action.time_of_execution(), action.get_type()),
+        total_weight_(action.get_total_weight()),
+        partial_weight_(action.get_partial_weight()) {}
+
+  double get_total_weight() const override { return total_weight_; }
+  double get_partial_weight() const override { return partial_weight_; }
+
+  /// The final state is already known, so nothing is generated.
+  void generate_final_state() override {}
+
+  void format_debug_output(std::ostream &out) const override {
+    out << "Recorded " << get_type() << " of " << incoming_particles_;
+  }
+
+ private:
+  /// Total weight of the recorded action
+  const double total_weight_;
+  /// Partial weight of the recorded action
+  const double partial_weight_;
+};
+
+/**
+ * \param[in] particles The particles to be copied.
+ * \return a shared copy of \p particles, which can be captured by the
+ *         recorded calls.
+ */
+std::shared_ptr<const Particles> snapshot(const Particles &particles) {
+  auto copy = std::make_shared<Particles>();
+  copy->copy_from(particles);
+  return copy;
+}
+}  // namespace
+
+BufferedOutput::BufferedOutput(const OutputInterface &target)
+    : OutputInterface(kind_of(target)) {}
+
+void BufferedOutput::at_eventstart(const Particles &particles,
+                                   const int event_number) {
+  const auto copy = snapshot(particles);
+  calls_.emplace_back([copy, event_number](OutputInterface &target) {
+    target.at_eventstart(*copy, event_number);
+  });
+}
+
+void BufferedOutput::at_eventend(const Particles &particles,
+                                 const int event_number,
+                                 double impact_parameter, bool empty_event) {
+  const auto copy = snapshot(particles);
+  calls_.emplace_back([=](OutputInterface &target) {
+    target.at_eventend(*copy, event_number, impact_parameter, empty_event);
+  });
+}
+
+void BufferedOutput::at_interaction(const Action &action,
+                                    const double density) {
+  const std::shared_ptr<const Action> copy =
+      std::make_shared<RecordedAction>(action);
+  calls_.emplace_back([copy, density](OutputInterface &target) {
+    target.at_interaction(*copy, density);
+  });
+}
+
+void BufferedOutput::at_intermediate_time(
+    const Particles &particles, const std::unique_ptr<Clock> &clock,
+    const DensityParameters &dens_param) {
+  const auto copy = snapshot(particles);
+  const double time = clock->current_time();
+  const double dt = clock->timestep_duration();
+  calls_.emplace_back([=](OutputInterface &target) {
+    const std::unique_ptr<Clock> recorded_clock =
+        make_unique<UniformClock>(time, dt);
+    target.at_intermediate_time(*copy, recorded_clock, dens_param);
+  });
+}
+
+void BufferedOutput::replay(OutputInterface &target) {
+  for (const auto &call : calls_) {
+    call(target);
+  }
+  calls_.clear();
+}
+
+}  // namespace smash
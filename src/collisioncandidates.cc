@@ -0,0 +1,183 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/collisioncandidates.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "smash/constants.h"
+
+namespace smash {
+
+void ParticleBatch::assign(const ParticleListView &list,
+                           const std::vector<FourVector> &beam_momentum) {
+  particles_.clear();
+  for (std::vector<double> *v :
+       {&t_, &x_, &y_, &z_, &e_, &px_, &py_, &pz_, &coll_e_, &coll_px_,
+        &coll_py_, &coll_pz_}) {
+    v->clear();
+  }
+  for (const ParticleData &p : list) {
+    particles_.push_back(&p);
+    const FourVector &r = p.position();
+    const FourVector &mom = p.momentum();
+    t_.push_back(r.x0());
+    x_.push_back(r.x1());
+    y_.push_back(r.x2());
+    z_.push_back(r.x3());
+    e_.push_back(mom.x0());
+    px_.push_back(mom.x1());
+    py_.push_back(mom.x2());
+    pz_.push_back(mom.x3());
+    const bool use_beam_momentum =
+        static_cast<uint64_t>(p.id()) <
+            static_cast<uint64_t>(beam_momentum.size()) &&
+        p.get_history().collisions_per_particle == 0;
+    const FourVector &coll_mom =
+        use_beam_momentum ? beam_momentum[p.id()] : mom;
+    coll_e_.push_back(coll_mom.x0());
+    coll_px_.push_back(coll_mom.x1());
+    coll_py_.push_back(coll_mom.x2());
+    coll_pz_.push_back(coll_mom.x3());
+  }
+}
+
+/* The kernel is compiled for AVX-512, AVX2 and the target of the build, and
+ * the best variant the CPU supports is selected at runtime. This way the
+ * vector units are used also by binaries that are not built for the machine
+ * they run on. */
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11 && \
+    defined(__x86_64__) && defined(__linux__)
+#define SMASH_TARGET_CLONES                                          \
+  __attribute__((target_clones("arch=x86-64-v4", "arch=x86-64-v3", \
+                               "default")))
+#else
+#define SMASH_TARGET_CLONES
+#endif
+
+namespace {
+/// Pointers to the columns of a ParticleBatch, starting at some position.
+struct BatchColumns {
+  /// Positions [fm]
+  const double *t, *x, *y, *z;
+  /// Momenta [GeV]
+  const double *e, *px, *py, *pz;
+  /// Momenta used for the collision time [GeV]
+  const double *ce, *cpx, *cpy, *cpz;
+};
+
+/**
+ * Mark the candidates among \p n particles for a collision with one
+ * particle, see ParticleBatch::mark_candidates.
+ *
+ * \param[in] one Columns of the particle (first entries)
+ * \param[in] all Columns of the particles to check
+ * \param[in] n Number of particles to check
+ * \param[in] dt Duration of the time step [fm]
+ * \param[in] max_distance_sqr Largest transverse distance squared [fm^2]
+ * \param[out] mark Set to 1 for the candidates and 0 for the others
+ */
+SMASH_TARGET_CLONES
+void mark_candidates_kernel(const BatchColumns &one, const BatchColumns &all,
+                            std::size_t n, double dt, double max_distance_sqr,
+                            unsigned char *__restrict mark) {
+  /* Relative tolerance for the rounding differences to the calculation with
+   * FourVector, e.g. due to fused multiply-adds in the vectorized loop. */
+  constexpr double tolerance = 1e-9;
+  const double t1 = one.t[0], x1 = one.x[0], y1 = one.y[0], z1 = one.z[0];
+  const double e1 = one.e[0], px1 = one.px[0], py1 = one.py[0],
+               pz1 = one.pz[0];
+  const double ce1 = one.ce[0], cpx1 = one.cpx[0], cpy1 = one.cpy[0],
+               cpz1 = one.cpz[0];
+  const double *t = all.t, *x = all.x, *y = all.y, *z = all.z;
+  const double *e = all.e, *px = all.px, *py = all.py, *pz = all.pz;
+  const double *ce = all.ce, *cpx = all.cpx, *cpy = all.cpy, *cpz = all.cpz;
+  /* The loop has no branches, not even short-circuit operators, such that it
+   * is vectorized by the compiler. All values are computed for every pair,
+   * also those that are not used, so they must not cause floating-point
+   * exceptions (see the flags of this file in CMakeLists.txt). */
+  for (std::size_t j = 0; j < n; ++j) {
+    const double dt0 = t1 - t[j], dx = x1 - x[j], dy = y1 - y[j],
+                 dz = z1 - z[j];
+    const double dr2 = dx * dx + dy * dy + dz * dz;
+
+    /* Collision time, as in ScatterActionsFinder::collision_time:
+     * t_coll = -(r_1 - r_2) . (v_1 - v_2) / (v_1 - v_2)^2 */
+    const double dvx = cpx1 * ce[j] - cpx[j] * ce1;
+    const double dvy = cpy1 * ce[j] - cpy[j] * ce1;
+    const double dvz = cpz1 * ce[j] - cpz[j] * ce1;
+    const double dv2 = dvx * dvx + dvy * dvy + dvz * dvz;
+    const double e1e2 = ce1 * ce[j];
+    const bool no_relative_motion = dv2 < really_small * (1. - tolerance);
+    const double safe_dv2 = std::max(dv2, really_small * (1. - tolerance));
+    const double time =
+        -(dx * dvx + dy * dvy + dz * dvz) * (e1e2 / safe_dv2);
+    // Error of the time from the cancellation in the scalar product
+    const double time_error =
+        tolerance * (std::abs(time) + dt +
+                     std::sqrt(dr2 / safe_dv2) * std::abs(e1e2));
+    const bool in_time_step = !no_relative_motion &
+                              (time > -time_error) & (time < dt + time_error);
+
+    /* Transverse distance in the center-of-momentum frame, as in
+     * ScatterAction::transverse_distance_sqr */
+    const double e_tot = e1 + e[j];
+    const double vx = (px1 + px[j]) / e_tot, vy = (py1 + py[j]) / e_tot,
+                 vz = (pz1 + pz[j]) / e_tot;
+    const double v2 = vx * vx + vy * vy + vz * vz;
+    // Too close to the speed of light for a reliable boost
+    const bool light_like = !(v2 < 1. - tolerance);
+    const double gamma = 1. / std::sqrt(1. - std::min(v2, 1. - tolerance));
+    const double boost = gamma / (gamma + 1.);
+    const double r0 = gamma * (dt0 - (dx * vx + dy * vy + dz * vz));
+    const double rc = boost * (r0 + dt0);
+    const double rx = dx - vx * rc, ry = dy - vy * rc, rz = dz - vz * rc;
+    const double de = e1 - e[j], dpx = px1 - px[j], dpy = py1 - py[j],
+                 dpz = pz1 - pz[j];
+    const double p0 = gamma * (de - (dpx * vx + dpy * vy + dpz * vz));
+    const double pc = boost * (p0 + de);
+    const double qx = dpx - vx * pc, qy = dpy - vy * pc, qz = dpz - vz * pc;
+    const double dp2 = qx * qx + qy * qy + qz * qz;
+    const double dr2_cm = rx * rx + ry * ry + rz * rz;
+    const double dpdr = rx * qx + ry * qy + rz * qz;
+    /* Close to the threshold for a vanishing momentum difference, the
+     * smaller of the two results is used. */
+    const bool momentum_difference = dp2 > really_small * (1. - tolerance);
+    const double safe_dp2 = std::max(dp2, really_small * (1. - tolerance));
+    const double distance_sqr =
+        momentum_difference ? dr2_cm - dpdr * dpdr / safe_dp2 : dr2_cm;
+    const bool close =
+        distance_sqr - tolerance * (dr2_cm + 1.) < max_distance_sqr;
+
+    mark[j] = in_time_step & (light_like | close);
+  }
+}
+
+}  // unnamed namespace
+
+void ParticleBatch::mark_candidates(const ParticleBatch &other, std::size_t i,
+                                    double dt, double max_distance_sqr,
+                                    std::vector<unsigned char> &marks) const {
+  marks.resize(size());
+  const BatchColumns one = {&other.t_[i],       &other.x_[i],
+                            &other.y_[i],       &other.z_[i],
+                            &other.e_[i],       &other.px_[i],
+                            &other.py_[i],      &other.pz_[i],
+                            &other.coll_e_[i],  &other.coll_px_[i],
+                            &other.coll_py_[i], &other.coll_pz_[i]};
+  const BatchColumns all = {t_.data(),       x_.data(),       y_.data(),
+                            z_.data(),       e_.data(),       px_.data(),
+                            py_.data(),      pz_.data(),      coll_e_.data(),
+                            coll_px_.data(), coll_py_.data(), coll_pz_.data()};
+  mark_candidates_kernel(one, all, size(), dt, max_distance_sqr, marks.data());
+}
+
+}  // namespace smash
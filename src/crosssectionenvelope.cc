@@ -0,0 +1,213 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/crosssectionenvelope.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include "smash/cxx14compat.h"
+#include "smash/kinematics.h"
+#include "smash/logging.h"
+#include "smash/particletype.h"
+
+namespace smash {
+static constexpr int LFindScatter = LogArea::FindScatter::id;
+
+constexpr int CrossSectionEnvelope::n_bins;
+constexpr double CrossSectionEnvelope::relative_bin_width;
+
+CrossSectionEnvelope::Table::Table(double min_s)
+    : min_sqrts(min_s), bins(n_bins) {
+  for (auto &bin : bins) {
+    bin.store(-1., std::memory_order_relaxed);
+  }
+}
+
+CrossSectionEnvelope::CrossSectionEnvelope(TotalCrossSection total_xs,
+                                           double safety_factor)
+    : total_xs_(std::move(total_xs)),
+      safety_factor_(safety_factor),
+      n_types_(ParticleType::list_all().size()),
+      tables_(new std::atomic<Table *>[n_types_ * n_types_]) {
+  for (std::size_t i = 0; i < n_types_ * n_types_; i++) {
+    tables_[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * \param[in] type A particle type.
+ * \return the position of \p type in ParticleType::list_all().
+ */
+static std::size_t index_of(const ParticleType &type) {
+  return std::addressof(type) - std::addressof(ParticleType::list_all()[0]);
+}
+
+/**
+ * The cross section is symmetric, so only one order of the types is used.
+ *
+ * \param[in] type_a A particle type.
+ * \param[in] type_b Another particle type.
+ * \return the two types, ordered by their position in
+ *         ParticleType::list_all().
+ */
+static std::pair<const ParticleType &, const ParticleType &> ordered(
+    const ParticleType &type_a, const ParticleType &type_b) {
+  if (index_of(type_a) > index_of(type_b)) {
+    return {type_b, type_a};
+  }
+  return {type_a, type_b};
+}
+
+std::pair<CrossSectionEnvelope::Table *, int> CrossSectionEnvelope::find_bin(
+    const ParticleType &first, const ParticleType &second,
+    double sqrt_s) const {
+  std::atomic<Table *> &slot =
+      tables_[index_of(first) * n_types_ + index_of(second)];
+  Table *table = slot.load(std::memory_order_acquire);
+  if (!table) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    table = slot.load(std::memory_order_acquire);
+    if (!table) {
+      owned_tables_.emplace_back(make_unique<Table>(
+          first.min_mass_kinematic() + second.min_mass_kinematic()));
+      table = owned_tables_.back().get();
+      slot.store(table, std::memory_order_release);
+    }
+  }
+
+  const double log_step = std::log1p(relative_bin_width);
+  const int bin = std::max(
+      0, static_cast<int>(std::log(sqrt_s / table->min_sqrts) / log_step));
+  return {table, std::min(bin, n_bins)};
+}
+
+double CrossSectionEnvelope::upper_bound(const ParticleType &type_a,
+                                         const ParticleType &type_b,
+                                         double sqrt_s) const {
+  const auto types = ordered(type_a, type_b);
+  Table *table;
+  int bin;
+  std::tie(table, bin) = find_bin(types.first, types.second, sqrt_s);
+  if (bin >= n_bins) {
+    return std::numeric_limits<double>::infinity();
+  }
+  double bound = table->bins[bin].load(std::memory_order_acquire);
+  if (bound < 0.) {
+    /* Several threads might fill the same bin, but they all store the same
+     * value. A bin raised by verify() in the meantime is kept. */
+    const double log_step = std::log1p(relative_bin_width);
+    bound = fill_bin(types.first, types.second,
+                     table->min_sqrts * std::exp(bin * log_step),
+                     table->min_sqrts * std::exp((bin + 1) * log_step));
+    double unfilled = -1.;
+    if (!table->bins[bin].compare_exchange_strong(unfilled, bound)) {
+      bound = std::max(bound, unfilled);
+    }
+  }
+  return bound;
+}
+
+bool CrossSectionEnvelope::verify(const ParticleType &type_a,
+                                  const ParticleType &type_b, double sqrt_s,
+                                  double xs) const {
+  const auto types = ordered(type_a, type_b);
+  Table *table;
+  int bin;
+  std::tie(table, bin) = find_bin(types.first, types.second, sqrt_s);
+  if (bin >= n_bins) {
+    return true;
+  }
+  std::atomic<double> &stored = table->bins[bin];
+  const double raised = safety_factor_ * xs;
+  double bound = stored.load(std::memory_order_acquire);
+  const bool within = bound < 0. || xs <= bound;
+  // Bins that are not filled yet will include this value anyway.
+  while (bound >= 0. && bound < raised &&
+         !stored.compare_exchange_weak(bound, raised)) {
+  }
+  if (!within && violations_++ == 0) {
+    logg[LFindScatter].warn(
+        "The cross section of ", type_a.name(), " + ", type_b.name(),
+        " at sqrt(s) = ", sqrt_s, " GeV is ", xs, " mb, above the sampled ",
+        "upper bound of ", bound, " mb. The bound was raised, but collisions ",
+        "could have been missed before. Further violations are not reported.");
+  }
+  return within;
+}
+
+/**
+ * \param[in] type The type of the particle.
+ * \param[in] max_mass The largest mass allowed by kinematics [GeV].
+ * \return the masses at which the cross section is sampled: the pole mass
+ *         for stable particles, otherwise several masses spread over the
+ *         kinematically allowed range.
+ */
+static std::vector<double> sampled_masses(const ParticleType &type,
+                                          double max_mass) {
+  if (type.is_stable()) {
+    return {type.mass()};
+  }
+  constexpr int n_masses = 4;
+  const double min_mass = type.min_mass_kinematic();
+  std::vector<double> masses;
+  if (max_mass <= min_mass) {
+    return masses;
+  }
+  for (int i = 0; i < n_masses; i++) {
+    masses.push_back(min_mass + (max_mass - min_mass) * (i + 0.5) / n_masses);
+  }
+  if (type.mass() > min_mass && type.mass() < max_mass) {
+    masses.push_back(type.mass());
+  }
+  return masses;
+}
+
+double CrossSectionEnvelope::fill_bin(const ParticleType &type_a,
+                                      const ParticleType &type_b,
+                                      double lower, double upper) const {
+  std::vector<double> sqrts_values = {lower, 0.5 * (lower + upper), upper};
+  // Resonance peaks inside of the bin
+  for (const ParticleType &type : ParticleType::list_all()) {
+    if (!type.is_stable() && type.mass() > lower && type.mass() < upper) {
+      sqrts_values.push_back(type.mass());
+    }
+  }
+
+  ParticleData a{type_a};
+  ParticleData b{type_b};
+  double max_xs = 0.;
+  for (const double sqrt_s : sqrts_values) {
+    const auto masses_a =
+        sampled_masses(type_a, sqrt_s - type_b.min_mass_kinematic());
+    const auto masses_b =
+        sampled_masses(type_b, sqrt_s - type_a.min_mass_kinematic());
+    for (const double m_a : masses_a) {
+      for (const double m_b : masses_b) {
+        if (m_a + m_b >= sqrt_s) {
+          continue;
+        }
+        const double p_cm = pCM(sqrt_s, m_a, m_b);
+        a.set_4momentum(m_a, 0., 0., p_cm);
+        b.set_4momentum(m_b, 0., 0., -p_cm);
+        const double xs = total_xs_(a, b);
+        if (!std::isfinite(xs)) {
+          return std::numeric_limits<double>::infinity();
+        }
+        max_xs = std::max(max_xs, xs);
+      }
+    }
+  }
+  return safety_factor_ * max_xs;
+}
+
+}  // namespace smash
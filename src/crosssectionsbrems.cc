@@ -0,0 +1,404 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/crosssectionsbrems.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "smash/cxx14compat.h"
+#include "smash/filelock.h"
+#include "smash/inputfunctions.h"
+#include "smash/interpolation.h"
+#include "smash/interpolation2D.h"
+#include "smash/logging.h"
+#include "smash/sha256.h"
+
+namespace {
+#ifndef DOXYGEN
+namespace bremsstrahlung_txt {
+#include <bremsstrahlung.txt.h>
+}  // namespace bremsstrahlung_txt
+#endif
+}  // unnamed namespace
+
+namespace smash {
+static constexpr int LScatterAction = LogArea::ScatterAction::id;
+
+namespace {
+// sqrt(s), k and theta grids are identical for all channels.
+
+/// Number of sqrt(s) nodes.
+constexpr size_t n_sqrts = 170;
+/// Number of photon momentum nodes.
+constexpr size_t n_k = 100;
+/// Number of photon angle nodes.
+constexpr size_t n_theta = 80;
+/// Number of channels, see BremsChannel.
+constexpr size_t n_channels = 5;
+/// Number of values of the tables of one channel.
+constexpr size_t channel_size = n_sqrts + n_k * n_sqrts + n_theta * n_sqrts;
+/// Number of values of all tables.
+constexpr size_t n_values = n_sqrts + n_k + n_theta + n_channels * channel_size;
+
+/// Names of the channels in bremsstrahlung.txt, in the order of BremsChannel.
+const std::array<const char *, n_channels> channel_names = {
+    {"pipi_pipi_opp", "pipi_pipi_same", "pipi0_pipi0", "pipi_pi0pi0",
+     "pi0pi0_pipi"}};
+
+/**
+ * Parse the tables of bremsstrahlung.txt.
+ *
+ * \param[in] input Content of bremsstrahlung.txt.
+ * \return All values, in the order of the file.
+ * \throw std::runtime_error if a table is missing or has the wrong shape.
+ */
+std::vector<double> parse_tables(const std::string &input) {
+  /// Name and shape of a table.
+  struct Shape {
+    /// Name of the table
+    std::string name;
+    /// Number of rows
+    size_t rows;
+    /// Number of columns
+    size_t columns;
+  };
+  std::vector<Shape> shapes = {
+      {"sqrts", 1, n_sqrts}, {"k", 1, n_k}, {"theta", 1, n_theta}};
+  for (const std::string channel : channel_names) {
+    shapes.push_back({channel + "_sig", 1, n_sqrts});
+    shapes.push_back({channel + "_dsigma_dk", n_sqrts, n_k});
+    shapes.push_back({channel + "_dsigma_dtheta", n_sqrts, n_theta});
+  }
+
+  std::vector<double> values;
+  values.reserve(n_values);
+  const std::vector<Line> lines = line_parser(input);
+  auto line = lines.begin();
+  for (const Shape &shape : shapes) {
+    const std::string expected = shape.name + " " +
+                                 std::to_string(shape.rows) + " " +
+                                 std::to_string(shape.columns);
+    if (line == lines.end()) {
+      throw std::runtime_error("bremsstrahlung.txt ends before the table \"" +
+                               expected + "\".");
+    }
+    if (line->text != expected) {
+      throw std::runtime_error(build_error_string(
+          "Expected the table \"" + expected + "\" in bremsstrahlung.txt",
+          *line));
+    }
+    for (size_t row = 0; row < shape.rows; row++) {
+      if (++line == lines.end()) {
+        throw std::runtime_error("bremsstrahlung.txt ends in the table \"" +
+                                 shape.name + "\".");
+      }
+      std::istringstream stream(line->text);
+      size_t n = 0;
+      double value;
+      while (stream >> value) {
+        values.push_back(value);
+        n++;
+      }
+      if (n != shape.columns || !stream.eof()) {
+        throw std::runtime_error(build_error_string(
+            "Expected " + std::to_string(shape.columns) +
+                " values in bremsstrahlung.txt",
+            *line));
+      }
+    }
+    ++line;
+  }
+  if (line != lines.end()) {
+    throw std::runtime_error(
+        build_error_string("Unexpected line in bremsstrahlung.txt", *line));
+  }
+  return values;
+}
+
+/// Read-only memory mapping of a whole file.
+class MappedFile {
+ public:
+  /**
+   * Map a file. If this fails, the mapping is empty.
+   *
+   * \param[in] path The file.
+   */
+  explicit MappedFile(const bf::path &path) {
+    const int fd = open(path.native().c_str(), O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+    struct stat status;
+    if (fstat(fd, &status) == 0 && status.st_size > 0) {
+      void *data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED) {
+        data_ = static_cast<const char *>(data);
+        size_ = status.st_size;
+      }
+    }
+    close(fd);
+  }
+  /// Unmap the file.
+  ~MappedFile() {
+    if (data_ != nullptr) {
+      munmap(const_cast<char *>(data_), size_);
+    }
+  }
+  /// Cannot be copied.
+  MappedFile(const MappedFile &) = delete;
+  /// Cannot be copied.
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /// \return the content of the file, nullptr if it is not mapped.
+  const char *data() const { return data_; }
+  /// \return the size of the file, 0 if it is not mapped.
+  size_t size() const { return size_; }
+
+ private:
+  /// Mapped content
+  const char *data_ = nullptr;
+  /// Size of the mapping
+  size_t size_ = 0;
+};
+
+/**
+ * Values of all tables. They are parsed from bremsstrahlung.txt, which is
+ * compiled into SMASH, and cached in the binary file bremsstrahlung.bin:
+ * the SHA256 hash of bremsstrahlung.txt, the values as doubles and the
+ * SHA256 hash of the values as checksum. A valid cache is mapped into
+ * memory instead of parsing the text again.
+ */
+class BremsTables {
+ public:
+  /**
+   * Map the tables from the cache, or parse and cache them.
+   *
+   * \param[in] tabulations_path Directory of the cache, nothing is cached if
+   *            it is empty.
+   */
+  explicit BremsTables(const bf::path &tabulations_path) {
+    const char *text = bremsstrahlung_txt::data;
+    const sha256::Hash source = sha256::calculate(
+        reinterpret_cast<const uint8_t *>(text), std::strlen(text));
+    // See IsoParticleType::tabulate_integrals.
+    FileLock lock(tabulations_path / "tabulations.lock");
+    const bf::path &dir = lock.acquire() ? tabulations_path : "";
+    const bf::path path = dir / "bremsstrahlung.bin";
+    if (!dir.empty() && bf::exists(path)) {
+      file_ = make_unique<MappedFile>(path);
+      if (valid(*file_, source)) {
+        values_ = reinterpret_cast<const double *>(file_->data() +
+                                                   sha256::HASH_SIZE);
+        return;
+      }
+      logg[LScatterAction].warn("Ignoring the invalid cache ", path);
+      file_.reset();
+    }
+    parsed_ = parse_tables(text);
+    values_ = parsed_.data();
+    if (!dir.empty()) {
+      const sha256::Hash checksum =
+          sha256::calculate(reinterpret_cast<const uint8_t *>(values_),
+                            n_values * sizeof(double));
+      std::ofstream file(path.string(), std::ios::binary);
+      file.write(reinterpret_cast<const char *>(source.data()), source.size());
+      file.write(reinterpret_cast<const char *>(values_),
+                 n_values * sizeof(double));
+      file.write(reinterpret_cast<const char *>(checksum.data()),
+                 checksum.size());
+    }
+  }
+
+  /// \return the grid in sqrt(s).
+  const double *sqrts() const { return values_; }
+  /// \return the grid in k.
+  const double *k() const { return values_ + n_sqrts; }
+  /// \return the grid in theta.
+  const double *theta() const { return values_ + n_sqrts + n_k; }
+  /**
+   * \param[in] channel Index of the channel.
+   * \return the total cross sections of the channel.
+   */
+  const double *sig(size_t channel) const {
+    return values_ + n_sqrts + n_k + n_theta + channel * channel_size;
+  }
+  /**
+   * \param[in] channel Index of the channel.
+   * \return dSigma/dk of the channel.
+   */
+  const double *dsigma_dk(size_t channel) const {
+    return sig(channel) + n_sqrts;
+  }
+  /**
+   * \param[in] channel Index of the channel.
+   * \return dSigma/dtheta of the channel.
+   */
+  const double *dsigma_dtheta(size_t channel) const {
+    return dsigma_dk(channel) + n_k * n_sqrts;
+  }
+
+ private:
+  /**
+   * Check the size and checksum of a cache, and that it was created from
+   * the same bremsstrahlung.txt.
+   *
+   * \param[in] file The mapped cache.
+   * \param[in] source Hash of bremsstrahlung.txt.
+   * \return whether the cache can be used.
+   */
+  static bool valid(const MappedFile &file, const sha256::Hash &source) {
+    const size_t values_size = n_values * sizeof(double);
+    if (file.size() != 2 * sha256::HASH_SIZE + values_size ||
+        std::memcmp(file.data(), source.data(), sha256::HASH_SIZE) != 0) {
+      return false;
+    }
+    const char *values = file.data() + sha256::HASH_SIZE;
+    const sha256::Hash checksum = sha256::calculate(
+        reinterpret_cast<const uint8_t *>(values), values_size);
+    return std::memcmp(values + values_size, checksum.data(),
+                       sha256::HASH_SIZE) == 0;
+  }
+
+  /// The mapped cache, if it is used.
+  std::unique_ptr<MappedFile> file_;
+  /// The parsed values, if the cache is not used.
+  std::vector<double> parsed_;
+  /// The values of all tables.
+  const double *values_ = nullptr;
+};
+
+/**
+ * Interpolation of a table, which is created on first use. Since the cross
+ * sections are evaluated by the action finding threads, the creation is
+ * guarded by a std::once_flag.
+ *
+ * \tparam T Type of the interpolation.
+ */
+template <typename T>
+class LazyInterpolation {
+ public:
+  /**
+   * \param[in] create Function creating the interpolation, which is only
+   *            called the first time.
+   * \return the interpolation.
+   */
+  template <typename F>
+  const T &get(F &&create) {
+    std::call_once(created_, [&]() { interpolation_ = create(); });
+    return *interpolation_;
+  }
+
+ private:
+  /// Marks whether the interpolation was created.
+  std::once_flag created_;
+  /// The interpolation.
+  std::unique_ptr<T> interpolation_;
+};
+
+/// Interpolations of the tables of one channel, created on first use.
+struct BremsInterpolations {
+  /// Linear interpolation of the total cross section.
+  LazyInterpolation<InterpolateDataLinear<double>> sig;
+  /// Bicubic interpolation of dSigma/dk.
+  LazyInterpolation<InterpolateData2DSpline> dsigma_dk;
+  /// Bicubic interpolation of dSigma/dtheta.
+  LazyInterpolation<InterpolateData2DSpline> dsigma_dtheta;
+};
+
+/// Tables and interpolations of all channels, set up on first use.
+struct BremsState {
+  /// Directory where the tables are cached.
+  bf::path tabulations_path;
+  /// Marks whether the tables were loaded.
+  std::once_flag loaded;
+  /// The tables.
+  std::unique_ptr<BremsTables> tables;
+  /// Interpolations of all channels, in the order of BremsChannel.
+  std::array<BremsInterpolations, n_channels> interpolations;
+
+  /// \return the tables, which are loaded on the first call.
+  const BremsTables &get_tables() {
+    std::call_once(loaded, [&]() {
+      tables = make_unique<BremsTables>(tabulations_path);
+    });
+    return *tables;
+  }
+};
+
+/// The tables and interpolations.
+std::unique_ptr<BremsState> brems_state = make_unique<BremsState>();
+
+/**
+ * Copy the first n entries of a table into a vector.
+ *
+ * \param[in] table Tabulated values.
+ * \param[in] n Number of entries.
+ * \return Copy of the entries.
+ */
+std::vector<double> to_vector(const double *table, size_t n) {
+  return std::vector<double>(table, table + n);
+}
+}  // namespace
+
+void set_brems_tabulations_path(const bf::path &tabulations_path) {
+  brems_state = make_unique<BremsState>();
+  brems_state->tabulations_path = tabulations_path;
+}
+
+double brems_xs(BremsChannel channel, double sqrts) {
+  const size_t i = static_cast<size_t>(channel);
+  BremsState &state = *brems_state;
+  const auto &interpolation = state.interpolations[i].sig.get([&]() {
+    const BremsTables &tables = state.get_tables();
+    return make_unique<InterpolateDataLinear<double>>(
+        to_vector(tables.sqrts(), n_sqrts), to_vector(tables.sig(i), n_sqrts));
+  });
+  return interpolation(sqrts);
+}
+
+double brems_dsigma_dk(BremsChannel channel, double k, double sqrts) {
+  const size_t i = static_cast<size_t>(channel);
+  BremsState &state = *brems_state;
+  const auto &interpolation = state.interpolations[i].dsigma_dk.get([&]() {
+    const BremsTables &tables = state.get_tables();
+    return make_unique<InterpolateData2DSpline>(
+        to_vector(tables.k(), n_k), to_vector(tables.sqrts(), n_sqrts),
+        to_vector(tables.dsigma_dk(i), n_k * n_sqrts));
+  });
+  return interpolation(k, sqrts);
+}
+
+double brems_dsigma_dtheta(BremsChannel channel, double theta, double sqrts) {
+  const size_t i = static_cast<size_t>(channel);
+  BremsState &state = *brems_state;
+  const auto &interpolation = state.interpolations[i].dsigma_dtheta.get([&]() {
+    const BremsTables &tables = state.get_tables();
+    return make_unique<InterpolateData2DSpline>(
+        to_vector(tables.theta(), n_theta), to_vector(tables.sqrts(), n_sqrts),
+        to_vector(tables.dsigma_dtheta(i), n_theta * n_sqrts));
+  });
+  return interpolation(theta, sqrts);
+}
+
+}  // namespace smash
@@ -8,11 +8,18 @@
  */
 
 #include "smash/crosssectionsphoton.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
 #include <memory>
+#include <boost/filesystem.hpp>
 #include "smash/constants.h"
+#include "smash/filelock.h"
 #include "smash/logging.h"
 #include "smash/particletype.h"
 #include "smash/pdgcode.h"
+#include "smash/pow.h"
+#include "smash/tabulation.h"
 
 namespace {
 
@@ -8803,4 +8810,384 @@ double CrosssectionsPhoton<ComputationMethod::Analytic>::xs_diff_pi_pi0_rho(
   return cut_off(gev2_mb * diff_xs / spin_deg_factor);
 }
 
+/*----------------------------------------------------------------------------*/
+/*                      Lookup in tables of the analytic cross sections       */
+/*----------------------------------------------------------------------------*/
+
+namespace {
+
+/// The analytic cross sections, which are tabulated
+using Analytic = CrosssectionsPhoton<ComputationMethod::Analytic>;
+
+/// Smallest tabulated rho mass [GeV]
+constexpr double m_rho_min = 2 * pion_mass;
+/// Largest tabulated rho mass [GeV]
+constexpr double m_rho_max = 2.0;
+/// Number of intervals in the rho mass
+constexpr size_t n_m_rho = 50;
+/**
+ * Largest tabulated \f$ x = \sqrt{\sqrt{s} - \sqrt{s}_{\rm thr}} \f$
+ * [GeV\f$^{1/2}\f$], i.e. the tables end 4 GeV above the threshold.
+ */
+constexpr double x_max = 2.0;
+/**
+ * Number of x values of the total cross sections. They are equally spaced up
+ * to x_max, the threshold itself is left out because the cross sections might
+ * diverge there.
+ */
+constexpr size_t n_x = 200;
+/// Number of x values of the differential cross sections, see n_x.
+constexpr size_t n_x_diff = 100;
+/**
+ * Number of intervals in the scaled t of the differential cross sections. The
+ * values are denser at both ends of the t range, where the differential cross
+ * sections are steep.
+ */
+constexpr size_t n_t = 60;
+/**
+ * Half width of the \f$ \sqrt{s} \f$ window around the omega mass, which is
+ * not tabulated [GeV]. Because of the omega pole in the s-channel and its
+ * threshold, the cross sections are not smooth there.
+ */
+constexpr double omega_window = 0.1;
+
+/// The tables of one photon process.
+struct PhotonChannel {
+  /// Whether the rho meson is in the final state (pi + pi -> rho + photon).
+  bool rho_out;
+  /// Analytic total cross section
+  double (*xs)(double, double);
+  /// Analytic differential cross section
+  double (*diff_xs)(double, double, double);
+  /// Total cross section as a function of x for each rho mass
+  std::vector<Tabulation> xs_tables;
+  /**
+   * Differential cross section as a function of the scaled t for each rho
+   * mass and x, with x running fastest.
+   */
+  std::vector<Tabulation> diff_xs_tables;
+};
+
+/// Indices of the photon processes in photon_channels.
+enum PhotonChannelIndex : size_t {
+  PiPiRho0,
+  PiPi0Rho,
+  Pi0Rho0Pi0,
+  PiRho0Pi,
+  PiRhoPi0RhoMediated,
+  PiRhoPi0OmegaMediated,
+  Pi0RhoPiRhoMediated,
+  Pi0RhoPiOmegaMediated
+};
+
+/// The tabulated photon processes
+std::array<PhotonChannel, 8> photon_channels = {{
+    {true, Analytic::xs_pi_pi_rho0, Analytic::xs_diff_pi_pi_rho0, {}, {}},
+    {true, Analytic::xs_pi_pi0_rho, Analytic::xs_diff_pi_pi0_rho, {}, {}},
+    {false, Analytic::xs_pi0_rho0_pi0, Analytic::xs_diff_pi0_rho0_pi0, {}, {}},
+    {false, Analytic::xs_pi_rho0_pi, Analytic::xs_diff_pi_rho0_pi, {}, {}},
+    {false, Analytic::xs_pi_rho_pi0_rho_mediated,
+     Analytic::xs_diff_pi_rho_pi0_rho_mediated, {}, {}},
+    {false, Analytic::xs_pi_rho_pi0_omega_mediated,
+     Analytic::xs_diff_pi_rho_pi0_omega_mediated, {}, {}},
+    {false, Analytic::xs_pi0_rho_pi_rho_mediated,
+     Analytic::xs_diff_pi0_rho_pi_rho_mediated, {}, {}},
+    {false, Analytic::xs_pi0_rho_pi_omega_mediated,
+     Analytic::xs_diff_pi0_rho_pi_omega_mediated, {}, {}},
+}};
+
+/**
+ * \param[in] channel Photon process
+ * \param[in] m_rho Mass of the rho meson [GeV]
+ * \return Threshold of the process [GeV]
+ */
+double threshold(const PhotonChannel &channel, double m_rho) {
+  return channel.rho_out ? m_rho : m_rho + pion_mass;
+}
+
+/**
+ * \param[in] channel Photon process
+ * \param[in] sqrts Square root of Mandelstam-s [GeV]
+ * \param[in] m_rho Mass of the rho meson [GeV]
+ * \return Range of Mandelstam-t as given by get_t_range [GeV^2]
+ */
+std::array<double, 2> t_range(const PhotonChannel &channel, double sqrts,
+                              double m_rho) {
+  return channel.rho_out
+             ? get_t_range(sqrts, pion_mass, pion_mass, m_rho, 0.)
+             : get_t_range(sqrts, pion_mass, m_rho, pion_mass, 0.);
+}
+
+/**
+ * \param[in] m_rho Mass of the rho meson [GeV]
+ * \return Position of the rho mass in the tables, which is outside of
+ *         [0, n_m_rho) if the mass is not tabulated.
+ */
+double m_rho_index(double m_rho) {
+  return (m_rho - m_rho_min) * (n_m_rho / (m_rho_max - m_rho_min));
+}
+
+/**
+ * \param[in] channel Photon process
+ * \param[in] sqrts Square root of Mandelstam-s [GeV]
+ * \param[in] m_rho Mass of the rho meson [GeV]
+ * \param[in] n Number of x values of the tables, see n_x.
+ * \return Whether the cross sections are tabulated for the given values.
+ */
+bool is_in_tables(const PhotonChannel &channel, double sqrts, double m_rho,
+                  size_t n) {
+  const double dx = x_max / n;
+  const double i_m = m_rho_index(m_rho);
+  const double x2 = sqrts - threshold(channel, m_rho);
+  return i_m >= 0. && i_m < n_m_rho && x2 >= dx * dx && x2 <= x_max * x_max &&
+         std::abs(sqrts - omega_mass) > omega_window;
+}
+
+/**
+ * Scale t to the tabulated variable, which is denser at both ends of the t
+ * range.
+ *
+ * \param[in] u t scaled to [0, 1] in its range
+ * \return Tabulated variable in [0, 1]
+ */
+double t_variable(double u) { return std::acos(1. - 2. * u) / M_PI; }
+
+/**
+ * Fill the tables of a photon process.
+ *
+ * \param[inout] channel Photon process
+ */
+void fill_tables(PhotonChannel &channel) {
+  constexpr double dx = x_max / n_x;
+  constexpr double dx_diff = x_max / n_x_diff;
+  channel.xs_tables.clear();
+  channel.diff_xs_tables.clear();
+  for (size_t i = 0; i <= n_m_rho; i++) {
+    const double m_rho = m_rho_min + i * (m_rho_max - m_rho_min) / n_m_rho;
+    const double sqrts_thr = threshold(channel, m_rho);
+    channel.xs_tables.emplace_back(dx, x_max - dx, n_x - 1, [&](double x) {
+      return channel.xs(pow_int(sqrts_thr + x * x, 2), m_rho);
+    });
+    for (size_t k = 1; k <= n_x_diff; k++) {
+      const double sqrts = sqrts_thr + pow_int(k * dx_diff, 2);
+      const std::array<double, 2> t = t_range(channel, sqrts, m_rho);
+      channel.diff_xs_tables.emplace_back(0., 1., n_t, [&](double v) {
+        // inverse of t_variable
+        const double u = 0.5 * (1. - std::cos(M_PI * v));
+        return channel.diff_xs(sqrts * sqrts, t[1] + u * (t[0] - t[1]), m_rho);
+      });
+    }
+  }
+}
+
+/**
+ * Interpolate the total cross section of a photon process in its tables.
+ *
+ * \param[in] channel Photon process
+ * \param[in] s Mandelstam-s [GeV^2]
+ * \param[in] m_rho Mass of the rho meson [GeV]
+ * \return Total cross section [mb], which is computed analytically outside of
+ *         the tables.
+ */
+double look_up_xs(const PhotonChannel &channel, double s, double m_rho) {
+  const double sqrts = std::sqrt(s);
+  if (channel.xs_tables.empty() || !is_in_tables(channel, sqrts, m_rho, n_x)) {
+    return channel.xs(s, m_rho);
+  }
+  const double i_m = m_rho_index(m_rho);
+  const size_t i = i_m;
+  const double r = i_m - i;
+  const double x = std::sqrt(sqrts - threshold(channel, m_rho));
+  return (1. - r) * channel.xs_tables[i].get_value_linear(x) +
+         r * channel.xs_tables[i + 1].get_value_linear(x);
+}
+
+/**
+ * Interpolate the differential cross section of a photon process in its
+ * tables.
+ *
+ * \param[in] channel Photon process
+ * \param[in] s Mandelstam-s [GeV^2]
+ * \param[in] t Mandelstam-t [GeV^2]
+ * \param[in] m_rho Mass of the rho meson [GeV]
+ * \return Differential cross section [mb/GeV^2], which is computed
+ *         analytically outside of the tables.
+ */
+double look_up_diff_xs(const PhotonChannel &channel, double s, double t,
+                       double m_rho) {
+  constexpr double dx = x_max / n_x_diff;
+  const double sqrts = std::sqrt(s);
+  if (channel.diff_xs_tables.empty() ||
+      !is_in_tables(channel, sqrts, m_rho, n_x_diff)) {
+    return channel.diff_xs(s, t, m_rho);
+  }
+  const std::array<double, 2> t_lim = t_range(channel, sqrts, m_rho);
+  const double u = (t - t_lim[1]) / (t_lim[0] - t_lim[1]);
+  if (!(u >= 0. && u <= 1.)) {
+    return channel.diff_xs(s, t, m_rho);
+  }
+  const double v = t_variable(u);
+  const double i_m = m_rho_index(m_rho);
+  const size_t i = i_m;
+  const double r = i_m - i;
+  // The first x value is at dx.
+  const double i_x = std::sqrt(sqrts - threshold(channel, m_rho)) / dx - 1.;
+  const size_t k = std::min(static_cast<size_t>(i_x), n_x_diff - 2);
+  const double q = i_x - k;
+  const Tabulation *tables = &channel.diff_xs_tables[i * n_x_diff + k];
+  return (1. - r) * ((1. - q) * tables[0].get_value_linear(v) +
+                     q * tables[1].get_value_linear(v)) +
+         r * ((1. - q) * tables[n_x_diff].get_value_linear(v) +
+              q * tables[n_x_diff + 1].get_value_linear(v));
+}
+
+}  // unnamed namespace
+
+void CrosssectionsPhoton<ComputationMethod::Lookup>::tabulate(
+    sha256::Hash hash, const bf::path &tabulations_path) {
+  // See IsoParticleType::tabulate_integrals.
+  FileLock lock(tabulations_path / "tabulations.lock");
+  const bf::path &dir = lock.acquire() ? tabulations_path : "";
+  const bf::path path = dir / "photons.bin";
+
+  // The file holds the tables of all processes in the order of
+  // photon_channels.
+  bool found = !dir.empty() && bf::exists(path);
+  if (found) {
+    std::ifstream file(path.string());
+    for (PhotonChannel &channel : photon_channels) {
+      channel.xs_tables.resize(n_m_rho + 1);
+      channel.diff_xs_tables.resize((n_m_rho + 1) * n_x_diff);
+      for (auto *tables : {&channel.xs_tables, &channel.diff_xs_tables}) {
+        for (Tabulation &table : *tables) {
+          if (found) {
+            table = Tabulation::from_file(file, hash);
+            found = !table.is_empty() && file;
+          }
+        }
+      }
+    }
+  }
+  if (!found) {
+    for (PhotonChannel &channel : photon_channels) {
+      fill_tables(channel);
+    }
+    if (!dir.empty()) {
+      std::ofstream file(path.string());
+      for (const PhotonChannel &channel : photon_channels) {
+        for (const Tabulation &table : channel.xs_tables) {
+          table.write(file, hash);
+        }
+        for (const Tabulation &table : channel.diff_xs_tables) {
+          table.write(file, hash);
+        }
+      }
+    }
+  }
+}
+
+bool CrosssectionsPhoton<ComputationMethod::Lookup>::is_tabulated() {
+  return !photon_channels[0].xs_tables.empty();
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi_pi_rho0(
+    const double s, const double m_rho) {
+  return look_up_xs(photon_channels[PiPiRho0], s, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi_pi0_rho(
+    const double s, const double m_rho) {
+  return look_up_xs(photon_channels[PiPi0Rho], s, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi0_rho0_pi0(
+    const double s, const double m_rho) {
+  return look_up_xs(photon_channels[Pi0Rho0Pi0], s, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi_rho0_pi(
+    const double s, const double m_rho) {
+  return look_up_xs(photon_channels[PiRho0Pi], s, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi_rho_pi0(
+    const double s, const double m_rho) {
+  return cut_off(xs_pi_rho_pi0_rho_mediated(s, m_rho) +
+                 xs_pi_rho_pi0_omega_mediated(s, m_rho));
+}
+
+double
+CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi_rho_pi0_rho_mediated(
+    const double s, const double m_rho) {
+  return look_up_xs(photon_channels[PiRhoPi0RhoMediated], s, m_rho);
+}
+
+double
+CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi_rho_pi0_omega_mediated(
+    const double s, const double m_rho) {
+  return look_up_xs(photon_channels[PiRhoPi0OmegaMediated], s, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi0_rho_pi(
+    const double s, const double m_rho) {
+  return cut_off(xs_pi0_rho_pi_rho_mediated(s, m_rho) +
+                 xs_pi0_rho_pi_omega_mediated(s, m_rho));
+}
+
+double
+CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi0_rho_pi_rho_mediated(
+    const double s, const double m_rho) {
+  return look_up_xs(photon_channels[Pi0RhoPiRhoMediated], s, m_rho);
+}
+
+double
+CrosssectionsPhoton<ComputationMethod::Lookup>::xs_pi0_rho_pi_omega_mediated(
+    const double s, const double m_rho) {
+  return look_up_xs(photon_channels[Pi0RhoPiOmegaMediated], s, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_diff_pi_pi_rho0(
+    const double s, const double t, const double m_rho) {
+  return look_up_diff_xs(photon_channels[PiPiRho0], s, t, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_diff_pi_pi0_rho(
+    const double s, const double t, const double m_rho) {
+  return look_up_diff_xs(photon_channels[PiPi0Rho], s, t, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_diff_pi0_rho0_pi0(
+    const double s, const double t, const double m_rho) {
+  return look_up_diff_xs(photon_channels[Pi0Rho0Pi0], s, t, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::xs_diff_pi_rho0_pi(
+    const double s, const double t, const double m_rho) {
+  return look_up_diff_xs(photon_channels[PiRho0Pi], s, t, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::
+    xs_diff_pi_rho_pi0_rho_mediated(const double s, const double t,
+                                    const double m_rho) {
+  return look_up_diff_xs(photon_channels[PiRhoPi0RhoMediated], s, t, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::
+    xs_diff_pi_rho_pi0_omega_mediated(const double s, const double t,
+                                      const double m_rho) {
+  return look_up_diff_xs(photon_channels[PiRhoPi0OmegaMediated], s, t, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::
+    xs_diff_pi0_rho_pi_rho_mediated(const double s, const double t,
+                                    const double m_rho) {
+  return look_up_diff_xs(photon_channels[Pi0RhoPiRhoMediated], s, t, m_rho);
+}
+
+double CrosssectionsPhoton<ComputationMethod::Lookup>::
+    xs_diff_pi0_rho_pi_omega_mediated(const double s, const double t,
+                                      const double m_rho) {
+  return look_up_diff_xs(photon_channels[Pi0RhoPiOmegaMediated], s, t, m_rho);
+}
+
 }  //  namespace smash
@@ -0,0 +1,250 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/crosssectiontables.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "smash/constants.h"
+#include "smash/cxx14compat.h"
+#include "smash/kinematics.h"
+#include "smash/logging.h"
+#include "smash/particletype.h"
+
+namespace smash {
+static constexpr int LCrossSections = LogArea::CrossSections::id;
+
+constexpr double CrossSectionTables::max_sqrts;
+
+bool CrossSectionTables::Channel::operator<(const Channel &rhs) const {
+  return std::tie(process, types) < std::tie(rhs.process, rhs.types);
+}
+
+CrossSectionTables::Table::Table(double first, std::size_t n_nodes)
+    : first_node(first), nodes(n_nodes) {
+  for (auto &node : nodes) {
+    node.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+CrossSectionTables::CrossSectionTables(CollisionList direct,
+                                       double relative_step)
+    : direct_(std::move(direct)),
+      relative_step_(relative_step),
+      log_step_(std::log1p(relative_step)),
+      n_types_(ParticleType::list_all().size()),
+      tables_(new std::atomic<Table *>[n_types_ * n_types_]) {
+  if (!(relative_step > 0.)) {
+    throw std::invalid_argument(
+        "The relative step of the cross-section tables has to be positive.");
+  }
+  for (std::size_t i = 0; i < n_types_ * n_types_; i++) {
+    tables_[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+CrossSectionTables::~CrossSectionTables() {
+  if (n_validated_ > 0) {
+    logg[LCrossSections].info(
+        "Validated ", n_validated_, " tabulated cross sections: ",
+        n_deviating_, " deviate by more than ", relative_step_,
+        ", the largest relative deviation is ", max_deviation_, ".");
+  }
+}
+
+/**
+ * \param[in] type A particle type.
+ * \return the position of \p type in ParticleType::list_all().
+ */
+static std::size_t index_of(const ParticleType &type) {
+  return std::addressof(type) - std::addressof(ParticleType::list_all()[0]);
+}
+
+bool CrossSectionTables::covers(const ParticleData &data_a,
+                                const ParticleData &data_b) const {
+  for (const ParticleData *data : {&data_a, &data_b}) {
+    const ParticleType &type = data->type();
+    if (!type.is_stable() ||
+        std::abs(data->effective_mass() - type.mass()) >
+            relative_step_ * type.mass() + really_small) {
+      return false;
+    }
+  }
+  const double sqrt_s = (data_a.momentum() + data_b.momentum()).abs();
+  return sqrt_s < max_sqrts &&
+         sqrt_s >= table(data_a.type(), data_b.type()).first_node;
+}
+
+const CrossSectionTables::Table &CrossSectionTables::table(
+    const ParticleType &type_a, const ParticleType &type_b) const {
+  std::atomic<Table *> &slot =
+      tables_[index_of(type_a) * n_types_ + index_of(type_b)];
+  Table *table = slot.load(std::memory_order_acquire);
+  if (!table) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    table = slot.load(std::memory_order_acquire);
+    if (!table) {
+      const double first_node =
+          (type_a.mass() + type_b.mass()) * (1. + relative_step_);
+      // One node beyond max_sqrts, such that it can be interpolated
+      const double n_intervals =
+          std::ceil(std::log(max_sqrts / first_node) / log_step_);
+      owned_tables_.emplace_back(make_unique<Table>(
+          first_node,
+          static_cast<std::size_t>(std::max(2., n_intervals + 1.))));
+      table = owned_tables_.back().get();
+      slot.store(table, std::memory_order_release);
+    }
+  }
+  return *table;
+}
+
+/**
+ * \param[in] branches Collision branches.
+ * \return the channels of the branches, ordered and with the weights of
+ *         equal channels summed up.
+ */
+template <typename Channel>
+static std::vector<Channel> channels_of(const CollisionBranchList &branches) {
+  std::vector<Channel> channels;
+  channels.reserve(branches.size());
+  for (const auto &branch : branches) {
+    channels.push_back(
+        {branch->get_type(), branch->particle_types(), branch->weight()});
+  }
+  std::sort(channels.begin(), channels.end());
+  std::vector<Channel> merged;
+  merged.reserve(channels.size());
+  for (auto &channel : channels) {
+    if (!merged.empty() && !(merged.back() < channel)) {
+      merged.back().weight += channel.weight;
+    } else {
+      merged.push_back(std::move(channel));
+    }
+  }
+  return merged;
+}
+
+/**
+ * Call \p func for each channel that appears in one of the ordered lists
+ * \p lower and \p upper, with the weights from both lists, which are zero for
+ * channels missing in one of them.
+ *
+ * \param[in] lower First ordered list of channels.
+ * \param[in] upper Second ordered list of channels.
+ * \param[in] func Called with the channel and both weights.
+ */
+template <typename Channel, typename F>
+static void merge_channels(const std::vector<Channel> &lower,
+                           const std::vector<Channel> &upper, F &&func) {
+  auto it_lower = lower.begin();
+  auto it_upper = upper.begin();
+  while (it_lower != lower.end() || it_upper != upper.end()) {
+    if (it_upper == upper.end() ||
+        (it_lower != lower.end() && *it_lower < *it_upper)) {
+      func(*it_lower, it_lower->weight, 0.);
+      ++it_lower;
+    } else if (it_lower == lower.end() || *it_upper < *it_lower) {
+      func(*it_upper, 0., it_upper->weight);
+      ++it_upper;
+    } else {
+      func(*it_lower, it_lower->weight, it_upper->weight);
+      ++it_lower;
+      ++it_upper;
+    }
+  }
+}
+
+const CrossSectionTables::Node &CrossSectionTables::node(
+    const ParticleType &type_a, const ParticleType &type_b,
+    const Table &table, std::size_t i) const {
+  const Node *node = table.nodes[i].load(std::memory_order_acquire);
+  if (node) {
+    return *node;
+  }
+  /* The node is computed without holding the lock. If another thread computes
+   * the same node meanwhile, its result is kept. */
+  const double sqrt_s = table.first_node * std::exp(i * log_step_);
+  const double p_cm = pCM(sqrt_s, type_a.mass(), type_b.mass());
+  ParticleData data_a{type_a};
+  ParticleData data_b{type_b};
+  data_a.set_4momentum(type_a.mass(), 0., 0., p_cm);
+  data_b.set_4momentum(type_b.mass(), 0., 0., -p_cm);
+  auto computed =
+      make_unique<Node>(channels_of<Channel>(direct_(data_a, data_b)));
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  node = table.nodes[i].load(std::memory_order_acquire);
+  if (!node) {
+    node = computed.get();
+    owned_nodes_.emplace_back(std::move(computed));
+    table.nodes[i].store(node, std::memory_order_release);
+  }
+  return *node;
+}
+
+CollisionBranchList CrossSectionTables::collision_list(
+    const ParticleType &type_a, const ParticleType &type_b,
+    double sqrt_s) const {
+  const Table &t = table(type_a, type_b);
+  const std::size_t i = std::min(
+      t.nodes.size() - 2,
+      static_cast<std::size_t>(
+          std::max(0., std::log(sqrt_s / t.first_node) / log_step_)));
+  const double lower_sqrts = t.first_node * std::exp(i * log_step_);
+  const double upper_sqrts = t.first_node * std::exp((i + 1) * log_step_);
+  const double x = (sqrt_s - lower_sqrts) / (upper_sqrts - lower_sqrts);
+
+  CollisionBranchList list;
+  merge_channels(node(type_a, type_b, t, i), node(type_a, type_b, t, i + 1),
+                 [&](const Channel &channel, double lower, double upper) {
+                   const double weight = (1. - x) * lower + x * upper;
+                   if (weight <= 0.) {
+                     return;
+                   }
+                   auto branch = make_unique<CollisionBranch>(
+                       channel.types, weight, channel.process);
+                   // Channels that open inside of the interval
+                   if (branch->threshold() < sqrt_s) {
+                     list.emplace_back(std::move(branch));
+                   }
+                 });
+  return list;
+}
+
+double CrossSectionTables::validate(const CollisionBranchList &tabulated,
+                                    const CollisionBranchList &direct,
+                                    double sqrt_s) const {
+  double difference = 0.;
+  double total = 0.;
+  merge_channels(channels_of<Channel>(tabulated),
+                 channels_of<Channel>(direct),
+                 [&](const Channel &, double xs_tabulated, double xs_direct) {
+                   difference += std::abs(xs_tabulated - xs_direct);
+                   total += xs_direct;
+                 });
+  const double deviation = difference / std::max(total, really_small);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  n_validated_++;
+  max_deviation_ = std::max(max_deviation_, deviation);
+  if (deviation > relative_step_) {
+    n_deviating_++;
+    logg[LCrossSections].debug("Tabulated cross sections at sqrt(s) = ",
+                               sqrt_s, " GeV deviate by ", deviation,
+                               " from the direct computation.");
+  }
+  return deviation;
+}
+
+}  // namespace smash
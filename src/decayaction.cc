@@ -30,6 +30,13 @@ void DecayAction::add_decay(DecayBranchPtr p) {
   add_process<DecayBranch>(p, decay_channels_, total_width_);
 }
 
+void DecayAction::add_chosen_decay(DecayBranchPtr p, double total_width) {
+  decay_channels_.clear();
+  decay_channels_.push_back(std::move(p));
+  total_width_ = total_width;
+  decay_chosen_ = true;
+}
+
 void DecayAction::generate_final_state() {
   logg[LDecayModes].debug("Process: Resonance decay. ");
   /* Execute a decay process for the selected particle.
@@ -39,7 +46,9 @@ void DecayAction::generate_final_state() {
    * by calling function sample_2body_phasespace or sample_3body_phasespace.
    */
   const DecayBranch *proc =
-      choose_channel<DecayBranch>(decay_channels_, total_width_);
+      decay_chosen_
+          ? decay_channels_.front().get()
+          : choose_channel<DecayBranch>(decay_channels_, total_width_);
   outgoing_particles_ = proc->particle_list();
   // set positions of the outgoing particles
   for (auto &p : outgoing_particles_) {
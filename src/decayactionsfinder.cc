@@ -20,22 +20,32 @@
 namespace smash {
 
 ActionList DecayActionsFinder::find_actions_in_cell(
-    const ParticleList &search_list, double dt, const double,
+    const ParticleListView &search_list, double dt, const double,
     const std::vector<FourVector> &) const {
   ActionList actions;
   /* for short time steps this seems reasonable to expect
    * less than 10 decays in most time steps */
   actions.reserve(10);
+  /* Unless the potentials shift the masses of the decays, the width only
+   * depends on the mass of the particle and is cached with it. Then the
+   * branches are only computed for the particles that decay. */
+  const bool cached_width = !ParticleType::potentials_affect_decays();
+  // Partial widths of the particle, reused to avoid allocations
+  std::vector<double> widths;
 
   for (const auto &p : search_list) {
     if (p.type().is_stable()) {
       continue;  // particle doesn't decay
     }
 
-    DecayBranchList processes = p.type().get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::Hadronic);
     // total decay width (mass-dependent)
-    const double width = total_weight<DecayBranch>(processes);
+    double width;
+    if (cached_width) {
+      width = p.hadronic_width();
+    } else {
+      width = p.type().get_partial_widths(p.momentum(), p.position().threevec(),
+                                          WhichDecaymodes::Hadronic, widths);
+    }
 
     // check if there are any (hadronic) decays
     if (!(width > 0.0)) {
@@ -63,7 +73,14 @@ ActionList DecayActionsFinder::find_actions_in_cell(
       /* => decay_time ∈ [0, dt[
        * => the particle decays in this timestep. */
       auto act = make_unique<DecayAction>(p, decay_time);
-      act->add_decays(std::move(processes));
+      if (cached_width) {
+        width = p.type().get_partial_widths(p.momentum(),
+                                            p.position().threevec(),
+                                            WhichDecaymodes::Hadronic, widths);
+      }
+      // Only the branch of the chosen decay mode is created.
+      act->add_chosen_decay(p.type().choose_decay_branch(widths, width),
+                            width);
       actions.emplace_back(std::move(act));
     }
   }
@@ -73,14 +90,16 @@ ActionList DecayActionsFinder::find_actions_in_cell(
 ActionList DecayActionsFinder::find_final_actions(const Particles &search_list,
                                                   bool /*only_res*/) const {
   ActionList actions;
+  std::vector<double> widths;
 
   for (const auto &p : search_list) {
     if (p.type().is_stable()) {
       continue;  // particle doesn't decay
     }
     auto act = make_unique<DecayAction>(p, 0.);
-    act->add_decays(p.type().get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::All));
+    const double width = p.type().get_partial_widths(
+        p.momentum(), p.position().threevec(), WhichDecaymodes::All, widths);
+    act->add_chosen_decay(p.type().choose_decay_branch(widths, width), width);
     actions.emplace_back(std::move(act));
   }
   return actions;
@@ -9,6 +9,11 @@
 
 #include "smash/decayactionsfinderdilepton.h"
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#include "smash/action.h"
 #include "smash/constants.h"
 #include "smash/cxx14compat.h"
 #include "smash/decayactiondilepton.h"
@@ -17,41 +22,193 @@
 
 namespace smash {
 
+DecayActionsFinderDilepton::DecayActionsFinderDilepton(bool batched)
+    : batched_(batched) {
+  if (!batched_) {
+    return;
+  }
+  // Number of intervals of each tabulation
+  constexpr size_t n_intervals = 1000;
+  const ParticleTypeList &types = ParticleType::list_all();
+  dilepton_modes_.resize(types.size());
+  for (size_t i = 0; i < types.size(); i++) {
+    const ParticleType &type = types[i];
+    // Stable particles only shine at the end, see shine_final.
+    if (type.is_stable()) {
+      continue;
+    }
+    const auto &decay_mode_list = type.decay_modes().decay_mode_list();
+    const auto is_dilepton_mode = [&](const DecayBranchPtr &mode) {
+      return type.wanted_decaymode(mode->type(), WhichDecaymodes::Dileptons);
+    };
+    if (std::all_of(decay_mode_list.begin(), decay_mode_list.end(),
+                    is_dilepton_mode)) {
+      continue;
+    }
+    const double m_min = type.min_mass_kinematic();
+    const double x_max = std::sqrt(
+        type.mass() + ParticleType::width_tabulation_range - m_min);
+    for (size_t k = 0; k < decay_mode_list.size(); k++) {
+      const DecayBranch *mode = decay_mode_list[k].get();
+      if (is_dilepton_mode(decay_mode_list[k])) {
+        dilepton_modes_[i].push_back(
+            {k, Tabulation(0., x_max, n_intervals, [&](double x) {
+               return type.partial_width(m_min + x * x, mode);
+             })});
+      }
+    }
+  }
+}
+
+/// \return whether \p outputs contain a dilepton output.
+static bool has_dilepton_output(const OutputsList &outputs) {
+  return std::any_of(outputs.begin(), outputs.end(),
+                     [](const OutputPtr &output) {
+                       return output->is_dilepton_output();
+                     });
+}
+
+void DecayActionsFinderDilepton::shine_incoming(
+    const Action &action, const OutputsList &outputs) const {
+  if (action.get_type() == ProcessType::Wall ||
+      !has_dilepton_output(outputs)) {
+    return;
+  }
+  for (const ParticleData &p : action.incoming_particles()) {
+    shine_particle(p, outputs);
+  }
+}
+
+void DecayActionsFinderDilepton::shine_batch(const Particles &particles,
+                                             double time,
+                                             const OutputsList &outputs) {
+  if (has_dilepton_output(outputs)) {
+    for (const ParticleData &p : particles) {
+      shine_particle(p, outputs);
+    }
+  }
+  batch_start_time_ = time;
+}
+
+void DecayActionsFinderDilepton::shine_particle(
+    const ParticleData &p, const OutputsList &outputs) const {
+  const ParticleType &t = p.type();
+  const auto &modes =
+      dilepton_modes_[std::addressof(t) - std::addressof(
+                                               ParticleType::list_all()[0])];
+  if (modes.empty()) {
+    return;
+  }
+  /* The particle shines since the start of the batch or since it was
+   * created, if that was later, but only when it is formed. */
+  double start_time = std::max(batch_start_time_, p.formation_time());
+  if (p.get_history().collisions_per_particle > 0) {
+    start_time = std::max(start_time, p.get_history().time_last_collision);
+  }
+  const double duration = p.position().x0() - start_time;
+  if (!(duration > 0.)) {
+    return;
+  }
+
+  /* Without potentials, the widths only depend on the mass and the dilepton
+   * widths are tabulated. Otherwise, all widths are computed. If there is no
+   * hadronic decay, the particle only shines at the end. */
+  const double m = p.momentum().abs();
+  const bool tabulated = !ParticleType::potentials_affect_decays();
+  if (tabulated) {
+    if (!(p.hadronic_width() > 0.)) {
+      return;
+    }
+  } else {
+    const double width_tot = t.get_partial_widths(
+        p.momentum(), p.position().threevec(), WhichDecaymodes::All, widths_);
+    double width_dil = 0.;
+    for (const DileptonMode &mode : modes) {
+      width_dil += widths_[mode.index];
+    }
+    if (!(width_tot > width_dil)) {
+      return;
+    }
+  }
+  const double m_min = t.min_mass_kinematic();
+  const bool in_range =
+      m >= m_min && m <= t.mass() + ParticleType::width_tabulation_range;
+  const auto &decay_mode_list = t.decay_modes().decay_mode_list();
+  for (const DileptonMode &mode : modes) {
+    double width;
+    if (!tabulated) {
+      width = widths_[mode.index];
+    } else if (in_range) {
+      width = mode.width.get_value_linear(std::sqrt(m - m_min));
+    } else {
+      width = t.partial_width(m, decay_mode_list[mode.index].get());
+    }
+    // SHINING as described in \iref{Schmidt:2008hm}, chapter 2D
+    const double shining_weight = duration * p.inverse_gamma() * width / hbarc;
+    if (shining_weight > 0.0) {  // decays that can happen
+      DecayActionDilepton act(p, 0., shining_weight);
+      act.add_decay(t.decay_branch(mode.index, width));
+      act.generate_final_state();
+      for (const auto &output : outputs) {
+        if (output->is_dilepton_output()) {
+          output->at_interaction(act, 0.0);
+        }
+      }
+    }
+  }
+}
+
 void DecayActionsFinderDilepton::shine(const Particles &search_list,
                                        OutputInterface *output,
                                        double dt) const {
   if (!output->is_dilepton_output()) {
     return;
   }
+  // Partial widths of the particle, reused to avoid allocations
+  std::vector<double> widths;
   for (const auto &p : search_list) {
-    const auto n_all_modes =
-        p.type()
-            .get_partial_widths(p.momentum(), p.position().threevec(),
-                                WhichDecaymodes::All)
-            .size();
+    const ParticleType &t = p.type();
+    /* The dilepton modes are selected from the widths of all modes, which
+     * are the same. */
+    t.get_partial_widths(p.momentum(), p.position().threevec(),
+                         WhichDecaymodes::All, widths);
+    const auto &decay_mode_list = t.decay_modes().decay_mode_list();
+    size_t n_all_modes = 0, n_dil_modes = 0;
+    for (size_t i = 0; i < widths.size(); i++) {
+      if (widths[i] > 0.) {
+        n_all_modes++;
+        if (t.wanted_decaymode(decay_mode_list[i]->type(),
+                               WhichDecaymodes::Dileptons)) {
+          n_dil_modes++;
+        }
+      }
+    }
     if (n_all_modes == 0) {
       continue;
     }
 
     const double inv_gamma = p.inverse_gamma();
-    DecayBranchList dil_modes = p.type().get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::Dileptons);
 
     /* If particle can only decay into dileptons or is stable, use shining only
      * in find_final_actions and ignore them here, also unformed
      * resonances cannot decay */
-    if (dil_modes.size() == n_all_modes || p.type().is_stable() ||
+    if (n_dil_modes == n_all_modes || t.is_stable() ||
         (p.formation_time() > p.position().x0())) {
       continue;
     }
 
-    for (DecayBranchPtr &mode : dil_modes) {
+    for (size_t i = 0; i < widths.size(); i++) {
+      if (!(widths[i] > 0.) ||
+          !t.wanted_decaymode(decay_mode_list[i]->type(),
+                              WhichDecaymodes::Dileptons)) {
+        continue;
+      }
       // SHINING as described in \iref{Schmidt:2008hm}, chapter 2D
-      const double shining_weight = dt * inv_gamma * mode->weight() / hbarc;
+      const double shining_weight = dt * inv_gamma * widths[i] / hbarc;
 
       if (shining_weight > 0.0) {  // decays that can happen
         DecayActionDilepton act(p, 0., shining_weight);
-        act.add_decay(std::move(mode));
+        act.add_decay(t.decay_branch(i, widths[i]));
         act.generate_final_state();
         output->at_interaction(act, 0.0);
       }
@@ -65,6 +222,7 @@ void DecayActionsFinderDilepton::shine_final(const Particles &search_list,
   if (!output->is_dilepton_output()) {
     return;
   }
+  std::vector<double> widths;
   for (const auto &p : search_list) {
     const ParticleType &t = p.type();
     if (t.decay_modes().decay_mode_list().empty() ||
@@ -72,19 +230,21 @@ void DecayActionsFinderDilepton::shine_final(const Particles &search_list,
       continue;
     }
 
-    DecayBranchList dil_modes = t.get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::Dileptons);
-
     // total decay width, also hadronic decays
-    const double width_tot = total_weight<DecayBranch>(t.get_partial_widths(
-        p.momentum(), p.position().threevec(), WhichDecaymodes::All));
+    const double width_tot = t.get_partial_widths(
+        p.momentum(), p.position().threevec(), WhichDecaymodes::All, widths);
 
-    for (DecayBranchPtr &mode : dil_modes) {
-      const double shining_weight = mode->weight() / width_tot;
+    const auto &decay_mode_list = t.decay_modes().decay_mode_list();
+    for (size_t i = 0; i < widths.size(); i++) {
+      if (!t.wanted_decaymode(decay_mode_list[i]->type(),
+                              WhichDecaymodes::Dileptons)) {
+        continue;
+      }
+      const double shining_weight = widths[i] / width_tot;
 
       if (shining_weight > 0.0) {  // decays that can happen
         DecayActionDilepton act(p, 0., shining_weight);
-        act.add_decay(std::move(mode));
+        act.add_decay(t.decay_branch(i, widths[i]));
         act.generate_final_state();
         output->at_interaction(act, 0.0);
       }
@@ -16,10 +16,22 @@
 #include "smash/integrate.h"
 #include "smash/kinematics.h"
 #include "smash/pdgcode_constants.h"
+#include "smash/potentials.h"
 #include "smash/pow.h"
 
 namespace smash {
 
+// DecayType
+
+DecayType::DecayType(ParticleTypePtrList part_types, int l)
+    : particle_types_(part_types), L_(l) {
+  for (const ParticleTypePtr type : particle_types_) {
+    const auto scale = Potentials::force_scale(*type);
+    final_state_scale_B_ += scale.first;
+    final_state_scale_I3_ += scale.second * type->isospin3_rel();
+  }
+}
+
 // auxiliary functions
 
 static double integrand_rho_Manley_1res(double sqrts, double mass,
@@ -144,12 +156,12 @@ double TwoBodyDecaySemistable::get_Lambda() {
 
 /// Number of tabulation points.
 constexpr size_t num_tab_pts = 200;
-static /*thread_local (see #3075)*/ Integrator integrate;
+static thread_local Integrator integrate;
 
 double TwoBodyDecaySemistable::rho(double mass) const {
   if (tabulation_ == nullptr) {
-    /* TODO(weil): Move this lazy init to a global initialization function,
-     * in order to avoid race conditions in multi-threading. */
+    /* ParticleType::prepare_for_multithreading fills this before any
+     * threads are started, so that they only read it. */
     const ParticleTypePtr res = particle_types_[1];
     const double tabulation_interval = std::max(2., 10. * res->width_at_pole());
     const double m_stable = particle_types_[0]->mass();
@@ -198,12 +210,12 @@ double TwoBodyDecayUnstable::get_Lambda() {
   return 0.6;
 }
 
-static /*thread_local*/ Integrator2dCuhre integrate2d(1E7);
+static thread_local Integrator2dCuhre integrate2d(1E7);
 
 double TwoBodyDecayUnstable::rho(double mass) const {
   if (tabulation_ == nullptr) {
-    /* TODO(weil): Move this lazy init to a global initialization function,
-     * in order to avoid race conditions in multi-threading. */
+    /* ParticleType::prepare_for_multithreading fills this before any
+     * threads are started, so that they only read it. */
     const ParticleTypePtr r1 = particle_types_[0];
     const ParticleTypePtr r2 = particle_types_[1];
     const double m1_min = r1->min_mass_kinematic();
@@ -9,6 +9,7 @@
 
 #include "smash/grid.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "smash/algorithms.h"
@@ -102,17 +103,36 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
                   &min_and_length,
               const Particles &particles, double max_interaction_length,
               double timestep_duration, CellSizeStrategy strategy)
-    : length_(min_and_length.second) {
-  const auto min_position = min_and_length.first;
+    : min_position_(min_and_length.first),
+      length_(min_and_length.second),
+      strategy_(strategy) {
+  build(particles, max_interaction_length, timestep_duration);
+}
+
+template <GridOptions O>
+void Grid<O>::build(const Particles &particles, double max_interaction_length,
+                    double timestep_duration) {
   const SizeType particle_count = particles.size();
+  particles_ = &particles;
+  min_cell_length_ = max_interaction_length;
+  particle_count_ = particles.size();
+  for (auto &cell : cells_) {
+    cell.clear();
+  }
+  for (auto &location : locations_) {
+    location.cell = -1;
+  }
 
   // very simple setup for non-periodic boundaries and largest cellsize strategy
-  if (O == GridOptions::Normal && strategy == CellSizeStrategy::Largest) {
+  if (O == GridOptions::Normal && strategy_ == CellSizeStrategy::Largest) {
     number_of_cells_ = {1, 1, 1};
+    index_factor_ = {0., 0., 0.};
     cell_volume_ = length_[0] * length_[1] * length_[2];
-    cells_.clear();
-    cells_.reserve(1);
-    cells_.emplace_back(particles.copy_to_vector());
+    cells_.resize(1);
+    cells_.front().reserve(particles.size());
+    for (const auto &p : particles) {
+      add_to_cell(p, 0);
+    }
     return;
   }
 
@@ -121,7 +141,8 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
   // the length of a cell).
   // But don't let the number of cells exceed the actual number of particles.
   // That would be overkill. Let max_cells³ ≤ particle_count (conversion to
-  // int truncates).
+  // int truncates), or only limit the product of the numbers of cells for the
+  // anisotropic strategy.
   // Consider that particle placement into cells uses half-open intervals. Thus
   // a cell includes particles in [0, a[. The next cell [a, 2a[. And so on. This
   // is important for calculating the number of cells. If length * index_factor
@@ -130,19 +151,19 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
   // because the last cell will then store particles in the interval
   // [length, length + max_interaction_length[. The code below achieves this
   // effect by rounding down (floor) and adding 1 afterwards.
-  const int max_cells =
-      (O == GridOptions::Normal)
-          ? std::cbrt(particle_count)
-          : std::max(2, static_cast<int>(std::cbrt(particle_count)));
+  const int cbrt_count = std::cbrt(particle_count);
+  std::array<int, 3> max_cells;
+  max_cells.fill((O == GridOptions::Normal) ? cbrt_count
+                                            : std::max(2, cbrt_count));
 
   // This normally equals 1/max_interaction_length, but if the number of cells
   // is reduced (because of low density) then this value is smaller.
-  std::array<double, 3> index_factor = {1. / max_interaction_length,
-                                        1. / max_interaction_length,
-                                        1. / max_interaction_length};
+  auto &index_factor = index_factor_;
+  index_factor = {1. / max_interaction_length, 1. / max_interaction_length,
+                  1. / max_interaction_length};
   for (std::size_t i = 0; i < number_of_cells_.size(); ++i) {
     number_of_cells_[i] =
-        (strategy == CellSizeStrategy::Largest)
+        (strategy_ == CellSizeStrategy::Largest)
             ? 2
             : static_cast<int>(std::floor(length_[i] * index_factor[i])) +
                   // The last cell in each direction can be smaller than
@@ -156,6 +177,34 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
                   // default number of cells one less than for non-periodic
                   // boundaries.
                   (O == GridOptions::Normal ? 1 : 0);
+  }
+  if (strategy_ == CellSizeStrategy::Anisotropic) {
+    /* Only the total number of cells is limited by the number of particles.
+     * If there are too many cells, the directions with more than the
+     * minimal number of cells are reduced by a common factor, such that
+     * flat or elongated systems keep small cells along their large
+     * extents. */
+    const int min_cells = (O == GridOptions::Normal) ? 1 : 2;
+    const double max_total =
+        std::max<double>(particle_count, std::pow(min_cells, 3));
+    max_cells = number_of_cells_;
+    auto total = [&]() {
+      return static_cast<double>(max_cells[0]) * max_cells[1] * max_cells[2];
+    };
+    while (total() > max_total) {
+      int reducible = 0;
+      for (int n : max_cells) {
+        reducible += (n > min_cells);
+      }
+      const double factor = std::pow(max_total / total(), 1. / reducible);
+      for (int &n : max_cells) {
+        if (n > min_cells) {
+          n = std::max(min_cells, static_cast<int>(n * factor));
+        }
+      }
+    }
+  }
+  for (std::size_t i = 0; i < number_of_cells_.size(); ++i) {
     if (number_of_cells_[i] == 0) {
       throw std::runtime_error(
           "Input error: Your Box is too small for the grid."
@@ -167,8 +216,8 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
     }
     // std::nextafter implements a safety margin so that no valid position
     // inside the grid can reference an out-of-bounds cell
-    if (number_of_cells_[i] > max_cells) {
-      number_of_cells_[i] = max_cells;
+    if (number_of_cells_[i] > max_cells[i]) {
+      number_of_cells_[i] = max_cells[i];
       index_factor[i] = number_of_cells_[i] / length_[i];
       while (index_factor[i] * length_[i] >= number_of_cells_[i]) {
         index_factor[i] = std::nextafter(index_factor[i], 0.);
@@ -203,17 +252,19 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
         " cells. Therefore the Grid falls back to a single cell / "
         "particle list.");
     number_of_cells_ = {1, 1, 1};
+    index_factor_ = {0., 0., 0.};
     cell_volume_ = length_[0] * length_[1] * length_[2];
     cells_.resize(1);
     cells_.front().reserve(particles.size());
-    std::copy_if(particles.begin(), particles.end(),
-                 std::back_inserter(cells_.front()),
-                 [&](const ParticleData &p) {
-                   return p.xsec_scaling_factor(timestep_duration) > 0.0;
-                 });  // filter out the particles that can not interact
+    for (const auto &p : particles) {
+      // filter out the particles that can not interact
+      if (is_on_grid(p, timestep_duration)) {
+        add_to_cell(p, 0);
+      }
+    }
   } else {
     // construct a normal grid
-    logg[LGrid].debug("min: ", min_position, "\nlength: ", length_,
+    logg[LGrid].debug("min: ", min_position_, "\nlength: ", length_,
                       "\ncell_volume: ", cell_volume_,
                       "\ncells: ", number_of_cells_,
                       "\nindex_factor: ", index_factor);
@@ -223,34 +274,23 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
     cells_.resize(number_of_cells_[0] * number_of_cells_[1] *
                   number_of_cells_[2]);
 
-    // Returns the one-dimensional cell-index from the position vector inside
-    // the grid.
-    // This simply calculates the distance to min_position and multiplies it
-    // with index_factor to determine the 3 x,y,z indexes to pass to make_index.
-    auto &&cell_index_for = [&](const ParticleData &p) {
-      return make_index(
-          std::floor((p.position()[1] - min_position[0]) * index_factor[0]),
-          std::floor((p.position()[2] - min_position[1]) * index_factor[1]),
-          std::floor((p.position()[3] - min_position[2]) * index_factor[2]));
-    };
-
     for (const auto &p : particles) {
-      if (p.xsec_scaling_factor(timestep_duration) > 0.0) {
+      if (is_on_grid(p, timestep_duration)) {
         const auto idx = cell_index_for(p);
 #ifndef NDEBUG
-        if (idx >= SizeType(cells_.size())) {
+        if (idx < 0 || idx >= SizeType(cells_.size())) {
           logg[LGrid].fatal(
               source_location,
               "\nan out-of-bounds access would be necessary for the "
               "particle ",
               p, "\nfor a grid with the following parameters:\nmin: ",
-              min_position, "\nlength: ", length_,
+              min_position_, "\nlength: ", length_,
               "\ncells: ", number_of_cells_, "\nindex_factor: ", index_factor,
               "\ncells_.size: ", cells_.size(), "\nrequested index: ", idx);
           throw std::runtime_error("out-of-bounds grid access on construction");
         }
 #endif
-        cells_[idx].push_back(p);
+        add_to_cell(p, idx);
       }
     }
   }
@@ -258,6 +298,177 @@ Grid<O>::Grid(const std::pair<std::array<double, 3>, std::array<double, 3>>
   logg[LGrid].debug(cells_);
 }
 
+template <GridOptions O>
+void Grid<O>::rebuild(const Particles &particles, double min_cell_length,
+                      double timestep_duration) {
+  ++number_of_rebuilds_;
+  if (O == GridOptions::Normal) {
+    const auto min_and_length = find_min_and_length(particles);
+    min_position_ = min_and_length.first;
+    length_ = min_and_length.second;
+    if (strategy_ == CellSizeStrategy::Optimal) {
+      // Leave room for the particles to move during the next timesteps. The
+      // margin is at least a fraction of a cell, such that a point-like
+      // system does not end up with a zero-size box.
+      for (std::size_t i = 0; i < length_.size(); ++i) {
+        const double margin =
+            box_margin_ * std::max(length_[i], min_cell_length);
+        min_position_[i] -= margin;
+        length_[i] += 2 * margin;
+      }
+    }
+  }
+  logg[LGrid].debug("Recomputing the grid layout for min: ", min_position_,
+                    "\nlength: ", length_);
+  build(particles, min_cell_length, timestep_duration);
+}
+
+template <GridOptions O>
+void Grid<O>::update(const Particles &particles, double min_cell_length,
+                     double timestep_duration) {
+  ++update_count_;
+  particles_ = &particles;
+  if (min_cell_length > min_cell_length_ ||
+      2 * min_cell_length < min_cell_length_ ||
+      particles.size() > 2 * particle_count_ ||
+      2 * particles.size() < particle_count_) {
+    rebuild(particles, min_cell_length, timestep_duration);
+    return;
+  }
+
+  for (const auto &p : particles) {
+    if (p.index() >= locations_.size()) {
+      locations_.resize(p.index() + 1);
+    }
+    CellLocation &location = locations_[p.index()];
+    if (!is_on_grid(p, timestep_duration)) {
+      // stays (or is marked) off the grid; removed below
+      continue;
+    }
+    location.seen_in_update = update_count_;
+    const SizeType idx = cell_index_for(p);
+    if (idx < 0) {
+      // the particle left the bounding box
+      rebuild(particles, min_cell_length, timestep_duration);
+      return;
+    }
+    assert(idx < SizeType(cells_.size()));
+    if (location.cell != idx) {
+      if (location.cell >= 0) {
+        remove_from_cell(location);
+      }
+      add_to_cell(p, idx);
+    }
+  }
+
+  // Remove the indices of particles which are gone from the Particles storage
+  // or which are not on the grid anymore.
+  for (auto &location : locations_) {
+    if (location.cell >= 0 && location.seen_in_update != update_count_) {
+      remove_from_cell(location);
+    }
+  }
+}
+
+template <GridOptions O>
+typename Grid<O>::SizeType Grid<O>::cell_index_for(
+    const ParticleData &p) const {
+  // This simply calculates the distance to min_position_ and multiplies it
+  // with index_factor_ to determine the 3 x,y,z indexes to pass to make_index.
+  std::array<SizeType, 3> idx;
+  for (std::size_t i = 0; i < idx.size(); ++i) {
+    const double x = p.position()[i + 1] - min_position_[i];
+    if (O == GridOptions::Normal && !(x >= 0. && x <= length_[i])) {
+      return -1;
+    }
+    idx[i] = std::floor(x * index_factor_[i]);
+  }
+  return make_index(idx);
+}
+
+template <GridOptions O>
+std::array<typename Grid<O>::SizeType, 3> Grid<O>::clamped_index_for(
+    const ParticleData &p) const {
+  std::array<SizeType, 3> idx;
+  for (std::size_t i = 0; i < idx.size(); ++i) {
+    const double x =
+        (p.position()[i + 1] - min_position_[i]) * index_factor_[i];
+    idx[i] = x > 0. ? static_cast<SizeType>(std::min(
+                          std::floor(x), number_of_cells_[i] - 1.))
+                    : 0;
+  }
+  return idx;
+}
+
+template <GridOptions O>
+void Grid<O>::iterate_neighborhood(
+    const ParticleData &p,
+    const std::function<void(const ParticleListView &)> &callback) const {
+  const std::array<SizeType, 3> center = clamped_index_for(p);
+  std::array<SizeType, 3> first, last;
+  for (std::size_t i = 0; i < center.size(); ++i) {
+    first[i] = std::max(center[i] - 1, 0);
+    last[i] = std::min(center[i] + 1, number_of_cells_[i] - 1);
+  }
+  for (SizeType z = first[2]; z <= last[2]; ++z) {
+    for (SizeType y = first[1]; y <= last[1]; ++y) {
+      for (SizeType x = first[0]; x <= last[0]; ++x) {
+        const std::vector<unsigned> &cell = cells_[make_index(x, y, z)];
+        if (!cell.empty()) {
+          callback(particles_->view(cell));
+        }
+      }
+    }
+  }
+}
+
+template <GridOptions O>
+void Grid<O>::insert(const ParticleData &p, double timestep_duration) {
+  remove(p);
+  if (is_on_grid(p, timestep_duration)) {
+    add_to_cell(p, make_index(clamped_index_for(p)));
+  }
+}
+
+template <GridOptions O>
+void Grid<O>::remove(const ParticleData &p) {
+  if (p.index() < locations_.size() && locations_[p.index()].cell >= 0) {
+    remove_from_cell(locations_[p.index()]);
+  }
+}
+
+template <GridOptions O>
+std::size_t Grid<O>::max_cell_occupancy() const {
+  std::size_t max_occupancy = 0;
+  for (const auto &cell : cells_) {
+    max_occupancy = std::max(max_occupancy, cell.size());
+  }
+  return max_occupancy;
+}
+
+template <GridOptions O>
+void Grid<O>::add_to_cell(const ParticleData &p, SizeType cell) {
+  if (p.index() >= locations_.size()) {
+    locations_.resize(p.index() + 1);
+  }
+  CellLocation &location = locations_[p.index()];
+  location.cell = cell;
+  location.entry = cells_[cell].size();
+  location.seen_in_update = update_count_;
+  cells_[cell].push_back(p.index());
+}
+
+template <GridOptions O>
+void Grid<O>::remove_from_cell(CellLocation &location) {
+  std::vector<unsigned> &cell = cells_[location.cell];
+  if (location.entry + 1 != SizeType(cell.size())) {
+    cell[location.entry] = cell.back();
+    locations_[cell[location.entry]].entry = location.entry;
+  }
+  cell.pop_back();
+  location.cell = -1;
+}
+
 template <GridOptions Options>
 inline typename Grid<Options>::SizeType Grid<Options>::make_index(
     SizeType x, SizeType y, SizeType z) const {
@@ -271,47 +482,42 @@ static const std::initializer_list<GridBase::SizeType> MINUS_ONE_ZERO_ONE{-1, 0,
                                                                           1};
 
 template <>
-/// Specialization of iterate_cells
-void Grid<GridOptions::Normal>::iterate_cells(
-    const std::function<void(const ParticleList &)> &search_cell_callback,
-    const std::function<void(const ParticleList &, const ParticleList &)>
-        &neighbor_cell_callback) const {
-  std::array<SizeType, 3> search_index;
-  SizeType &x = search_index[0];
-  SizeType &y = search_index[1];
-  SizeType &z = search_index[2];
-  SizeType search_cell_index = 0;
-  for (z = 0; z < number_of_cells_[2]; ++z) {
-    for (y = 0; y < number_of_cells_[1]; ++y) {
-      for (x = 0; x < number_of_cells_[0]; ++x, ++search_cell_index) {
-        assert(search_cell_index == make_index(search_index));
-        assert(search_cell_index >= 0);
-        assert(search_cell_index < SizeType(cells_.size()));
-        const ParticleList &search = cells_[search_cell_index];
-        search_cell_callback(search);
-
-        const auto &dz_list = z == number_of_cells_[2] - 1 ? ZERO : ZERO_ONE;
-        const auto &dy_list = number_of_cells_[1] == 1
-                                  ? ZERO
-                                  : y == 0 ? ZERO_ONE
-                                           : y == number_of_cells_[1] - 1
-                                                 ? MINUS_ONE_ZERO
-                                                 : MINUS_ONE_ZERO_ONE;
-        const auto &dx_list = number_of_cells_[0] == 1
-                                  ? ZERO
-                                  : x == 0 ? ZERO_ONE
-                                           : x == number_of_cells_[0] - 1
-                                                 ? MINUS_ONE_ZERO
-                                                 : MINUS_ONE_ZERO_ONE;
-        for (SizeType dz : dz_list) {
-          for (SizeType dy : dy_list) {
-            for (SizeType dx : dx_list) {
-              const auto di = make_index(dx, dy, dz);
-              if (di > 0) {
-                neighbor_cell_callback(search, cells_[search_cell_index + di]);
-              }
-            }
-          }
+/// Specialization of iterate_cell
+void Grid<GridOptions::Normal>::iterate_cell(
+    const std::array<SizeType, 3> &search_index,
+    const std::function<void(const ParticleListView &)> &search_cell_callback,
+    const std::function<void(const ParticleListView &,
+                             const ParticleListView &)> &neighbor_cell_callback,
+    ParticleList &) const {
+  const SizeType x = search_index[0];
+  const SizeType y = search_index[1];
+  const SizeType z = search_index[2];
+  const SizeType search_cell_index = make_index(search_index);
+  assert(search_cell_index >= 0);
+  assert(search_cell_index < SizeType(cells_.size()));
+  const ParticleListView search = particles_->view(cells_[search_cell_index]);
+  search_cell_callback(search);
+
+  const auto &dz_list = z == number_of_cells_[2] - 1 ? ZERO : ZERO_ONE;
+  const auto &dy_list = number_of_cells_[1] == 1
+                            ? ZERO
+                            : y == 0 ? ZERO_ONE
+                                     : y == number_of_cells_[1] - 1
+                                           ? MINUS_ONE_ZERO
+                                           : MINUS_ONE_ZERO_ONE;
+  const auto &dx_list = number_of_cells_[0] == 1
+                            ? ZERO
+                            : x == 0 ? ZERO_ONE
+                                     : x == number_of_cells_[0] - 1
+                                           ? MINUS_ONE_ZERO
+                                           : MINUS_ONE_ZERO_ONE;
+  for (SizeType dz : dz_list) {
+    for (SizeType dy : dy_list) {
+      for (SizeType dx : dx_list) {
+        const auto di = make_index(dx, dy, dz);
+        if (di > 0) {
+          neighbor_cell_callback(
+              search, particles_->view(cells_[search_cell_index + di]));
         }
       }
     }
@@ -337,138 +543,172 @@ struct NeighborLookup {
 };
 
 template <>
-/// Specialization of iterate_cells
-void Grid<GridOptions::PeriodicBoundaries>::iterate_cells(
-    const std::function<void(const ParticleList &)> &search_cell_callback,
-    const std::function<void(const ParticleList &, const ParticleList &)>
-        &neighbor_cell_callback) const {
-  std::array<SizeType, 3> search_index;
-  SizeType &x = search_index[0];
-  SizeType &y = search_index[1];
-  SizeType &z = search_index[2];
-  SizeType search_cell_index = 0;
+/// Specialization of iterate_cell
+void Grid<GridOptions::PeriodicBoundaries>::iterate_cell(
+    const std::array<SizeType, 3> &search_index,
+    const std::function<void(const ParticleListView &)> &search_cell_callback,
+    const std::function<void(const ParticleListView &,
+                             const ParticleListView &)> &neighbor_cell_callback,
+    ParticleList &translated) const {
+  const SizeType x = search_index[0];
+  const SizeType y = search_index[1];
+  const SizeType z = search_index[2];
+
+  assert(number_of_cells_[2] >= 2);
+  assert(number_of_cells_[1] >= 2);
+  assert(number_of_cells_[0] >= 2);
 
-  // defaults:
   std::array<NeighborLookup, 2> dz_list;
   std::array<NeighborLookup, 3> dy_list;
   std::array<NeighborLookup, 3> dx_list;
 
-  assert(number_of_cells_[2] >= 2);
-  assert(number_of_cells_[1] >= 2);
-  assert(number_of_cells_[0] >= 2);
+  dz_list[0].index = z;
+  dz_list[1].index = z + 1;
+  if (dz_list[1].index == number_of_cells_[2]) {
+    dz_list[1].index = 0;
+    dz_list[1].wrap = NeedsToWrap::MinusLength;
+  }
 
-  for (z = 0; z < number_of_cells_[2]; ++z) {
-    dz_list[0].index = z;
-    dz_list[1].index = z + 1;
-    if (dz_list[1].index == number_of_cells_[2]) {
-      dz_list[1].index = 0;
-      // last z in the loop, so no need to reset wrap again
-      dz_list[1].wrap = NeedsToWrap::MinusLength;
+  dy_list[0].index = y;
+  dy_list[1].index = y - 1;
+  dy_list[2].index = y + 1;
+  if (y == 0) {
+    dy_list[1] = dy_list[2];
+    dy_list[2].index = number_of_cells_[1] - 1;
+    dy_list[2].wrap = NeedsToWrap::PlusLength;
+  } else if (dy_list[2].index == number_of_cells_[1]) {
+    dy_list[2].index = 0;
+    dy_list[2].wrap = NeedsToWrap::MinusLength;
+  }
+
+  dx_list[0].index = x;
+  dx_list[1].index = x - 1;
+  dx_list[2].index = x + 1;
+  if (x == 0) {
+    dx_list[1] = dx_list[2];
+    dx_list[2].index = number_of_cells_[0] - 1;
+    dx_list[2].wrap = NeedsToWrap::PlusLength;
+  } else if (dx_list[2].index == number_of_cells_[0]) {
+    dx_list[2].index = 0;
+    dx_list[2].wrap = NeedsToWrap::MinusLength;
+  }
+
+  const SizeType search_cell_index = make_index(search_index);
+  assert(search_cell_index >= 0);
+  assert(search_cell_index < SizeType(cells_.size()));
+  ParticleListView search = particles_->view(cells_[search_cell_index]);
+  search_cell_callback(search);
+
+  auto virtual_search_index = search_index;
+  ThreeVector wrap_vector = {};  // no change
+  auto current_wrap_vector = wrap_vector;
+  bool search_is_copied = false;
+
+  for (const auto &dz : dz_list) {
+    if (dz.wrap == NeedsToWrap::MinusLength) {
+      // last dz in the loop, so no need to undo the wrap
+      wrap_vector[2] = -length_[2];
+      virtual_search_index[2] = -1;
     }
-    for (y = 0; y < number_of_cells_[1]; ++y) {
-      dy_list[0].index = y;
-      dy_list[1].index = y - 1;
-      dy_list[2].index = y + 1;
-      dy_list[2].wrap = NeedsToWrap::No;
-      if (y == 0) {
-        dy_list[1] = dy_list[2];
-        dy_list[2].index = number_of_cells_[1] - 1;
-        dy_list[2].wrap = NeedsToWrap::PlusLength;
-      } else if (dy_list[2].index == number_of_cells_[1]) {
-        dy_list[2].index = 0;
-        dy_list[2].wrap = NeedsToWrap::MinusLength;
+    for (const auto &dy : dy_list) {
+      // only the last dy in dy_list can wrap
+      if (dy.wrap == NeedsToWrap::MinusLength) {
+        wrap_vector[1] = -length_[1];
+        virtual_search_index[1] = -1;
+      } else if (dy.wrap == NeedsToWrap::PlusLength) {
+        wrap_vector[1] = length_[1];
+        virtual_search_index[1] = number_of_cells_[1];
       }
-      for (x = 0; x < number_of_cells_[0]; ++x, ++search_cell_index) {
-        dx_list[0].index = x;
-        dx_list[1].index = x - 1;
-        dx_list[2].index = x + 1;
-        dx_list[2].wrap = NeedsToWrap::No;
-        if (x == 0) {
-          dx_list[1] = dx_list[2];
-          dx_list[2].index = number_of_cells_[0] - 1;
-          dx_list[2].wrap = NeedsToWrap::PlusLength;
-        } else if (dx_list[2].index == number_of_cells_[0]) {
-          dx_list[2].index = 0;
-          dx_list[2].wrap = NeedsToWrap::MinusLength;
+      for (const auto &dx : dx_list) {
+        // only the last dx in dx_list can wrap
+        if (dx.wrap == NeedsToWrap::MinusLength) {
+          wrap_vector[0] = -length_[0];
+          virtual_search_index[0] = -1;
+        } else if (dx.wrap == NeedsToWrap::PlusLength) {
+          wrap_vector[0] = length_[0];
+          virtual_search_index[0] = number_of_cells_[0];
+        }
+        assert(dx.index >= 0);
+        assert(dx.index < number_of_cells_[0]);
+        assert(dy.index >= 0);
+        assert(dy.index < number_of_cells_[1]);
+        assert(dz.index >= 0);
+        assert(dz.index < number_of_cells_[2]);
+        const auto neighbor_cell_index =
+            make_index(dx.index, dy.index, dz.index);
+        assert(neighbor_cell_index >= 0);
+        assert(neighbor_cell_index < SizeType(cells_.size()));
+        if (neighbor_cell_index <= make_index(virtual_search_index)) {
+          continue;
         }
 
-        assert(search_cell_index == make_index(search_index));
-        assert(search_cell_index >= 0);
-        assert(search_cell_index < SizeType(cells_.size()));
-        ParticleList search = cells_[search_cell_index];
-        search_cell_callback(search);
-
-        auto virtual_search_index = search_index;
-        ThreeVector wrap_vector = {};  // no change
-        auto current_wrap_vector = wrap_vector;
-
-        for (const auto &dz : dz_list) {
-          if (dz.wrap == NeedsToWrap::MinusLength) {
-            // last dz in the loop, so no need to undo the wrap
-            wrap_vector[2] = -length_[2];
-            virtual_search_index[2] = -1;
-          }
-          for (const auto &dy : dy_list) {
-            // only the last dy in dy_list can wrap
-            if (dy.wrap == NeedsToWrap::MinusLength) {
-              wrap_vector[1] = -length_[1];
-              virtual_search_index[1] = -1;
-            } else if (dy.wrap == NeedsToWrap::PlusLength) {
-              wrap_vector[1] = length_[1];
-              virtual_search_index[1] = number_of_cells_[1];
-            }
-            for (const auto &dx : dx_list) {
-              // only the last dx in dx_list can wrap
-              if (dx.wrap == NeedsToWrap::MinusLength) {
-                wrap_vector[0] = -length_[0];
-                virtual_search_index[0] = -1;
-              } else if (dx.wrap == NeedsToWrap::PlusLength) {
-                wrap_vector[0] = length_[0];
-                virtual_search_index[0] = number_of_cells_[0];
-              }
-              assert(dx.index >= 0);
-              assert(dx.index < number_of_cells_[0]);
-              assert(dy.index >= 0);
-              assert(dy.index < number_of_cells_[1]);
-              assert(dz.index >= 0);
-              assert(dz.index < number_of_cells_[2]);
-              const auto neighbor_cell_index =
-                  make_index(dx.index, dy.index, dz.index);
-              assert(neighbor_cell_index >= 0);
-              assert(neighbor_cell_index < SizeType(cells_.size()));
-              if (neighbor_cell_index <= make_index(virtual_search_index)) {
-                continue;
-              }
-
-              if (wrap_vector != current_wrap_vector) {
-                logg[LGrid].debug("translating search cell by ",
-                                  wrap_vector - current_wrap_vector);
-                for_each(search, [&](ParticleData &p) {
-                  p = p.translated(wrap_vector - current_wrap_vector);
-                });
-                current_wrap_vector = wrap_vector;
-              }
-              neighbor_cell_callback(search, cells_[neighbor_cell_index]);
-            }
-            virtual_search_index[0] = search_index[0];
-            wrap_vector[0] = 0;
+        if (wrap_vector != current_wrap_vector) {
+          logg[LGrid].debug("translating search cell by ",
+                            wrap_vector - current_wrap_vector);
+          // only the translated search cell needs to be copied
+          if (!search_is_copied) {
+            translated.assign(search.begin(), search.end());
+            search = translated;
+            search_is_copied = true;
           }
-          virtual_search_index[1] = search_index[1];
-          wrap_vector[1] = 0;
+          for_each(translated, [&](ParticleData &p) {
+            p = p.translated(wrap_vector - current_wrap_vector);
+          });
+          current_wrap_vector = wrap_vector;
         }
+        neighbor_cell_callback(search,
+                               particles_->view(cells_[neighbor_cell_index]));
       }
+      virtual_search_index[0] = search_index[0];
+      wrap_vector[0] = 0;
     }
+    virtual_search_index[1] = search_index[1];
+    wrap_vector[1] = 0;
   }
 }
 
-template Grid<GridOptions::Normal>::Grid(
-    const std::pair<std::array<double, 3>, std::array<double, 3>>
-        &min_and_length,
-    const Particles &particles, double max_interaction_length,
-    double timestep_duration, CellSizeStrategy strategy);
-template Grid<GridOptions::PeriodicBoundaries>::Grid(
-    const std::pair<std::array<double, 3>, std::array<double, 3>>
-        &min_and_length,
-    const Particles &particles, double max_interaction_length,
-    double timestep_duration, CellSizeStrategy strategy);
+template <GridOptions O>
+void Grid<O>::iterate_cells(
+    const std::function<void(const ParticleListView &)> &search_cell_callback,
+    const std::function<void(const ParticleListView &,
+                             const ParticleListView &)> &neighbor_cell_callback)
+    const {
+  // buffer for search cells translated by a wrap vector
+  ParticleList translated;
+  std::array<SizeType, 3> search_index;
+  SizeType &x = search_index[0];
+  SizeType &y = search_index[1];
+  SizeType &z = search_index[2];
+  SizeType search_cell_index = 0;
+  for (z = 0; z < number_of_cells_[2]; ++z) {
+    for (y = 0; y < number_of_cells_[1]; ++y) {
+      for (x = 0; x < number_of_cells_[0]; ++x, ++search_cell_index) {
+        assert(search_cell_index == make_index(search_index));
+        iterate_cell(search_index, search_cell_callback, neighbor_cell_callback,
+                     translated);
+      }
+    }
+  }
+}
+
+template <GridOptions O>
+void Grid<O>::iterate_cell(
+    SizeType cell_index,
+    const std::function<void(const ParticleListView &)> &search_cell_callback,
+    const std::function<void(const ParticleListView &,
+                             const ParticleListView &)> &neighbor_cell_callback)
+    const {
+  assert(cell_index >= 0);
+  assert(cell_index < SizeType(cells_.size()));
+  const std::array<SizeType, 3> search_index = {
+      cell_index % number_of_cells_[0],
+      (cell_index / number_of_cells_[0]) % number_of_cells_[1],
+      cell_index / (number_of_cells_[0] * number_of_cells_[1])};
+  ParticleList translated;
+  iterate_cell(search_index, search_cell_callback, neighbor_cell_callback,
+               translated);
+}
+
+template class Grid<GridOptions::Normal>;
+template class Grid<GridOptions::PeriodicBoundaries>;
 }  // namespace smash
@@ -14,6 +14,7 @@
 #include <utility>
 #include <vector>
 
+#include "arena.h"
 #include "lattice.h"
 #include "particles.h"
 #include "pauliblocking.h"
@@ -88,6 +89,21 @@ class Action {
    */
   virtual ~Action();
 
+  /**
+   * Actions are allocated from the Arena, because they are created and
+   * destroyed in large numbers during every time step.
+   *
+   * \param[in] size Size of the action [bytes].
+   * \return memory for the action.
+   */
+  static void *operator new(std::size_t size) { return Arena::allocate(size); }
+  /**
+   * Release the memory of an action.
+   *
+   * \param[in] ptr Memory of the action.
+   */
+  static void operator delete(void *ptr) { Arena::deallocate(ptr); }
+
   /**
    * Determine whether one action takes place before another in time
    *
@@ -15,6 +15,7 @@
 #include "clock.h"
 #include "forwarddeclarations.h"
 #include "lattice.h"
+#include "particles.h"
 #include "potentials.h"
 
 namespace smash {
@@ -32,7 +33,8 @@ class ActionFinderInterface {
    * Abstract function for finding actions, given a list of particles.
    *
    * \param[in] search_list a list of particles where each pair needs to be
-   *                  tested for possible interaction
+   *                  tested for possible interaction (passed as a view, which
+   *                  may refer to the Particles storage without copies)
    * \param[in] dt duration of the current time step [fm]
    * \param[in] cell_vol volume of searched grid cell [fm^3]
    * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
@@ -41,7 +43,7 @@ class ActionFinderInterface {
    *         could possibly be executed in this time step.
    */
   virtual ActionList find_actions_in_cell(
-      const ParticleList &search_list, double dt, const double cell_vol,
+      const ParticleListView &search_list, double dt, const double cell_vol,
       const std::vector<FourVector> &beam_momentum) const = 0;
   /**
    * Abstract function for finding actions, given two lists of particles,
@@ -58,8 +60,9 @@ class ActionFinderInterface {
    *         could possibly be executed in this time step.
    */
   virtual ActionList find_actions_with_neighbors(
-      const ParticleList &search_list, const ParticleList &neighbors_list,
-      double dt, const std::vector<FourVector> &beam_momentum) const = 0;
+      const ParticleListView &search_list,
+      const ParticleListView &neighbors_list, double dt,
+      const std::vector<FourVector> &beam_momentum) const = 0;
 
   /**
    * Abstract function for finding actions between a list of particles and
@@ -91,6 +91,27 @@ class Actions {
     std::push_heap(data_.begin(), data_.end(), cmp);
   }
 
+  /**
+   * Remove all actions, whose incoming particles have changed since the
+   * actions were found, and restore the heap.
+   *
+   * Invalid actions are also discarded when they are popped, but until then
+   * they make inserting and popping more expensive.
+   *
+   * \param[in] particles The current particles.
+   * \return Number of removed actions.
+   */
+  ActionList::size_type remove_invalid(const Particles& particles) {
+    const auto size_before = data_.size();
+    data_.erase(std::remove_if(data_.begin(), data_.end(),
+                               [&particles](const ActionPtr& a) {
+                                 return !a->is_valid(particles);
+                               }),
+                data_.end());
+    std::make_heap(data_.begin(), data_.end(), cmp);
+    return size_before - data_.size();
+  }
+
   /// \return Number of actions.
   ActionList::size_type size() const { return data_.size(); }
 
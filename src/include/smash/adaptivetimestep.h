@@ -0,0 +1,94 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_ADAPTIVETIMESTEP_H_
+#define SRC_INCLUDE_ADAPTIVETIMESTEP_H_
+
+#include <limits>
+
+#include "configuration.h"
+
+namespace smash {
+
+/// Quantities measured during a time step, which determine the next one.
+struct TimeStepMeasurements {
+  /// Number of performed actions divided by the number of particles
+  double actions_per_particle = 0.;
+  /// Largest number of particles per volume in a cell of the grid [fm^-3]
+  double max_density = 0.;
+  /**
+   * Shortest time in which the potentials change the energy of a particle,
+   * see update_momenta [fm]
+   */
+  double force_time_scale = std::numeric_limits<double>::infinity();
+};
+
+/**
+ * Chooses the size of the next time step from the state of the system in
+ * the last one, for Time_Step_Mode = Adaptive.
+ *
+ * The step shrinks in the dense stage of a collision and grows in the dilute
+ * late stage, where few actions happen and rebuilding the grid and searching
+ * all cells for actions dominate the run time. The size is limited by
+ * \li the number of actions per particle in the last step, which is steered
+ *     towards a target value,
+ * \li a fraction of the mean free time at the largest density, computed with
+ *     the largest cross section,
+ * \li a tenth of the time scale of the potentials, and
+ * \li configurable lower and upper bounds.
+ *
+ * The number of actions changes the step at most by a given factor from one
+ * step to the next, while the other limits apply immediately.
+ */
+class AdaptiveTimeStep {
+ public:
+  /**
+   * Take the parameters from the configuration.
+   *
+   * \param[in] config Configuration, from which the keys in
+   *            General: Adaptive_Time_Step are taken.
+   * \param[in] delta_time Initial time step size [fm]
+   * \param[in] max_cross_section Largest cross section of any pair of
+   *            particles, divided by the number of test particles [fm^2]
+   * \throw std::invalid_argument if the bounds are not positive and ordered
+   *        or the change factor is not larger than 1.
+   */
+  AdaptiveTimeStep(Configuration &config, double delta_time,
+                   double max_cross_section);
+
+  /**
+   * \param[in] dt Size of the last time step [fm]
+   * \param[in] measured Quantities measured during the last time step
+   * \return size of the next time step [fm]
+   */
+  double next_timestep(double dt, const TimeStepMeasurements &measured) const;
+
+  /// \return smallest allowed time step [fm]
+  double min_timestep() const { return min_dt_; }
+  /// \return largest allowed time step [fm]
+  double max_timestep() const { return max_dt_; }
+
+ private:
+  /// Smallest allowed time step [fm]
+  const double min_dt_;
+  /// Largest allowed time step [fm]
+  const double max_dt_;
+  /// Desired number of actions per particle and time step
+  const double target_actions_;
+  /// Largest fraction of the mean free time covered by a time step
+  const double mean_free_time_fraction_;
+  /// Largest factor by which the step changes from one step to the next
+  const double max_change_;
+  /// Largest cross section divided by the number of test particles [fm^2]
+  const double max_cross_section_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_ADAPTIVETIMESTEP_H_
@@ -0,0 +1,133 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_ARENA_H_
+#define SRC_INCLUDE_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+namespace smash {
+
+/**
+ * Memory for short-lived objects, which are created and destroyed in large
+ * numbers, like actions and process branches.
+ *
+ * Every thread allocates from its own chunks of memory by advancing a
+ * pointer. Releasing an object only decrements the number of live objects in
+ * its chunk, which can happen in any thread. A chunk is reused as soon as
+ * none of its objects is alive anymore. The objects of a time step are all
+ * released when its action queue is drained, so the chunks are recycled
+ * every time step without freeing memory. A single long-lived object only
+ * keeps its own chunk from being reused.
+ *
+ * Objects larger than an eighth of a chunk are allocated on the heap.
+ *
+ * Classes use it by defining
+ * \code
+ * static void *operator new(std::size_t size) {
+ *   return Arena::allocate(size);
+ * }
+ * static void operator delete(void *ptr) { Arena::deallocate(ptr); }
+ * \endcode
+ */
+class Arena {
+ public:
+  /// Allocation statistics, summed over all threads
+  struct Statistics {
+    /// Number of objects allocated from chunks
+    std::uint64_t allocations = 0;
+    /// Number of objects too large for the chunks, allocated on the heap
+    std::uint64_t heap_allocations = 0;
+    /// Number of times a chunk was reused after all its objects were gone
+    std::uint64_t recycled_chunks = 0;
+    /// Memory reserved in chunks [bytes]
+    std::uint64_t reserved_bytes = 0;
+  };
+
+  /// Size of the chunks [bytes]
+  static constexpr std::size_t chunk_size = 1 << 20;
+
+  /**
+   * \param[in] size Size of the object [bytes].
+   * \return memory for an object of \p size bytes, aligned like
+   *         std::max_align_t.
+   * \throw std::bad_alloc if no memory is available.
+   */
+  static void *allocate(std::size_t size);
+
+  /**
+   * Release the memory of an object.
+   *
+   * \param[in] ptr Memory returned by allocate, or nullptr.
+   */
+  static void deallocate(void *ptr) noexcept;
+
+  /// \return the allocation statistics of all threads.
+  static Statistics statistics();
+
+  /// Create an empty arena, whose statistics are collected.
+  Arena();
+  /// Cannot be copied
+  Arena(const Arena &) = delete;
+  /// Cannot be copied
+  Arena &operator=(const Arena &) = delete;
+  /**
+   * Free the chunks without live objects. Chunks with live objects, which
+   * were handed to other threads, are freed with their last object.
+   */
+  ~Arena();
+
+ private:
+  /// A block of memory and the number of references to it
+  struct Chunk;
+  /// Precedes every allocated object
+  struct Header;
+
+  /// \return the arena of the calling thread.
+  static Arena &local();
+
+  /**
+   * \param[in] size Size of the object including the header [bytes].
+   * \return memory inside of a chunk.
+   */
+  void *allocate_in_chunk(std::size_t size);
+
+  /// Chunks of this arena
+  std::vector<Chunk *> chunks_;
+  /// Chunk from which is allocated currently
+  Chunk *current_ = nullptr;
+  /// Offset of the next allocation inside of the current chunk
+  std::size_t offset_ = 0;
+  /// Number of allocations from chunks
+  std::atomic<std::uint64_t> allocations_{0};
+  /// Number of allocations on the heap
+  std::atomic<std::uint64_t> heap_allocations_{0};
+  /// Number of reused chunks
+  std::atomic<std::uint64_t> recycled_chunks_{0};
+  /// Memory reserved in chunks [bytes]
+  std::atomic<std::uint64_t> reserved_bytes_{0};
+};
+
+/**
+ * Print the allocation statistics.
+ *
+ * \param[in] out The output stream.
+ * \param[in] stats The statistics.
+ * \return the output stream.
+ */
+std::ostream &operator<<(std::ostream &out, const Arena::Statistics &stats);
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_ARENA_H_
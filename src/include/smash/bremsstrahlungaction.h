@@ -165,12 +165,6 @@ class BremsstrahlungAction : public ScatterAction {
   /// Sampled value of theta (angle of the photon)
   double theta_;
 
-  /**
-   * Create interpolation objects for tabularized cross sections:
-   * total cross section, differential dSigma/dk, differential dSigma/dtheta
-   */
-  void create_interpolations();
-
   /**
    * Computes the total cross section of the bremsstrahlung process.
    *
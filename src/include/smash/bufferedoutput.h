@@ -0,0 +1,80 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_BUFFEREDOUTPUT_H_
+#define SRC_INCLUDE_BUFFEREDOUTPUT_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "outputinterface.h"
+
+namespace smash {
+
+/**
+ * \ingroup output
+ *
+ * Output that records all calls in memory, such that they can be passed on to
+ * the actual output later.
+ *
+ * This is used when events are run in parallel: Every event writes to its own
+ * buffers, which are replayed in the order of the events. Thus the output
+ * files are identical to the ones of a sequential run. The particles and
+ * actions are copied when recorded, so they may change afterwards.
+ *
+ * The thermodynamic lattice outputs are not recorded and must not be used
+ * together with this class.
+ */
+class BufferedOutput : public OutputInterface {
+ public:
+  /**
+   * Create an empty buffer for the given output.
+   *
+   * \param[in] target The output the calls will be replayed to. It is only
+   *            used to determine which kind of output (e.g. dileptons) is
+   *            buffered.
+   */
+  explicit BufferedOutput(const OutputInterface &target);
+
+  /// Record the particles at event start.
+  void at_eventstart(const Particles &particles,
+                     const int event_number) override;
+
+  /// Record the particles at event end.
+  void at_eventend(const Particles &particles, const int event_number,
+                   double impact_parameter, bool empty_event) override;
+
+  /// Record the incoming and outgoing particles and weights of the action.
+  void at_interaction(const Action &action, const double density) override;
+
+  /// Record the particles and the time of the clock.
+  void at_intermediate_time(const Particles &particles,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &dens_param) override;
+
+  /**
+   * Pass all recorded calls on to \p target, in the order they were
+   * recorded, and clear the buffer.
+   *
+   * \param[in] target The output to write to.
+   */
+  void replay(OutputInterface &target);
+
+  /// \return whether nothing was recorded since the last replay.
+  bool empty() const { return calls_.empty(); }
+
+ private:
+  /// The recorded calls, applied to the target output in \ref replay.
+  std::vector<std::function<void(OutputInterface &)>> calls_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_BUFFEREDOUTPUT_H_
@@ -0,0 +1,111 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_COLLISIONCANDIDATES_H_
+#define SRC_INCLUDE_COLLISIONCANDIDATES_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "fourvector.h"
+#include "particles.h"
+
+namespace smash {
+
+/**
+ * \ingroup action
+ *
+ * Positions and momenta of a list of particles, stored as a structure of
+ * arrays, such that the geometric collision criterion can be evaluated for
+ * one particle against all particles of the batch in a vectorized loop.
+ *
+ * Two momenta are stored for every particle: the actual one, which enters
+ * the transverse distance, and the one used for the collision time, which is
+ * the beam momentum for the initial nucleons with frozen Fermi motion, see
+ * ScatterActionsFinder::collision_time.
+ */
+class ParticleBatch {
+ public:
+  /**
+   * Fill the batch with the particles of a list, replacing the previous
+   * content. The memory is kept, such that a batch can be reused without
+   * allocations.
+   *
+   * \param[in] list The particles.
+   * \param[in] beam_momentum Beam momenta of the initial nucleons, which are
+   *            used for their collision times as long as they did not collide
+   *            (empty unless the Fermi motion is frozen) [GeV]
+   */
+  void assign(const ParticleListView &list,
+              const std::vector<FourVector> &beam_momentum);
+
+  /// \return the number of particles in the batch.
+  std::size_t size() const { return particles_.size(); }
+
+  /**
+   * \param[in] i Position in the batch
+   * \return the particle at position \p i.
+   */
+  const ParticleData &operator[](std::size_t i) const {
+    return *particles_[i];
+  }
+
+  /**
+   * Mark the particles of this batch that can collide with particle \p i of
+   * batch \p other within the time step according to the geometric
+   * criterion, i.e. their collision time is in [0, dt) and their transverse
+   * distance squared below \p max_distance_sqr.
+   *
+   * The result is conservative: pairs close to the limits are marked, such
+   * that rounding differences to ScatterActionsFinder::check_collision, which
+   * has to check the marked pairs again, do not remove any collision.
+   *
+   * \param[in] other Batch of the particle
+   * \param[in] i Position of the particle in \p other
+   * \param[in] dt Duration of the time step [fm]
+   * \param[in] max_distance_sqr Largest transverse distance squared [fm^2]
+   * \param[out] marks Set to 1 for the candidates and 0 for the others, it is
+   *             resized to the size of this batch.
+   */
+  void mark_candidates(const ParticleBatch &other, std::size_t i, double dt,
+                       double max_distance_sqr,
+                       std::vector<unsigned char> &marks) const;
+
+ private:
+  /// The particles of the batch
+  std::vector<const ParticleData *> particles_;
+  /// Time components of the positions [fm]
+  std::vector<double> t_;
+  /// x components of the positions [fm]
+  std::vector<double> x_;
+  /// y components of the positions [fm]
+  std::vector<double> y_;
+  /// z components of the positions [fm]
+  std::vector<double> z_;
+  /// Energies [GeV]
+  std::vector<double> e_;
+  /// x components of the momenta [GeV]
+  std::vector<double> px_;
+  /// y components of the momenta [GeV]
+  std::vector<double> py_;
+  /// z components of the momenta [GeV]
+  std::vector<double> pz_;
+  /// Energies used for the collision time [GeV]
+  std::vector<double> coll_e_;
+  /// x components of the momenta used for the collision time [GeV]
+  std::vector<double> coll_px_;
+  /// y components of the momenta used for the collision time [GeV]
+  std::vector<double> coll_py_;
+  /// z components of the momenta used for the collision time [GeV]
+  std::vector<double> coll_pz_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_COLLISIONCANDIDATES_H_
@@ -298,6 +298,16 @@ namespace smash {
  * Number of fractional photons sampled per single perturbatively produced
  * photon.
  *
+ * \key Cross_Sections (string, optional, default = "Analytic"):\n
+ * How the cross sections of the photon production in mesonic scattering
+ * processes are computed.
+ * - \key "Analytic" - Evaluate the analytic formulas for every process.
+ * - \key "Lookup" - Interpolate in tables of the analytic formulas, which
+ *   are computed once at startup and cached on disk together with the
+ *   resonance integrals. This is much faster. Close to the kinematic
+ *   thresholds, around the omega pole and for very heavy rho mesons, the
+ *   analytic formulas are still used.
+ *
  * Remember to also activate the photon output in the output section.
  *
  * \n
@@ -389,6 +399,12 @@ namespace smash {
  * additionally have to be uncommented in the used decaymodes.txt (see also note
  * below).
  *
+ * \key Batched_Shining (bool, optional, default = false):\n
+ * Whether the dileptons are shone once per time step instead of after every
+ * propagation, see below. This is much faster, in particular for small time
+ * steps or many particles. The partial widths of the dilepton decays are then
+ * tabulated as functions of the mass.
+ *
  * Remember to also activate the dilepton output in the output section.
  *
  * \n
@@ -403,6 +419,10 @@ namespace smash {
  * them. The are weighted with a "shining weight" to compensate for the
  * over-production.
  * \li The shining weight can be found in the weight element of the output.
+ * \li With \key Batched_Shining, every particle shines once at the end of a
+ * time step, or before it interacts, with the weight integrated over the
+ * time it existed and was formed within the step. The decays are then
+ * sampled from the state of the particle at that time.
  * \li The shining method is implemented in the DecayActionsFinderDilepton,
  * which is automatically enabled together with the dilepton output.
  *
@@ -822,9 +842,35 @@ class Configuration {
       if (s == "Fixed") {
         return TimeStepMode::Fixed;
       }
-      throw IncorrectTypeInAssignment("The value for key \"" +
-                                      std::string(key_) +
-                                      "\" should be \"None\" or \"Fixed\".");
+      if (s == "Adaptive") {
+        return TimeStepMode::Adaptive;
+      }
+      throw IncorrectTypeInAssignment(
+          "The value for key \"" + std::string(key_) +
+          "\" should be \"None\", \"Fixed\" or \"Adaptive\".");
+    }
+
+    /**
+     * Set the strategy for the grid cell sizes from configuration values.
+     *
+     * \return Strategy of the grid cell sizes.
+     * \throw IncorrectTypeInAssignment in case a strategy that is not
+     * available is provided as a configuration value.
+     */
+    operator CellSizeStrategy() const {
+      const std::string s = operator std::string();
+      if (s == "Optimal") {
+        return CellSizeStrategy::Optimal;
+      }
+      if (s == "Largest") {
+        return CellSizeStrategy::Largest;
+      }
+      if (s == "Anisotropic") {
+        return CellSizeStrategy::Anisotropic;
+      }
+      throw IncorrectTypeInAssignment(
+          "The value for key \"" + std::string(key_) +
+          "\" should be \"Optimal\", \"Largest\" or \"Anisotropic\".");
     }
 
     /**
@@ -966,6 +1012,50 @@ class Configuration {
                                       "\"Geometric\" or \"Stochastic\".");
     }
 
+    /**
+     * Set the cross-section mode from configuration values.
+     *
+     * \return CrossSectionMode.
+     * \throw IncorrectTypeInAssignment in case a mode that is not available is
+     * provided as a configuration value.
+     */
+    operator CrossSectionMode() const {
+      const std::string s = operator std::string();
+      if (s == "Direct") {
+        return CrossSectionMode::Direct;
+      }
+      if (s == "Tabulated") {
+        return CrossSectionMode::Tabulated;
+      }
+      if (s == "Validated") {
+        return CrossSectionMode::Validated;
+      }
+      throw IncorrectTypeInAssignment(
+          "The value for key \"" + std::string(key_) + "\" should be " +
+          "\"Direct\", \"Tabulated\" or \"Validated\".");
+    }
+
+    /**
+     * Set the computation method of the photon cross sections from
+     * configuration values.
+     *
+     * \return ComputationMethod.
+     * \throw IncorrectTypeInAssignment in case a method that is not available
+     * is provided as a configuration value.
+     */
+    operator ComputationMethod() const {
+      const std::string s = operator std::string();
+      if (s == "Analytic") {
+        return ComputationMethod::Analytic;
+      }
+      if (s == "Lookup") {
+        return ComputationMethod::Lookup;
+      }
+      throw IncorrectTypeInAssignment("The value for key \"" +
+                                      std::string(key_) + "\" should be " +
+                                      "\"Analytic\" or \"Lookup\".");
+    }
+
     /**
      * Set OutputOnlyFinal for particles output from configuration values.
      *
@@ -0,0 +1,158 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_CROSSSECTIONENVELOPE_H_
+#define SRC_INCLUDE_CROSSSECTIONENVELOPE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "forwarddeclarations.h"
+#include "particledata.h"
+
+namespace smash {
+
+/**
+ * \ingroup action
+ *
+ * Upper bound of the total cross section of two particle species as a
+ * function of \f$\sqrt{s}\f$.
+ *
+ * It is used to reject pairs in the geometric collision criterion whose
+ * transverse distance is too large for any cross section they could have,
+ * without generating all their collision branches.
+ *
+ * The range of \f$\sqrt{s}\f$ above the smallest threshold of a pair is
+ * divided into bins of constant relative width. The bound of a bin is the
+ * largest cross section found at its edges, its center and the pole masses of
+ * all resonances inside of it, for several masses of unstable incoming
+ * particles, multiplied by a safety factor. A bin is unbounded if any of
+ * these cross sections is not finite, e.g. at a threshold. The bins are
+ * filled lazily at their first use. This can be done concurrently by several
+ * threads.
+ *
+ * Sampling alone cannot guarantee the bound. Therefore the pairs that are
+ * not rejected, i.e. also the ones within the safety margin, get their full
+ * cross section computed, which is passed to verify(). A cross section above
+ * the bound raises the bin, such that the margin is restored, and is
+ * reported as a warning, since a collision could have been missed before.
+ * The bound does not account for potentials.
+ */
+class CrossSectionEnvelope {
+ public:
+  /// Function returning the total cross section [mb] of two particles
+  using TotalCrossSection =
+      std::function<double(const ParticleData &, const ParticleData &)>;
+
+  /**
+   * Create an empty envelope.
+   *
+   * \param[in] total_xs The total cross section that is bounded.
+   * \param[in] safety_factor Factor applied to the sampled maxima.
+   */
+  explicit CrossSectionEnvelope(TotalCrossSection total_xs,
+                                double safety_factor = 1.5);
+
+  /**
+   * \param[in] type_a Type of the first particle
+   * \param[in] type_b Type of the second particle
+   * \param[in] sqrt_s Center of mass energy [GeV]
+   * \return upper bound of the total cross section [mb], which is infinite
+   *         if \p sqrt_s is beyond the tabulated range.
+   */
+  double upper_bound(const ParticleType &type_a, const ParticleType &type_b,
+                     double sqrt_s) const;
+
+  /**
+   * Check the bound against a cross section computed in full and raise the
+   * bin to the safety factor times \p xs, if that is larger.
+   *
+   * \param[in] type_a Type of the first particle
+   * \param[in] type_b Type of the second particle
+   * \param[in] sqrt_s Center of mass energy [GeV]
+   * \param[in] xs Total cross section of the pair [mb]
+   * \return whether \p xs was within the bound.
+   */
+  bool verify(const ParticleType &type_a, const ParticleType &type_b,
+              double sqrt_s, double xs) const;
+
+  /// \return how often verify() found a cross section above the bound.
+  std::size_t violations() const { return violations_.load(); }
+
+  /// Number of bins per pair of particle types
+  static constexpr int n_bins = 1000;
+  /// Relative width of the \f$\sqrt{s}\f$ bins
+  static constexpr double relative_bin_width = 0.005;
+
+ private:
+  /// Bounds of one pair of particle types; negative values are not yet filled
+  struct Table {
+    /**
+     * Create a table with unfilled bins.
+     *
+     * \param[in] min_sqrts Smallest possible \f$\sqrt{s}\f$ of the pair.
+     */
+    explicit Table(double min_sqrts);
+    /// Lower edge of the first bin [GeV]
+    const double min_sqrts;
+    /// Bounds of the bins [mb]
+    std::vector<std::atomic<double>> bins;
+  };
+
+  /**
+   * Find the bin containing \p sqrt_s, creating the table of the pair if
+   * needed.
+   *
+   * \param[in] first Type with the lower index
+   * \param[in] second Type with the higher index
+   * \param[in] sqrt_s Center of mass energy [GeV]
+   * \return the table and the index of the bin, which is n_bins if \p sqrt_s
+   *         is beyond the tabulated range.
+   */
+  std::pair<Table *, int> find_bin(const ParticleType &first,
+                                   const ParticleType &second,
+                                   double sqrt_s) const;
+
+  /**
+   * Sample the cross section in a bin.
+   *
+   * \param[in] type_a Type of the first particle
+   * \param[in] type_b Type of the second particle
+   * \param[in] lower Lower edge of the bin [GeV]
+   * \param[in] upper Upper edge of the bin [GeV]
+   * \return the bound of the bin, including the safety factor [mb]. It is
+   *         infinite if a sampled cross section is not finite.
+   */
+  double fill_bin(const ParticleType &type_a, const ParticleType &type_b,
+                  double lower, double upper) const;
+
+  /// The bounded cross section
+  const TotalCrossSection total_xs_;
+  /// Factor applied to the sampled maxima
+  const double safety_factor_;
+  /// Number of particle types
+  const std::size_t n_types_;
+  /// Tables for all ordered pairs of types, nullptr if not yet created
+  std::unique_ptr<std::atomic<Table *>[]> tables_;
+  /// Owns the created tables
+  mutable std::vector<std::unique_ptr<Table>> owned_tables_;
+  /// Guards the creation of tables
+  mutable std::mutex mutex_;
+  /// Number of cross sections found above the bound by verify()
+  mutable std::atomic<std::size_t> violations_{0};
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_CROSSSECTIONENVELOPE_H_
@@ -11,14 +11,11 @@
 #define SRC_INCLUDE_CROSSSECTIONSPHOTON_H_
 
 #include "cxx14compat.h"
+#include "forwarddeclarations.h"
 #include "kinematics.h"
+#include "sha256.h"
 
 namespace smash {
-/**
- * Calculation method for the cross sections. It has only one member at the
- * moment. In the future there will be more options.
- */
-enum class ComputationMethod { Analytic };
 
 template <ComputationMethod method>
 class CrosssectionsPhoton {};
@@ -129,6 +126,100 @@ class CrosssectionsPhoton<ComputationMethod::Analytic> {
   constexpr static double Pi = M_PI;
 };
 
+/**
+ * Class to calculate the cross-section of a meson-meson to meson-photon
+ * process. This template specialization interpolates in tables of the
+ * analytic cross-sections, which are filled once by tabulate(). Outside of
+ * the tabulated range and as long as the tables are not filled, the analytic
+ * cross-sections are returned.
+ *
+ * The tables are stored for a grid of rho masses as functions of
+ * \f$ x = \sqrt{\sqrt{s} - \sqrt{s}_{\rm thr}} \f$, where
+ * \f$ \sqrt{s}_{\rm thr} \f$ is the threshold for the given rho mass, such
+ * that the rise and fall of the cross sections close to the threshold is
+ * resolved. The differential cross-sections are additionally tabulated as
+ * functions of \f$ t \f$ scaled to the kinematically allowed range.
+ */
+template <>
+class CrosssectionsPhoton<ComputationMethod::Lookup> {
+ public:
+  /**
+   * Fill the tables, either from the cache on disk or from the analytic
+   * cross-sections.
+   *
+   * \param[in] hash SHA256 hash of the particle and decay properties, which
+   *            identifies valid tables on disk.
+   * \param[in] tabulations_path Path to the directory of the cached tables.
+   */
+  static void tabulate(sha256::Hash hash, const bf::path &tabulations_path);
+
+  /// \return Whether the tables are filled.
+  static bool is_tabulated();
+
+  /** @name Total cross-section
+   * The functions in this group look up the total cross-section for a photon
+   * process.
+   */
+  ///@{
+  /**
+   * Total cross sections for given photon process:
+   *
+   * \param[in] s Mandelstam-s [GeV^2]
+   * \param[in] m_rho Mass of participating rho-meson [GeV]
+   * \returns photon cross-section [mb]
+   */
+  static double xs_pi_pi_rho0(const double s, const double m_rho);
+  static double xs_pi_pi0_rho(const double s, const double m_rho);
+  static double xs_pi0_rho0_pi0(const double s, const double m_rho);
+  static double xs_pi_rho0_pi(const double s, const double m_rho);
+
+  static double xs_pi_rho_pi0(const double s, const double m_rho);
+  static double xs_pi_rho_pi0_rho_mediated(const double s, const double m_rho);
+  static double xs_pi_rho_pi0_omega_mediated(const double s,
+                                             const double m_rho);
+
+  static double xs_pi0_rho_pi(const double s, const double m_rho);
+  static double xs_pi0_rho_pi_rho_mediated(const double s, const double m_rho);
+  static double xs_pi0_rho_pi_omega_mediated(const double s,
+                                             const double m_rho);
+  ///@}
+
+  /** @name Differential cross-section
+   * The functions in this group look up the differential cross-section for a
+   * photon process.
+   */
+  ///@{
+  /**
+   * Differential cross section for given photon process.
+   *
+   * \param[in] s Mandelstam-s [GeV^2]
+   * \param[in] t Mandelstam-t [GeV^2]
+   * \param[in] m_rho Mass of participating rho-meson [GeV]
+   * \returns photon cross-section [mb]
+   */
+  static double xs_diff_pi_pi_rho0(const double s, const double t,
+                                   const double m_rho);
+  static double xs_diff_pi_pi0_rho(const double s, const double t,
+                                   const double m_rho);
+  static double xs_diff_pi0_rho0_pi0(const double s, const double t,
+                                     const double m_rho);
+  static double xs_diff_pi_rho0_pi(const double s, const double t,
+                                   const double m_rho);
+
+  static double xs_diff_pi_rho_pi0_rho_mediated(const double s, const double t,
+                                                const double m_rho);
+  static double xs_diff_pi_rho_pi0_omega_mediated(const double s,
+                                                  const double t,
+                                                  const double m_rho);
+
+  static double xs_diff_pi0_rho_pi_rho_mediated(const double s, const double t,
+                                                const double m_rho);
+  static double xs_diff_pi0_rho_pi_omega_mediated(const double s,
+                                                  const double t,
+                                                  const double m_rho);
+  ///@}
+};
+
 }  // namespace smash
 
 #endif  // SRC_INCLUDE_CROSSSECTIONSPHOTON_H_
@@ -0,0 +1,180 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_CROSSSECTIONTABLES_H_
+#define SRC_INCLUDE_CROSSSECTIONTABLES_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "forwarddeclarations.h"
+#include "particledata.h"
+#include "processbranch.h"
+
+namespace smash {
+
+/**
+ * \ingroup action
+ *
+ * Tabulated partial cross sections of pairs of stable particle species.
+ *
+ * Without potentials, the collision branches of two on-shell particles only
+ * depend on their types and \f$\sqrt{s}\f$. The branches are therefore
+ * computed on nodes of constant relative spacing in \f$\sqrt{s}\f$ and
+ * linearly interpolated in between. A table of nodes is created for each
+ * ordered pair of species, and each node is computed at its first use. This
+ * can be done concurrently by several threads.
+ *
+ * Branches whose threshold lies above the interpolated \f$\sqrt{s}\f$ are
+ * dropped. The interval between the threshold of the incoming pair and the
+ * first node, where cross sections might diverge, is not tabulated.
+ */
+class CrossSectionTables {
+ public:
+  /// Function computing the collision branches of two particles directly
+  using CollisionList =
+      std::function<CollisionBranchList(const ParticleData &,
+                                        const ParticleData &)>;
+
+  /**
+   * Create empty tables.
+   *
+   * \param[in] direct The computation of the collision branches that is
+   *            tabulated.
+   * \param[in] relative_step Relative spacing of the \f$\sqrt{s}\f$ nodes.
+   * \throw std::invalid_argument if \p relative_step is not positive.
+   */
+  CrossSectionTables(CollisionList direct, double relative_step);
+
+  /// Report the collected validation statistics, if any.
+  ~CrossSectionTables();
+
+  /**
+   * \param[in] data_a First incoming particle
+   * \param[in] data_b Second incoming particle
+   * \return whether the collision branches of the two particles can be
+   *         looked up, i.e. whether both are stable and on their mass shell
+   *         and their \f$\sqrt{s}\f$ is inside of the tabulated range.
+   */
+  bool covers(const ParticleData &data_a, const ParticleData &data_b) const;
+
+  /**
+   * Interpolate the collision branches of a pair of particles, which has to
+   * be covered by the tables.
+   *
+   * \param[in] type_a Type of the first particle
+   * \param[in] type_b Type of the second particle
+   * \param[in] sqrt_s Center of mass energy [GeV]
+   * \return the interpolated collision branches with nonzero weight.
+   */
+  CollisionBranchList collision_list(const ParticleType &type_a,
+                                     const ParticleType &type_b,
+                                     double sqrt_s) const;
+
+  /**
+   * Compare interpolated with directly computed collision branches and
+   * collect statistics of the deviation, which is the summed absolute
+   * difference of all partial cross sections, relative to the total cross
+   * section. Deviations larger than the relative step are logged.
+   *
+   * \param[in] tabulated The interpolated branches.
+   * \param[in] direct The directly computed branches.
+   * \param[in] sqrt_s Center of mass energy [GeV]
+   * \return the relative deviation.
+   */
+  double validate(const CollisionBranchList &tabulated,
+                  const CollisionBranchList &direct, double sqrt_s) const;
+
+  /// Largest tabulated \f$\sqrt{s}\f$ [GeV]
+  static constexpr double max_sqrts = 1000.;
+
+ private:
+  /// Partial cross section of one channel at one node
+  struct Channel {
+    /// Kind of process
+    ProcessType process;
+    /// Outgoing particle types
+    ParticleTypePtrList types;
+    /// Partial cross section [mb]
+    double weight;
+    /**
+     * Order channels by process type and outgoing particles.
+     *
+     * \param[in] rhs The channel to compare to.
+     * \return whether this channel comes first.
+     */
+    bool operator<(const Channel &rhs) const;
+  };
+  /// All channels at one node, ordered
+  using Node = std::vector<Channel>;
+
+  /// Nodes of one ordered pair of particle types
+  struct Table {
+    /**
+     * Create a table without computed nodes.
+     *
+     * \param[in] first_node \f$\sqrt{s}\f$ of the first node [GeV].
+     * \param[in] n_nodes Number of nodes.
+     */
+    Table(double first_node, std::size_t n_nodes);
+    /// \f$\sqrt{s}\f$ of the first node [GeV]
+    const double first_node;
+    /// The nodes, nullptr if not yet computed
+    mutable std::vector<std::atomic<const Node *>> nodes;
+  };
+
+  /**
+   * \param[in] type_a Type of the first particle
+   * \param[in] type_b Type of the second particle
+   * \return the table of the pair, which is created if necessary.
+   */
+  const Table &table(const ParticleType &type_a,
+                     const ParticleType &type_b) const;
+
+  /**
+   * \param[in] type_a Type of the first particle
+   * \param[in] type_b Type of the second particle
+   * \param[in] table The table of the pair.
+   * \param[in] i Index of the node.
+   * \return the node, which is computed if necessary.
+   */
+  const Node &node(const ParticleType &type_a, const ParticleType &type_b,
+                   const Table &table, std::size_t i) const;
+
+  /// The tabulated computation
+  const CollisionList direct_;
+  /// Relative spacing of the nodes
+  const double relative_step_;
+  /// Logarithm of one plus the relative step
+  const double log_step_;
+  /// Number of particle types
+  const std::size_t n_types_;
+  /// Tables of all ordered pairs of types, nullptr if not yet created
+  std::unique_ptr<std::atomic<Table *>[]> tables_;
+  /// Owns the created tables
+  mutable std::vector<std::unique_ptr<Table>> owned_tables_;
+  /// Owns the computed nodes
+  mutable std::vector<std::unique_ptr<Node>> owned_nodes_;
+  /// Number of validated lookups
+  mutable std::size_t n_validated_ = 0;
+  /// Number of validated lookups deviating by more than the relative step
+  mutable std::size_t n_deviating_ = 0;
+  /// Largest relative deviation found in validation
+  mutable double max_deviation_ = 0.;
+  /// Guards the creation of tables and nodes and the statistics
+  mutable std::mutex mutex_;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_CROSSSECTIONTABLES_H_
@@ -47,6 +47,16 @@ class DecayAction : public Action {
    */
   void add_decay(DecayBranchPtr p);
 
+  /**
+   * Add the decay that was already chosen among all decays of the particle,
+   * such that the branches of the other decays are not needed. It is
+   * performed by generate_final_state.
+   *
+   * \param[in] p Chosen decay.
+   * \param[in] total_width Total width of all decays of the particle.
+   */
+  void add_chosen_decay(DecayBranchPtr p, double total_width);
+
   /**
    * Generate the final state of the decay process.
    * Performs a decay of one particle to two or three particles.
@@ -104,6 +114,9 @@ class DecayAction : public Action {
 
   /// Angular momentum of the decay
   int L_ = 0;
+
+  /// Whether the decay was chosen with add_chosen_decay
+  bool decay_chosen_ = false;
 };
 
 }  // namespace smash
@@ -10,7 +10,11 @@
 #ifndef SRC_INCLUDE_DECAYACTIONSFINDERDILEPTON_H_
 #define SRC_INCLUDE_DECAYACTIONSFINDERDILEPTON_H_
 
+#include <vector>
+
+#include "forwarddeclarations.h"
 #include "outputinterface.h"
+#include "tabulation.h"
 
 namespace smash {
 
@@ -26,11 +30,24 @@ namespace smash {
  * See \iref{Schmidt:2008hm}, chapter 2D.
  * The finder works with two body dilepton decays as well as with dalitz
  * dilepton decays.
+ *
+ * In the batched mode, the dileptons are not shone at every propagation, but
+ * once per time step with the weight integrated over the step, see
+ * shine_batch.
  */
 class DecayActionsFinderDilepton {
  public:
-  /// Initialize the finder
-  DecayActionsFinderDilepton() {}
+  /**
+   * Initialize the finder.
+   *
+   * \param[in] batched Whether the dileptons are shone in batches, see
+   *            shine_batch. Then the partial widths of the dilepton decays are
+   *            tabulated as functions of the mass for all particle types.
+   */
+  explicit DecayActionsFinderDilepton(bool batched = false);
+
+  /// \return whether the dileptons are shone in batches.
+  bool batched() const { return batched_; }
 
   /**
    * Check the whole particles list and print out possible dilepton decays.
@@ -42,6 +59,41 @@ class DecayActionsFinderDilepton {
   void shine(const Particles& search_list, OutputInterface* output,
              double dt) const;
 
+  /**
+   * Start the batched shining of an event.
+   *
+   * \param[in] time Start time of the event [fm]
+   */
+  void start_batches(double time) { batch_start_time_ = time; }
+
+  /**
+   * Shine dileptons from the incoming particles of a performed action, for
+   * the time they existed and were formed since the start of the current
+   * batch. This has to be called for every performed action in the batched
+   * mode, because they do not shine in shine_batch anymore. Nothing is done
+   * for wall crossings, which do not change the particles.
+   *
+   * \param[in] action The performed action.
+   * \param[in] outputs The dilepton decays are written to the dilepton
+   *            outputs among them.
+   */
+  void shine_incoming(const Action& action, const OutputsList& outputs) const;
+
+  /**
+   * Shine dileptons from all particles for the time they existed and were
+   * formed since the start of the current batch and start the next batch.
+   * Every dilepton decay is written once with the weight integrated over this
+   * time, which is much cheaper than shining at every propagation. The
+   * decays are sampled at the current state of the particles.
+   *
+   * \param[in] particles All particles, propagated to \p time.
+   * \param[in] time End time of the batch [fm]
+   * \param[in] outputs The dilepton decays are written to the dilepton
+   *            outputs among them.
+   */
+  void shine_batch(const Particles& particles, double time,
+                   const OutputsList& outputs);
+
   /**
    * Shine dileptons from resonances at the end of the simulation.
    *
@@ -56,6 +108,44 @@ class DecayActionsFinderDilepton {
    */
   void shine_final(const Particles& search_list, OutputInterface* output,
                    bool only_res = false) const;
+
+ private:
+  /// A dilepton decay mode with its tabulated partial width
+  struct DileptonMode {
+    /// Index of the mode in the decay mode list of the particle type
+    size_t index;
+    /**
+     * Partial width as a function of \f$ \sqrt{m - m_{min}} \f$, like the
+     * total width in ParticleType::enable_width_tabulation
+     */
+    Tabulation width;
+  };
+
+  /**
+   * Shine the dilepton decays of a particle for the time it existed and was
+   * formed since the start of the current batch, up to its current time.
+   *
+   * \param[in] p The particle.
+   * \param[in] outputs See shine_batch.
+   */
+  void shine_particle(const ParticleData& p,
+                      const OutputsList& outputs) const;
+
+  /// Whether the dileptons are shone in batches
+  const bool batched_;
+
+  /**
+   * Dilepton decay modes of the particle types, indexed like the particle
+   * type list. It is only filled in the batched mode and empty for the types
+   * that have no dilepton decays or only dilepton decays.
+   */
+  std::vector<std::vector<DileptonMode>> dilepton_modes_;
+
+  /// Start time of the current batch [fm]
+  double batch_start_time_ = 0.;
+
+  /// Partial widths of a particle, reused to avoid allocations
+  mutable std::vector<double> widths_;
 };
 
 }  // namespace smash
@@ -29,8 +29,7 @@ class DecayType {
    * \param[in] l Angular momentum of the decay.
    * \return The constructed object.
    */
-  DecayType(ParticleTypePtrList part_types, int l)
-      : particle_types_(part_types), L_(l) {}
+  DecayType(ParticleTypePtrList part_types, int l);
   /**
    * Virtual Destructor.
    *
@@ -59,6 +58,17 @@ class DecayType {
   const ParticleTypePtrList &particle_types() const { return particle_types_; }
   /// \return the angular momentum of this branch.
   inline int angular_momentum() const { return L_; }
+  /**
+   * \return the sum of the scale factors of the baryon potential for the
+   * final-state particles (see Potentials::force_scale).
+   */
+  double final_state_scale_B() const { return final_state_scale_B_; }
+  /**
+   * \return the sum of the scale factors of the symmetry potential for the
+   * final-state particles, each multiplied by the relative isospin 3
+   * component (see Potentials::force_scale).
+   */
+  double final_state_scale_I3() const { return final_state_scale_I3_; }
   /**
    * \return the mass-dependent width of the decay.
    *
@@ -84,6 +94,10 @@ class DecayType {
   ParticleTypePtrList particle_types_;
   /// angular momentum of the decay
   int L_;
+  /// see final_state_scale_B()
+  double final_state_scale_B_ = 0.;
+  /// see final_state_scale_I3()
+  double final_state_scale_I3_ = 0.;
 };
 
 /**
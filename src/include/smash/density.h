@@ -408,12 +408,18 @@ void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
   }
   lat->reset();
   const double norm_factor = par.norm_factor_sf();
-  for (const auto &part : particles) {
-    const double dens_factor = density_factor(part.type(), dens_type);
+  /* Only the particles contributing to the density are read from the
+   * ParticleData objects, the others are skipped using the columns. */
+  const ParticleColumns &columns = particles.columns();
+  for (unsigned i = 0; i < columns.size; ++i) {
+    if (!columns.is_particle(i)) {
+      continue;
+    }
+    const double dens_factor = density_factor(*columns.type[i], dens_type);
     if (std::abs(dens_factor) < really_small) {
       continue;
     }
-    const FourVector p = part.momentum();
+    const FourVector p = columns.momentum(i);
     const double m = p.abs();
     if (unlikely(m < really_small)) {
       logg[LDensity].warn("Gaussian smearing is undefined for momentum ", p);
@@ -421,7 +427,8 @@ void update_lattice(RectangularLattice<T> *lat, const LatticeUpdate update,
     }
     const double m_inv = 1.0 / m;
 
-    const ThreeVector pos = part.position().threevec();
+    const ParticleData &part = particles.at_index(i);
+    const ThreeVector pos(columns.x[i], columns.y[i], columns.z[i]);
     lat->iterate_in_radius(
         pos, par.r_cut(), [&](T &node, int ix, int iy, int iz) {
           const ThreeVector r = lat->cell_center(ix, iy, iz);
@@ -7,15 +7,24 @@
 #ifndef SRC_INCLUDE_EXPERIMENT_H_
 #define SRC_INCLUDE_EXPERIMENT_H_
 
+#include <condition_variable>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "actionfinderfactory.h"
 #include "actions.h"
+#include "adaptivetimestep.h"
+#include "arena.h"
 #include "bremsstrahlungaction.h"
+#include "bufferedoutput.h"
 #include "chrono.h"
+#include "crosssectionsphoton.h"
 #include "decayactionsfinder.h"
 #include "decayactionsfinderdilepton.h"
 #include "energymomentumtensor.h"
@@ -33,6 +42,8 @@
 #include "scatteractionphoton.h"
 #include "scatteractionsfinder.h"
 #include "thermalizationaction.h"
+#include "threadpool.h"
+#include "verletlists.h"
 // Output
 #include "binaryoutput.h"
 #include "icoutput.h"
@@ -243,6 +254,33 @@ class Experiment : public ExperimentBase {
   template <typename Container>
   bool perform_action(Action &action,
                       const Container &particles_before_actions);
+
+  /**
+   * Runs a single event: samples the initial particles, evolves them in time
+   * and writes the output.
+   *
+   * \param[in] evt_num Number of the event
+   */
+  void run_event(int evt_num);
+
+  /**
+   * Runs the events with several threads. Every thread uses a separate
+   * Experiment, set up from the same configuration, while the particle types
+   * and decay modes are shared. The events get the same seeds as in a
+   * sequential run and their output is buffered and written in the order of
+   * the events, such that the output files are identical to the ones of a
+   * sequential run. If an event throws, no further events are started and the
+   * exception is passed on once the running events have finished.
+   */
+  void run_events_in_parallel();
+
+  /**
+   * Draws the seed of the next event from the random number engine. It is
+   * positive, so it can be entered in the config.
+   *
+   * \return the seed.
+   */
+  static int64_t draw_seed();
   /**
    * Create a list of output files
    *
@@ -256,12 +294,21 @@ class Experiment : public ExperimentBase {
 
   /**
    * Propagate all particles until time to_time without any interactions
-   * and shine dileptons.
+   * and shine dileptons, unless they are shone in batches.
    *
    * \param[in] to_time Time at the end of propagation [fm/c]
    */
   void propagate_and_shine(double to_time);
 
+  /**
+   * Propagate only the given particles until time to_time, if they were not
+   * propagated that far yet.
+   *
+   * \param[in] list Copies of the particles to be propagated.
+   * \param[in] to_time Time at the end of propagation [fm/c]
+   */
+  void propagate_lazily(const ParticleListView &list, double to_time);
+
   /**
    * Performs all the propagations and actions during a certain time interval
    * neglecting the influence of the potentials. This function is called in
@@ -276,6 +323,19 @@ class Experiment : public ExperimentBase {
    */
   void run_time_evolution_timestepless(Actions &actions);
 
+  /**
+   * Finds the actions at the beginning of a timestep with the Verlet lists,
+   * which are updated first. Every particle on the grid is handed to the
+   * action finders on its own and together with its partners from the lists.
+   *
+   * \param[in] interaction_length Largest distance of two particles that can
+   *            interact within the timestep [fm]
+   * \param[in] dt Duration of the timestep [fm]
+   * \param[out] actions The found actions are added here.
+   */
+  void find_actions_with_verlet_lists(double interaction_length, double dt,
+                                      Actions &actions);
+
   /// Intermediate output during an event
   void intermediate_output();
 
@@ -299,6 +359,13 @@ class Experiment : public ExperimentBase {
     return parameters_.outputclock->next_time();
   }
 
+  /**
+   * The configuration, as passed to the constructor, from which the
+   * experiments running the events in parallel are set up. It is empty if
+   * the events run sequentially.
+   */
+  const std::string event_worker_config_;
+
   /**
    * Struct of several member variables.
    * These variables are combined into a struct for efficient input to functions
@@ -318,6 +385,33 @@ class Experiment : public ExperimentBase {
   /// Complete particle list
   Particles particles_;
 
+  /**
+   * The type of the grid created by the Modus (with periodic boundaries for
+   * the box and with normal boundaries otherwise).
+   */
+  using GridType = decltype(std::declval<const Modus &>().create_grid(
+      std::declval<const Particles &>(), 0., 0.));
+
+  /**
+   * The grid used for finding actions. It is created by the Modus in the
+   * first timestep of an event and afterwards only updated to the current
+   * state of particles_, so that its cell storage is reused.
+   */
+  std::unique_ptr<GridType> grid_;
+
+  /**
+   * The Verlet lists replacing the search of the grid cells at the beginning
+   * of a timestep, if they are used. Like the grid, they are created in the
+   * first timestep of an event.
+   */
+  std::unique_ptr<VerletLists> verlet_lists_;
+
+  /**
+   * The threads used for finding actions in the grid cells. Only created if
+   * more than one thread is requested.
+   */
+  std::unique_ptr<ThreadPool> thread_pool_;
+
   /**
    * An instance of potentials class, that stores parameters of potentials,
    * calculates them and their gradients.
@@ -372,6 +466,9 @@ class Experiment : public ExperimentBase {
   /// Number of fractional photons produced per single reaction
   int n_fractional_photons_;
 
+  /// How the cross sections of photons from scatterings are computed
+  ComputationMethod photon_computation_method_ = ComputationMethod::Analytic;
+
   /// Baryon density on the lattices
   std::unique_ptr<DensityLattice> jmu_B_lat_;
 
@@ -469,6 +566,12 @@ class Experiment : public ExperimentBase {
   /// This indicates whether to use the grid.
   const bool use_grid_;
 
+  /// How the cells of the grid are chosen if it is used.
+  const CellSizeStrategy grid_cell_sizes_;
+
+  /// Skin distance of the Verlet lists, 0 if they are not used [fm].
+  double verlet_skin_ = 0.;
+
   /// This struct contains information on the metric to be used
   const ExpansionProperties metric_;
 
@@ -487,9 +590,24 @@ class Experiment : public ExperimentBase {
   /// This indicates whether to use time steps.
   const TimeStepMode time_step_mode_;
 
+  /// The number of threads used for finding actions.
+  const int n_threads_;
+
+  /// The number of threads running events in parallel.
+  const int n_event_threads_;
+
+  /**
+   * This indicates whether the particles are only propagated when they take
+   * part in an action, see \key Lazy_Propagation.
+   */
+  bool lazy_propagation_ = false;
+
   /// Maximal distance at which particles can interact, squared
   double max_transverse_distance_sqr_ = std::numeric_limits<double>::max();
 
+  /// Chooses the time steps if Time_Step_Mode = Adaptive.
+  std::unique_ptr<AdaptiveTimeStep> adaptive_timestep_;
+
   /**
    * The conserved quantities of the system.
    *
@@ -650,10 +768,32 @@ ExperimentParameters create_experiment_parameters(Configuration config);
  * \key Nevents (int, required): \n
  * Number of events to calculate.
  *
+ * \key Event_Threads (int, optional, default = 1): \n
+ * Number of events that are calculated in parallel, each in its own thread.
+ * The events use the same random seeds as in a sequential run and their
+ * output is written in the order of the events, such that the results do not
+ * depend on this number. The memory usage grows with the number of threads.
+ * At most twice as many finished events as threads are kept in memory until
+ * their output can be written; further threads wait for that before they
+ * continue. Running events in parallel is not possible with the List modus,
+ * the Forced_Thermalization, the lattice output of thermodynamic quantities,
+ * potentials affecting the thresholds, photons and bremsstrahlung.
+ *
  * \key Use_Grid (bool, optional, default = true): \n
  * \li \key true - A grid is used to reduce the combinatorics of interaction
  * lookup \n \li \key false - No grid is used.
  *
+ * \key Grid_Cell_Sizes (string, optional, default = Optimal): \n
+ * How the cells of the grid are chosen. Their length is at least the largest
+ * distance over which particles interact within a time step in any case.
+ * \li \key Optimal - The number of cells in each direction is at most the
+ * cube root of the number of particles. \n
+ * \li \key Anisotropic - Only the total number of cells is limited by the
+ * number of particles. For flat or elongated systems, like the
+ * Lorentz-contracted nuclei in high-energy collisions, this gives many more
+ * and thus less crowded cells along the large extents. \n
+ * \li \key Largest - As few cells as possible, like without grid. \n
+ *
  * \key Time_Step_Mode (string, optional, default = Fixed): \n
  * The mode of time stepping. Possible values: \n
  * \li \key None - Delta_Time is set to the End_Time.  Cannot be used with
@@ -661,9 +801,23 @@ ExperimentParameters create_experiment_parameters(Configuration config);
  * \li \key Fixed - Fixed-sized time steps at which collision-finding grid is
  * created.  More efficient for systems with many particles. The Delta_Time is
  * provided by user.\n
+ * \li \key Adaptive - Time steps whose size follows the state of the system,
+ * starting with Delta_Time. Small steps are taken in the dense stage and large
+ * ones in the dilute stage. See \key Adaptive_Time_Step below.\n
  *
  * For Delta_Time explanation see \ref input_general_.
  *
+ * \key Lazy_Propagation (bool, optional, default = false): \n
+ * If true, only the particles taking part in an action and their neighbors
+ * in the grid are propagated to the time of the action. All other particles
+ * keep the time of their last update in their position and are propagated
+ * for the output and at the end of every time step. This makes the cost of
+ * an action independent of the number of particles, while the results agree
+ * with the default propagation. It cannot be used together with dileptons,
+ * Pauli blocking or a density type for the output, which need the positions
+ * of all particles at the time of every action; it is switched off in these
+ * cases.
+ *
  * \key Metric_Type (string, optional, default = NoExpansion): \n
  * Select which kind of expansion the metric should have. This needs only be
  * specified for the sphere modus:
@@ -712,6 +866,26 @@ ExperimentParameters create_experiment_parameters(Configuration config);
  * \li \key true - Force all resonances to decay after last timestep \n
  * \li \key false - Don't force decays (final output can contain resonances)
  *
+ * \key Threads (int, optional, default = 1): \n
+ * Number of threads used for finding the actions of a timestep. The grid
+ * cells are distributed among the threads. Every cell uses its own random
+ * number stream, which is derived from the event seed, so the results do not
+ * depend on the number of threads.
+ *
+ * \key Verlet_Lists (bool, optional, default = false): \n
+ * Find the actions at the beginning of a timestep with neighbor lists of all
+ * particles instead of searching the grid cells. The lists contain the
+ * particles within the interaction length plus the Verlet_Skin. They are
+ * only rebuilt when the particles moved far enough to make them incomplete,
+ * so most timesteps compare each particle only with its actual neighbors
+ * instead of the contents of 27 cells. The number of rebuilds is printed at
+ * the end of each event. Only used with the grid, normal boundaries and the
+ * geometric collision criterion.
+ *
+ * \key Verlet_Skin (double, optional, default = 4 Delta_Time [fm]): \n
+ * Distance added to the interaction length for the Verlet lists. A larger
+ * skin means fewer rebuilds, but longer lists.
+ *
  * \key No_Collisions (bool, optional, default = false) \n
  * Disable all possible collisions, only allow decays to occur
  * if not forbidden by other options. Useful for running SMASH
@@ -779,7 +953,10 @@ ExperimentParameters create_experiment_parameters(Configuration config);
  */
 template <typename Modus>
 Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
-    : parameters_(create_experiment_parameters(config)),
+    : event_worker_config_(
+          config.read({"General", "Event_Threads"}, 1) > 1 ? config.to_string()
+                                                           : std::string()),
+      parameters_(create_experiment_parameters(config)),
       density_param_(DensityParameters(parameters_)),
       modus_(config["Modi"], parameters_),
       particles_(),
@@ -789,6 +966,8 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
       force_decays_(
           config.take({"Collision_Term", "Force_Decays_At_End"}, true)),
       use_grid_(config.take({"General", "Use_Grid"}, true)),
+      grid_cell_sizes_(config.take({"General", "Grid_Cell_Sizes"},
+                                   CellSizeStrategy::Optimal)),
       metric_(
           config.take({"General", "Metric_Type"}, ExpansionMode::NoExpansion),
           config.take({"General", "Expansion_Rate"}, 0.1)),
@@ -800,17 +979,55 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
           config.take({"Collision_Term", "Photons", "Bremsstrahlung"}, false)),
       IC_output_switch_(config.has_value({"Output", "Initial_Conditions"})),
       time_step_mode_(
-          config.take({"General", "Time_Step_Mode"}, TimeStepMode::Fixed)) {
+          config.take({"General", "Time_Step_Mode"}, TimeStepMode::Fixed)),
+      n_threads_(config.take({"Collision_Term", "Threads"}, 1)),
+      n_event_threads_(config.take({"General", "Event_Threads"}, 1)) {
   logg[LExperiment].info() << *this;
 
+  if (config.take({"Collision_Term", "Verlet_Lists"}, false)) {
+    const double skin = config.take({"Collision_Term", "Verlet_Skin"},
+                                    4. * delta_time_startup_);
+    if (!(skin > 0.)) {
+      throw std::invalid_argument("Verlet_Skin has to be positive.");
+    }
+    if (!use_grid_) {
+      logg[LExperiment].warn("Verlet lists require the grid, not using them.");
+    } else if (std::is_same<GridType,
+                            Grid<GridOptions::PeriodicBoundaries>>::value) {
+      logg[LExperiment].warn(
+          "Verlet lists are not available with periodic boundaries, not "
+          "using them.");
+    } else if (config.read({"Collision_Term", "Collision_Criterion"},
+                           CollisionCriterion::Geometric) ==
+               CollisionCriterion::Stochastic) {
+      logg[LExperiment].warn(
+          "Verlet lists are not available with the stochastic collision "
+          "criterion, not using them.");
+    } else {
+      verlet_skin_ = skin;
+    }
+  }
+
   // create finders
   if (dileptons_switch_) {
-    dilepton_finder_ = make_unique<DecayActionsFinderDilepton>();
+    dilepton_finder_ = make_unique<DecayActionsFinderDilepton>(
+        config.take({"Collision_Term", "Dileptons", "Batched_Shining"}, false));
   }
   if (photons_switch_ || bremsstrahlung_switch_) {
     n_fractional_photons_ =
         config.take({"Collision_Term", "Photons", "Fractional_Photons"}, 100);
   }
+  if (photons_switch_) {
+    photon_computation_method_ =
+        config.take({"Collision_Term", "Photons", "Cross_Sections"},
+                    ComputationMethod::Analytic);
+    if (photon_computation_method_ == ComputationMethod::Lookup &&
+        !CrosssectionsPhoton<ComputationMethod::Lookup>::is_tabulated()) {
+      logg[LExperiment].warn(
+          "The photon cross sections are not tabulated, they are computed "
+          "analytically.");
+    }
+  }
   if (parameters_.two_to_one) {
     if (parameters_.res_lifetime_factor < 0.) {
       throw std::invalid_argument(
@@ -874,6 +1091,15 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
         make_unique<HyperSurfaceCrossActionsFinder>(proper_time));
   }
 
+  if (time_step_mode_ == TimeStepMode::Adaptive) {
+    adaptive_timestep_ = make_unique<AdaptiveTimeStep>(
+        config, delta_time_startup_, M_PI * max_transverse_distance_sqr_);
+    logg[LExperiment].info()
+        << "Adaptive time steps between "
+        << adaptive_timestep_->min_timestep() << " and "
+        << adaptive_timestep_->max_timestep() << " fm/c.";
+  }
+
   if (config.has_value({"Collision_Term", "Pauli_Blocking"})) {
     logg[LExperiment].info() << "Pauli blocking is ON.";
     pauli_blocker_ = make_unique<PauliBlocker>(
@@ -882,6 +1108,19 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
   ParticleData::formation_power_ =
       config.take({"Collision_Term", "Power_Particle_Formation"}, 1.);
 
+  if (n_threads_ < 1) {
+    throw std::invalid_argument("Collision_Term: Threads must be positive.");
+  }
+  if (n_threads_ > 1) {
+    logg[LExperiment].info() << "Finding actions with " << n_threads_
+                             << " threads.";
+    ParticleType::prepare_for_multithreading();
+    thread_pool_ = make_unique<ThreadPool>(n_threads_);
+  }
+  if (n_event_threads_ < 1) {
+    throw std::invalid_argument("General: Event_Threads must be positive.");
+  }
+
   /*!\Userguide
    * \page input_general_
    *
@@ -1142,6 +1381,16 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
   logg[LExperiment].debug()
       << "Density type printed to headers: " << dens_type_;
 
+  lazy_propagation_ = config.take({"General", "Lazy_Propagation"}, false);
+  if (lazy_propagation_ &&
+      (dilepton_finder_ || pauli_blocker_ || dens_type_ != DensityType::None)) {
+    logg[LExperiment].warn()
+        << "Lazy propagation is switched off, because dileptons, Pauli "
+           "blocking or the density output need all particles at the time of "
+           "every action.";
+    lazy_propagation_ = false;
+  }
+
   const OutputParameters output_parameters(std::move(output_conf));
 
   std::vector<std::string> output_contents = output_conf.list_upmost_nodes();
@@ -1315,6 +1564,20 @@ Experiment<Modus>::Experiment(Configuration config, const bf::path &output_path)
     thermalizer_ = modus_.create_grandcan_thermalizer(th_conf);
   }
 
+  if (n_event_threads_ > 1) {
+    /* Photons and bremsstrahlung set up their cross sections in global
+     * state on first use, which is not safe in several threads. */
+    if (modus_.is_list() || thermalizer_ || printout_lattice_td_ ||
+        parameters_.potential_affect_threshold || photons_switch_ ||
+        bremsstrahlung_switch_) {
+      throw std::invalid_argument(
+          "Events cannot run in parallel with the List modus, forced "
+          "thermalization, thermodynamic lattice output, potentials "
+          "affecting the thresholds, photons or bremsstrahlung.");
+    }
+    ParticleType::prepare_for_multithreading();
+  }
+
   /* Take the seed setting only after the configuration was stored to a file
    * in smash.cc */
   seed_ = config.take({"General", "Randomseed"});
@@ -1376,16 +1639,8 @@ template <typename Modus>
 void Experiment<Modus>::initialize_new_event() {
   random::set_seed(seed_);
   logg[LExperiment].info() << "random number seed: " << seed_;
-  /* Set seed for the next event. It has to be positive, so it can be entered
-   * in the config.
-   *
-   * We have to be careful about the minimal integer, whose absolute value
-   * cannot be represented. */
-  int64_t r = random::advance();
-  while (r == INT64_MIN) {
-    r = random::advance();
-  }
-  seed_ = std::abs(r);
+  // Set seed for the next event.
+  seed_ = draw_seed();
   /* Set the random seed used in PYTHIA hadronization
    * to be same with the SMASH one.
    * In this way we ensure that the results are reproducible
@@ -1395,6 +1650,10 @@ void Experiment<Modus>::initialize_new_event() {
   }
 
   particles_.reset();
+  grid_.reset();
+  if (verlet_skin_ > 0.) {
+    verlet_lists_ = make_unique<VerletLists>(verlet_skin_);
+  }
 
   // Sample particles according to the initial conditions
   double start_time = modus_.initial_conditions(&particles_, parameters_);
@@ -1407,6 +1666,7 @@ void Experiment<Modus>::initialize_new_event() {
 
   switch (time_step_mode_) {
     case TimeStepMode::Fixed:
+    case TimeStepMode::Adaptive:
       break;
     case TimeStepMode::None:
       timestep = end_time_ - start_time;
@@ -1426,6 +1686,9 @@ void Experiment<Modus>::initialize_new_event() {
   }
   clock_for_this_event = make_unique<UniformClock>(start_time, timestep);
   parameters_.labclock = std::move(clock_for_this_event);
+  if (dilepton_finder_ != nullptr) {
+    dilepton_finder_->start_batches(start_time);
+  }
 
   // Reset the output clock
   parameters_.outputclock->reset(start_time, true);
@@ -1513,6 +1776,10 @@ bool Experiment<Modus>::perform_action(
   const auto id_process = static_cast<uint32_t>(interactions_total_ + 1);
   action.perform(&particles_, id_process);
   interactions_total_++;
+  // In the batched shining, the incoming particles shine for the last time.
+  if (dilepton_finder_ != nullptr && dilepton_finder_->batched()) {
+    dilepton_finder_->shine_incoming(action, outputs_);
+  }
   if (action.get_type() == ProcessType::Wall) {
     wall_actions_total_++;
   }
@@ -1570,7 +1837,8 @@ bool Experiment<Modus>::perform_action(
     constexpr double action_time = 0.;
     ScatterActionPhoton photon_act(action.incoming_particles(), action_time,
                                    n_fractional_photons_,
-                                   action.get_total_weight());
+                                   action.get_total_weight(),
+                                   photon_computation_method_);
 
     /**
      * Add a completely dummy process to the photon action. The only important
@@ -1633,6 +1901,8 @@ void Experiment<Modus>::run_time_evolution() {
     const double dt =
         std::min(parameters_.labclock->timestep_duration(), end_time_ - t);
     logg[LExperiment].debug("Timestepless propagation for next ", dt, " fm/c.");
+    TimeStepMeasurements measured;
+    const uint64_t actions_before = interactions_total_ - wall_actions_total_;
 
     // Perform forced thermalization if required
     if (thermalizer_ &&
@@ -1650,45 +1920,106 @@ void Experiment<Modus>::run_time_evolution() {
     }
 
     if (particles_.size() > 0 && action_finders_.size() > 0) {
-      /* (1.a) Create grid. */
-      double min_cell_length = compute_min_cell_length(dt);
-      logg[LExperiment].debug("Creating grid with minimal cell length ",
+      /* (1.a) Create or update grid. */
+      const double interaction_length = compute_min_cell_length(dt);
+      const double min_cell_length =
+          verlet_lists_ ? verlet_lists_->grid_cell_length(interaction_length)
+                        : interaction_length;
+      logg[LExperiment].debug("Updating grid with minimal cell length ",
                               min_cell_length);
-      const auto &grid =
-          use_grid_ ? modus_.create_grid(particles_, min_cell_length, dt)
-                    : modus_.create_grid(particles_, min_cell_length, dt,
-                                         CellSizeStrategy::Largest);
+      if (!grid_) {
+        grid_ = make_unique<GridType>(
+            use_grid_ ? modus_.create_grid(particles_, min_cell_length, dt,
+                                           grid_cell_sizes_)
+                      : modus_.create_grid(particles_, min_cell_length, dt,
+                                           CellSizeStrategy::Largest));
+      } else {
+        grid_->update(particles_, min_cell_length, dt);
+      }
+      const auto &grid = *grid_;
 
       const double cell_vol = grid.cell_volume();
+      if (adaptive_timestep_ && cell_vol > 0.) {
+        measured.max_density = grid.max_cell_occupancy() / cell_vol;
+      }
 
-      /* (1.b) Iterate over cells and find actions. */
-      grid.iterate_cells(
-          [&](const ParticleList &search_list) {
-            for (const auto &finder : action_finders_) {
-              actions.insert(finder->find_actions_in_cell(
-                  search_list, dt, cell_vol, beam_momentum_));
-            }
-          },
-          [&](const ParticleList &search_list,
-              const ParticleList &neighbors_list) {
-            for (const auto &finder : action_finders_) {
-              actions.insert(finder->find_actions_with_neighbors(
-                  search_list, neighbors_list, dt, beam_momentum_));
-            }
-          });
+      if (verlet_lists_) {
+        /* (1.b) Find actions with the Verlet lists. */
+        find_actions_with_verlet_lists(interaction_length, dt, actions);
+      } else {
+        /* (1.b) Iterate over cells and find actions. The cells may be processed
+         * by different threads, so the actions are collected per cell and
+         * every cell draws from its own random number stream, seeded from the
+         * main engine. This makes the result independent of the number of
+         * threads. */
+        const auto n_cells = grid.cell_count();
+        std::vector<ActionList> cell_actions(n_cells);
+        // The threads must not update the particles while reading them.
+        particles_.sync_records();
+        const random::Engine::result_type timestep_seed = random::advance();
+        const random::Engine main_engine = random::engine;
+        const auto find_actions_in_cell = [&](std::size_t cell) {
+          ActionList &found = cell_actions[cell];
+          const auto append = [&found](ActionList &&new_actions) {
+            found.insert(found.end(),
+                         std::make_move_iterator(new_actions.begin()),
+                         std::make_move_iterator(new_actions.end()));
+          };
+          grid.iterate_cell(
+              cell,
+              [&](const ParticleListView &search_list) {
+                if (search_list.empty()) {
+                  return;
+                }
+                std::seed_seq cell_seed{
+                    static_cast<uint32_t>(timestep_seed),
+                    static_cast<uint32_t>(timestep_seed >> 32),
+                    static_cast<uint32_t>(cell),
+                    static_cast<uint32_t>(uint64_t(cell) >> 32)};
+                random::engine.seed(cell_seed);
+                for (const auto &finder : action_finders_) {
+                  append(finder->find_actions_in_cell(search_list, dt, cell_vol,
+                                                      beam_momentum_));
+                }
+              },
+              [&](const ParticleListView &search_list,
+                  const ParticleListView &neighbors_list) {
+                for (const auto &finder : action_finders_) {
+                  append(finder->find_actions_with_neighbors(
+                      search_list, neighbors_list, dt, beam_momentum_));
+                }
+              });
+        };
+        if (thread_pool_) {
+          thread_pool_->parallel_for(n_cells, find_actions_in_cell);
+        } else {
+          for (std::size_t cell = 0; cell < std::size_t(n_cells); ++cell) {
+            find_actions_in_cell(cell);
+          }
+        }
+        random::engine = main_engine;
+        for (auto &found : cell_actions) {
+          actions.insert(std::move(found));
+        }
+      }
     }
 
-    /* \todo (optimizations) Adapt timestep size here */
-
     /* (2) Propagation from action to action until the end of timestep */
     run_time_evolution_timestepless(actions);
 
+    /* (2.b) Shine the dileptons of the whole time step, if they are not shone
+     * at every propagation. */
+    if (dilepton_finder_ != nullptr && dilepton_finder_->batched()) {
+      dilepton_finder_->shine_batch(particles_, t + dt, outputs_);
+    }
+
     /* (3) Update potentials (if computed on the lattice) and
      *     compute new momenta according to equations of motion */
     if (potentials_) {
       update_potentials();
-      update_momenta(&particles_, parameters_.labclock->timestep_duration(),
-                     *potentials_, FB_lat_.get(), FI3_lat_.get());
+      measured.force_time_scale = update_momenta(
+          &particles_, parameters_.labclock->timestep_duration(), *potentials_,
+          FB_lat_.get(), FI3_lat_.get());
     }
 
     /* (4) Expand universe if non-minkowskian metric; updates
@@ -1713,6 +2044,25 @@ void Experiment<Modus>::run_time_evolution() {
         throw std::runtime_error("Violation of conserved quantities!");
       }
     }
+
+    /* (6) Choose the next time step from the measurements in this one. The
+     * lab clock restarts at the current time with the new step size. The
+     * output clock is independent of it, so the output times stay exact. */
+    if (adaptive_timestep_ && particles_.size() > 0) {
+      measured.actions_per_particle =
+          static_cast<double>(interactions_total_ - wall_actions_total_ -
+                              actions_before) /
+          particles_.size();
+      double next_dt = adaptive_timestep_->next_timestep(
+          parameters_.labclock->timestep_duration(), measured);
+      const double max_dt = modus_.max_timestep(max_transverse_distance_sqr_);
+      if (max_dt > 0. && max_dt < next_dt) {
+        next_dt = max_dt;
+      }
+      logg[LExperiment].debug("Next time step: ", next_dt, " fm/c.");
+      parameters_.labclock = make_unique<UniformClock>(
+          parameters_.labclock->current_time(), next_dt);
+    }
   }
 
   if (pauli_blocker_) {
@@ -1726,13 +2076,26 @@ template <typename Modus>
 void Experiment<Modus>::propagate_and_shine(double to_time) {
   const double dt =
       propagate_straight_line(&particles_, to_time, beam_momentum_);
-  if (dilepton_finder_ != nullptr) {
+  if (dilepton_finder_ != nullptr && !dilepton_finder_->batched()) {
     for (const auto &output : outputs_) {
       dilepton_finder_->shine(particles_, output.get(), dt);
     }
   }
 }
 
+template <typename Modus>
+void Experiment<Modus>::propagate_lazily(const ParticleListView &list,
+                                         double to_time) {
+  for (const ParticleData &p : list) {
+    const ParticleData &current = particles_.lookup(p);
+    if (current.position().x0() < to_time) {
+      ParticleData propagated = current;
+      propagate_straight_line(propagated, to_time, beam_momentum_);
+      particles_.update_particle(current, propagated);
+    }
+  }
+}
+
 /**
  * Make sure `interactions_total` can be represented as a 32-bit integer.
  * This is necessary for converting to a `id_process`. The latter is 32-bit
@@ -1747,6 +2110,71 @@ inline void check_interactions_total(uint64_t interactions_total) {
   }
 }
 
+template <typename Modus>
+void Experiment<Modus>::find_actions_with_verlet_lists(
+    double interaction_length, double dt, Actions &actions) {
+  const auto &grid = *grid_;
+  verlet_lists_->update(grid, particles_, interaction_length, dt);
+  const double cell_vol = grid.cell_volume();
+  const ParticleColumns &columns = particles_.columns();
+  // The threads must not update the particles while reading them.
+  particles_.sync_records();
+  /* Like the grid cells, the chunks of particles may be processed by
+   * different threads and every chunk draws from its own random number
+   * stream. */
+  constexpr std::size_t chunk_size = 256;
+  const std::size_t n_chunks = (columns.size + chunk_size - 1) / chunk_size;
+  std::vector<ActionList> chunk_actions(n_chunks);
+  const random::Engine::result_type timestep_seed = random::advance();
+  const random::Engine main_engine = random::engine;
+  const auto find_actions_in_chunk = [&](std::size_t chunk) {
+    ActionList &found = chunk_actions[chunk];
+    const auto append = [&found](ActionList &&new_actions) {
+      found.insert(found.end(), std::make_move_iterator(new_actions.begin()),
+                   std::make_move_iterator(new_actions.end()));
+    };
+    std::seed_seq chunk_seed{static_cast<uint32_t>(timestep_seed),
+                             static_cast<uint32_t>(timestep_seed >> 32),
+                             static_cast<uint32_t>(chunk),
+                             static_cast<uint32_t>(uint64_t(chunk) >> 32)};
+    random::engine.seed(chunk_seed);
+    std::vector<unsigned> single(1), partners;
+    const std::size_t end =
+        std::min<std::size_t>(columns.size, (chunk + 1) * chunk_size);
+    for (std::size_t i = chunk * chunk_size; i < end; ++i) {
+      if (!columns.is_particle(i)) {
+        continue;
+      }
+      const ParticleData &p = particles_.at_index(i);
+      if (!grid.is_on_grid(p, dt)) {
+        continue;
+      }
+      single[0] = i;
+      const ParticleListView search_list = particles_.view(single);
+      verlet_lists_->collect_partners(grid, particles_, p, partners);
+      for (const auto &finder : action_finders_) {
+        append(finder->find_actions_in_cell(search_list, dt, cell_vol,
+                                            beam_momentum_));
+        if (!partners.empty()) {
+          append(finder->find_actions_with_neighbors(
+              search_list, particles_.view(partners), dt, beam_momentum_));
+        }
+      }
+    }
+  };
+  if (thread_pool_) {
+    thread_pool_->parallel_for(n_chunks, find_actions_in_chunk);
+  } else {
+    for (std::size_t chunk = 0; chunk < n_chunks; ++chunk) {
+      find_actions_in_chunk(chunk);
+    }
+  }
+  random::engine = main_engine;
+  for (auto &found : chunk_actions) {
+    actions.insert(std::move(found));
+  }
+}
+
 template <typename Modus>
 void Experiment<Modus>::run_time_evolution_timestepless(Actions &actions) {
   const double start_time = parameters_.labclock->current_time();
@@ -1756,6 +2184,8 @@ void Experiment<Modus>::run_time_evolution_timestepless(Actions &actions) {
   logg[LExperiment].debug(
       "Timestepless propagation: ", "Actions size = ", actions.size(),
       ", start time = ", start_time, ", end time = ", end_time);
+  // Number of performed actions since the invalid ones were removed
+  ActionList::size_type performed_since_cleanup = 0;
 
   // iterate over all actions
   while (!actions.is_empty()) {
@@ -1781,10 +2211,15 @@ void Experiment<Modus>::run_time_evolution_timestepless(Actions &actions) {
       intermediate_output();
     }
 
-    /* (1) Propagate to the next action. */
+    /* (1) Propagate to the next action. In the lazy mode, only the incoming
+     * particles are moved, the others keep the time of their last update. */
     logg[LExperiment].debug("Propagating until next action ", act,
                             ", action time = ", act->time_of_execution());
-    propagate_and_shine(act->time_of_execution());
+    if (lazy_propagation_) {
+      propagate_lazily(act->incoming_particles(), act->time_of_execution());
+    } else {
+      propagate_and_shine(act->time_of_execution());
+    }
 
     /* (2) Perform action.
      *
@@ -1800,10 +2235,31 @@ void Experiment<Modus>::run_time_evolution_timestepless(Actions &actions) {
       continue;
     }
 
+    /* Every performed action invalidates the other actions of its incoming
+     * particles. Remove them from time to time, such that the queue does not
+     * fill up with them. The cost of a cleanup is linear in the size of the
+     * queue, so it is spread over a number of actions proportional to it. */
+    if (++performed_since_cleanup > actions.size() / 4) {
+      const auto removed = actions.remove_invalid(particles_);
+      logg[LExperiment].debug("Removed ", removed, " invalid actions.");
+      performed_since_cleanup = 0;
+    }
+
     /* (3) Update actions for newly-produced particles. */
 
     time_left = end_time - act->time_of_execution();
     const ParticleList &outgoing_particles = act->outgoing_particles();
+    /* The grid was updated at the beginning of the timestep, so the partners
+     * of the outgoing particles are found in the cells around them. The
+     * incoming particles are taken off the grid first, because their indices
+     * may be reused by the outgoing particles. */
+    if (grid_) {
+      for (const ParticleData &p : act->incoming_particles()) {
+        grid_->remove(p);
+      }
+    } else if (lazy_propagation_) {
+      propagate_and_shine(act->time_of_execution());
+    }
     // Cell volume set to zero, since there is no grid
     const double cell_vol = 0.0;
     for (const auto &finder : action_finders_) {
@@ -1811,8 +2267,28 @@ void Experiment<Modus>::run_time_evolution_timestepless(Actions &actions) {
       actions.insert(finder->find_actions_in_cell(outgoing_particles, time_left,
                                                   cell_vol, beam_momentum_));
       // ... and collide with other particles.
-      actions.insert(finder->find_actions_with_surrounding_particles(
-          outgoing_particles, particles_, time_left, beam_momentum_));
+      if (!grid_) {
+        actions.insert(finder->find_actions_with_surrounding_particles(
+            outgoing_particles, particles_, time_left, beam_momentum_));
+        continue;
+      }
+      for (const ParticleData &p : outgoing_particles) {
+        const ParticleListView search_list(&p, nullptr, 1);
+        grid_->iterate_neighborhood(
+            p, [&](const ParticleListView &neighbors_list) {
+              // The partners have to be at the time of the action, too.
+              if (lazy_propagation_) {
+                propagate_lazily(neighbors_list, act->time_of_execution());
+              }
+              actions.insert(finder->find_actions_with_neighbors(
+                  search_list, neighbors_list, time_left, beam_momentum_));
+            });
+      }
+    }
+    if (grid_) {
+      for (const ParticleData &p : outgoing_particles) {
+        grid_->insert(p, time_left);
+      }
     }
 
     check_interactions_total(interactions_total_);
@@ -2079,11 +2555,18 @@ void Experiment<Modus>::final_output(const int evt_num) {
       logg[LExperiment].info() << "Final interaction number: "
                                << interactions_total_ - wall_actions_total_;
     }
+    if (verlet_lists_) {
+      logg[LExperiment].info()
+          << "Verlet lists were built " << verlet_lists_->number_of_builds()
+          << " times in " << verlet_lists_->number_of_updates()
+          << " timesteps.";
+    }
 
     // Check if there are unformed particles
     int unformed_particles_count = 0;
-    for (const auto &particle : particles_) {
-      if (particle.formation_time() > end_time_) {
+    const ParticleColumns &columns = particles_.columns();
+    for (unsigned i = 0; i < columns.size; ++i) {
+      if (columns.is_particle(i) && columns.formation_time[i] > end_time_) {
         unformed_particles_count++;
       }
     }
@@ -2101,55 +2584,171 @@ void Experiment<Modus>::final_output(const int evt_num) {
 }
 
 template <typename Modus>
-void Experiment<Modus>::run() {
-  const auto &mainlog = logg[LMain];
-  for (int j = 0; j < nevents_; j++) {
-    mainlog.info() << "Event " << j;
-
-    // Sample initial particles, start clock, some printout and book-keeping
-    initialize_new_event();
-    /* In the ColliderModus, if the first collisions within the same nucleus are
-     * forbidden, 'nucleon_has_interacted_', which records whether a nucleon has
-     * collided with another nucleon, is initialized equal to false. If allowed,
-     * 'nucleon_has_interacted' is initialized equal to true, which means these
-     * incoming particles have experienced some fake scatterings, they can
-     * therefore collide with each other later on since these collisions are not
-     * "first" to them. */
-    if (modus_.is_collider()) {
-      if (!modus_.cll_in_nucleus()) {
-        nucleon_has_interacted_.assign(modus_.total_N_number(), false);
-      } else {
-        nucleon_has_interacted_.assign(modus_.total_N_number(), true);
-      }
+int64_t Experiment<Modus>::draw_seed() {
+  /* We have to be careful about the minimal integer, whose absolute value
+   * cannot be represented. */
+  int64_t r = random::advance();
+  while (r == INT64_MIN) {
+    r = random::advance();
+  }
+  return std::abs(r);
+}
+
+template <typename Modus>
+void Experiment<Modus>::run_event(int evt_num) {
+  logg[LMain].info() << "Event " << evt_num;
+
+  // Sample initial particles, start clock, some printout and book-keeping
+  initialize_new_event();
+  /* In the ColliderModus, if the first collisions within the same nucleus are
+   * forbidden, 'nucleon_has_interacted_', which records whether a nucleon has
+   * collided with another nucleon, is initialized equal to false. If allowed,
+   * 'nucleon_has_interacted' is initialized equal to true, which means these
+   * incoming particles have experienced some fake scatterings, they can
+   * therefore collide with each other later on since these collisions are not
+   * "first" to them. */
+  if (modus_.is_collider()) {
+    if (!modus_.cll_in_nucleus()) {
+      nucleon_has_interacted_.assign(modus_.total_N_number(), false);
+    } else {
+      nucleon_has_interacted_.assign(modus_.total_N_number(), true);
     }
-    /* In the ColliderModus, if Fermi motion is frozen, assign the beam momenta
-     * to the nucleons in both the projectile and the target. */
-    if (modus_.is_collider() && modus_.fermi_motion() == FermiMotion::Frozen) {
-      for (int i = 0; i < modus_.total_N_number(); i++) {
-        const auto mass_beam = particles_.copy_to_vector()[i].effective_mass();
-        const auto v_beam = i < modus_.proj_N_number()
-                                ? modus_.velocity_projectile()
-                                : modus_.velocity_target();
-        const auto gamma = 1.0 / std::sqrt(1.0 - v_beam * v_beam);
-        beam_momentum_.emplace_back(FourVector(gamma * mass_beam, 0.0, 0.0,
-                                               gamma * v_beam * mass_beam));
-      }
+  }
+  /* In the ColliderModus, if Fermi motion is frozen, assign the beam momenta
+   * to the nucleons in both the projectile and the target. */
+  if (modus_.is_collider() && modus_.fermi_motion() == FermiMotion::Frozen) {
+    for (int i = 0; i < modus_.total_N_number(); i++) {
+      const auto mass_beam = particles_.copy_to_vector()[i].effective_mass();
+      const auto v_beam = i < modus_.proj_N_number()
+                              ? modus_.velocity_projectile()
+                              : modus_.velocity_target();
+      const auto gamma = 1.0 / std::sqrt(1.0 - v_beam * v_beam);
+      beam_momentum_.emplace_back(FourVector(gamma * mass_beam, 0.0, 0.0,
+                                             gamma * v_beam * mass_beam));
     }
+  }
+
+  // Output at event start
+  for (const auto &output : outputs_) {
+    output->at_eventstart(particles_, evt_num);
+  }
+
+  run_time_evolution();
 
-    // Output at event start
+  if (force_decays_) {
+    do_final_decays();
+  }
+
+  // Output at event end
+  final_output(evt_num);
+}
+
+template <typename Modus>
+void Experiment<Modus>::run_events_in_parallel() {
+  logg[LMain].info() << "Running events with " << n_event_threads_
+                     << " threads.";
+  // The seeds of the events, derived from each other as in a sequential run
+  std::vector<int64_t> seeds(nevents_);
+  for (auto &seed : seeds) {
+    seed = seed_;
+    random::set_seed(seed_);
+    seed_ = draw_seed();
+  }
+
+  const auto create_buffers = [this]() {
+    OutputsList buffers;
     for (const auto &output : outputs_) {
-      output->at_eventstart(particles_, j);
+      buffers.emplace_back(make_unique<BufferedOutput>(*output));
     }
+    return buffers;
+  };
+  std::vector<std::unique_ptr<Experiment>> workers;
+  std::vector<Experiment *> idle_workers;
+  for (int i = 0; i < n_event_threads_; i++) {
+    workers.emplace_back(make_unique<Experiment>(
+        Configuration(event_worker_config_.c_str()), bf::path()));
+    workers.back()->outputs_ = create_buffers();
+    idle_workers.push_back(workers.back().get());
+  }
 
-    run_time_evolution();
-
-    if (force_decays_) {
-      do_final_decays();
+  std::mutex mutex;
+  // The buffered output of finished events that cannot be written yet
+  std::map<int, OutputsList> finished_events;
+  int next_event_to_write = 0;
+  /* Limits the memory of the buffered output. Events are started in order,
+   * so the event to be written next is always running and never has to
+   * wait. */
+  const std::size_t max_finished_events = 2 * n_event_threads_;
+  std::condition_variable event_written;
+  /* Whether an event failed, such that the following ones are neither run
+   * nor written */
+  bool failed = false;
+  ThreadPool pool(n_event_threads_);
+  pool.parallel_for(nevents_, [&](std::size_t j) {
+    const int evt_num = j;
+    Experiment *worker;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (failed) {
+        return;
+      }
+      worker = idle_workers.back();
+      idle_workers.pop_back();
     }
+    worker->seed_ = seeds[evt_num];
+    try {
+      worker->run_event(evt_num);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      idle_workers.push_back(worker);
+      failed = true;
+      event_written.notify_all();
+      throw;
+    }
+    OutputsList buffers = create_buffers();
+    std::swap(buffers, worker->outputs_);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    idle_workers.push_back(worker);
+    event_written.wait(lock, [&]() {
+      return failed || evt_num == next_event_to_write ||
+             finished_events.size() < max_finished_events;
+    });
+    if (failed) {
+      return;
+    }
+    finished_events[evt_num] = std::move(buffers);
+    try {
+      for (auto event = finished_events.find(next_event_to_write);
+           event != finished_events.end();
+           event = finished_events.find(++next_event_to_write)) {
+        for (std::size_t i = 0; i < outputs_.size(); i++) {
+          static_cast<BufferedOutput &>(*event->second[i])
+              .replay(*outputs_[i]);
+        }
+        finished_events.erase(event);
+      }
+    } catch (...) {
+      // The waiting threads would never see their event written otherwise.
+      failed = true;
+      event_written.notify_all();
+      throw;
+    }
+    event_written.notify_all();
+  });
+}
 
-    // Output at event end
-    final_output(j);
+template <typename Modus>
+void Experiment<Modus>::run() {
+  if (n_event_threads_ > 1) {
+    run_events_in_parallel();
+  } else {
+    for (int j = 0; j < nevents_; j++) {
+      run_event(j);
+    }
   }
+  logg[LExperiment].debug("Memory of actions and branches: ",
+                          Arena::statistics());
 }
 
 }  // namespace smash
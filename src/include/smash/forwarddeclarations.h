@@ -109,12 +109,36 @@ enum class Sampling {
   Custom,
 };
 
+/// Indentifies the strategy of determining the cell size of the Grid.
+enum class CellSizeStrategy : char {
+  /// Look for optimal cell size.
+  Optimal,
+
+  /**
+   * Make cells as large as possible.
+   *
+   * This means a single cell for normal boundary conditions and 8 cells
+   * for periodic boundary conditions.
+   */
+  Largest,
+
+  /**
+   * Like Optimal, but the number of cells is only limited in total and not
+   * per direction, such that the cells can be much smaller in some
+   * directions than in others. This suits strongly anisotropic systems like
+   * Lorentz-contracted nuclei.
+   */
+  Anisotropic
+};
+
 /// The time step mode.
 enum class TimeStepMode : char {
   /// Don't use time steps; propagate from action to action.
   None,
   /// Use fixed time step.
   Fixed,
+  /// Adapt the time step to the state of the system, see AdaptiveTimeStep.
+  Adaptive,
 };
 
 /**
@@ -196,6 +220,24 @@ enum class CollisionCriterion {
   Stochastic
 };
 
+/// How cross sections are obtained
+enum class CrossSectionMode {
+  /// (Default) compute them for each pair of particles.
+  Direct,
+  /// Interpolate them in lazily filled tables where possible.
+  Tabulated,
+  /// Compute them directly and compare with the tables.
+  Validated
+};
+
+/// How the cross sections of photon processes are computed
+enum class ComputationMethod {
+  /// (Default) evaluate the analytic formulas.
+  Analytic,
+  /// Interpolate in tables of the analytic formulas.
+  Lookup
+};
+
 /// Whether and when only final state particles should be printed.
 enum class OutputOnlyFinal {
   /// Print only final-state particles.
@@ -29,20 +29,6 @@ enum class GridOptions : char {
   PeriodicBoundaries = 1
 };
 
-/// Indentifies the strategy of determining the cell size.
-enum class CellSizeStrategy : char {
-  /// Look for optimal cell size.
-  Optimal,
-
-  /**
-   * Make cells as large as possible.
-   *
-   * This means a single cell for normal boundary conditions and 8 cells
-   * for periodic boundary conditions.
-   */
-  Largest
-};
-
 /**
  * Base class for Grid to host common functions that do not depend on the
  * GridOptions parameter.
@@ -72,6 +58,10 @@ class GridBase {
  * takes a list of ParticleData objects and sorts them in such a way that it is
  * easy to look only at lists of particles that have a chance of interacting.
  *
+ * The cells only store the indices of the particles in the Particles storage,
+ * which therefore has to outlive the grid and must not be modified between
+ * \ref update and \ref iterate_cells.
+ *
  * \tparam Options This policy parameter determines whether ghost cells are
  * created to support periodic boundaries, or not.
  */
@@ -132,16 +122,191 @@ class Grid : public GridBase {
    *                              be adjusted to wrap around the grid.
    */
   void iterate_cells(
-      const std::function<void(const ParticleList &)> &search_cell_callback,
-      const std::function<void(const ParticleList &, const ParticleList &)>
+      const std::function<void(const ParticleListView &)> &search_cell_callback,
+      const std::function<void(const ParticleListView &,
+                               const ParticleListView &)>
           &neighbor_cell_callback) const;
 
+  /**
+   * Calls the callback arguments for the search cell with the one-dimensional
+   * index \p cell_index and its neighbor cells, exactly like \ref
+   * iterate_cells does for that cell. Calling this function for all cell
+   * indices in increasing order is equivalent to \ref iterate_cells, and
+   * different cells can be processed concurrently.
+   *
+   * \param[in] cell_index The index of the search cell, in [0, \ref
+   *                       cell_count()).
+   * \param[in] search_cell_callback See \ref iterate_cells.
+   * \param[in] neighbor_cell_callback See \ref iterate_cells.
+   */
+  void iterate_cell(
+      SizeType cell_index,
+      const std::function<void(const ParticleListView &)> &search_cell_callback,
+      const std::function<void(const ParticleListView &,
+                               const ParticleListView &)>
+          &neighbor_cell_callback) const;
+
+  /// \return the total number of cells
+  SizeType cell_count() const { return cells_.size(); }
+
+  /**
+   * Updates the grid to the current state of \p particles, reusing the cell
+   * storage of the previous timestep.
+   *
+   * Only particles whose cell index changed are moved between cells, particles
+   * which were removed from (or added to) \p particles since the last update
+   * are removed from (added to) the grid. The grid layout is only recomputed
+   * (see \ref rebuild) if
+   * - a particle left the bounding box of a grid with normal boundaries,
+   * - \p min_cell_length became larger than the cell length the layout was
+   *   built for, or much smaller than that,
+   * - the number of particles changed by more than a factor of two, which
+   *   changes the maximal number of cells.
+   *
+   * \param[in] particles The particles to place onto the grid.
+   * \param[in] min_cell_length The minimal length a cell must have.
+   * \param[in] timestep_duration Duration of the timestep in fm/c.
+   */
+  void update(const Particles &particles, double min_cell_length,
+              double timestep_duration);
+
+  /**
+   * Calls \p callback with the non-empty cells around the current position of
+   * \p p: the cell containing it and its direct neighbors. Positions outside of
+   * the grid are moved to the closest cell, and the neighbors are not wrapped
+   * around periodic boundaries.
+   *
+   * Like for the search cells, this finds all partners that can interact with
+   * \p p until the end of the time step the cell size was chosen for, as long
+   * as the grid was updated at its beginning and kept up to date with \ref
+   * insert and \ref remove.
+   *
+   * \param[in] p The particle whose neighborhood is searched.
+   * \param[in] callback A callable called with every non-empty cell.
+   */
+  void iterate_neighborhood(
+      const ParticleData &p,
+      const std::function<void(const ParticleListView &)> &callback) const;
+
+  /**
+   * Adds a particle that was created since the last \ref update to the cell
+   * of its current position, unless it cannot interact within \p
+   * timestep_duration.
+   *
+   * \param[in] p The particle, which has to be in the Particles storage.
+   * \param[in] timestep_duration Remaining duration of the timestep in fm/c.
+   */
+  void insert(const ParticleData &p, double timestep_duration);
+
+  /**
+   * Removes the particle stored at the index of \p p from its cell. This has
+   * to be done before the index is reused for another particle.
+   *
+   * \param[in] p The particle, which may already be gone from the Particles
+   *              storage.
+   */
+  void remove(const ParticleData &p);
+
   /**
    * \return the volume of a single grid cell
    */
   double cell_volume() const { return cell_volume_; }
 
+  /// \return the largest number of particles in a single cell.
+  std::size_t max_cell_occupancy() const;
+
+  /// \return how often the grid layout was recomputed by \ref update.
+  std::size_t number_of_rebuilds() const { return number_of_rebuilds_; }
+
+  /**
+   * \return whether \p p is put into the grid. Particles that cannot interact
+   * within the next \p timestep_duration (because they are not formed yet) are
+   * left out, except for the single cell of the CellSizeStrategy::Largest
+   * strategy with normal boundaries.
+   */
+  bool is_on_grid(const ParticleData &p, double timestep_duration) const {
+    return (Options == GridOptions::Normal &&
+            strategy_ == CellSizeStrategy::Largest) ||
+           p.xsec_scaling_factor(timestep_duration) > 0.0;
+  }
+
  private:
+  /**
+   * Where the index of a particle is stored in the grid. The locations are
+   * indexed with the index of the particle in the Particles storage.
+   */
+  struct CellLocation {
+    /// Index of the cell, -1 if the particle is not on the grid.
+    SizeType cell = -1;
+    /// Position of the index inside the cell.
+    SizeType entry = 0;
+    /// Value of update_count_ when the particle was last seen.
+    std::size_t seen_in_update = 0;
+  };
+
+  /**
+   * Implements \ref iterate_cell for the search cell with the 3-dim index
+   * \p search_index.
+   *
+   * \param[in] search_index The index of the search cell.
+   * \param[in] search_cell_callback See \ref iterate_cells.
+   * \param[in] neighbor_cell_callback See \ref iterate_cells.
+   * \param[out] translated Buffer for the copy of the search cell that is
+   *            translated for periodic boundaries.
+   */
+  void iterate_cell(
+      const std::array<SizeType, 3> &search_index,
+      const std::function<void(const ParticleListView &)> &search_cell_callback,
+      const std::function<void(const ParticleListView &,
+                               const ParticleListView &)>
+          &neighbor_cell_callback,
+      ParticleList &translated) const;
+
+  /**
+   * Determines the grid layout from the current bounding box and places all
+   * particles into their cells.
+   *
+   * \param[in] particles The particles to place onto the grid.
+   * \param[in] min_cell_length The minimal length a cell must have.
+   * \param[in] timestep_duration Duration of the timestep in fm/c.
+   * \throws runtime_error if your box length is smaller than the grid length.
+   */
+  void build(const Particles &particles, double min_cell_length,
+             double timestep_duration);
+
+  /**
+   * Recomputes the bounding box (for normal boundaries), with a margin of
+   * \ref box_margin_ on each side so that the following timesteps do not
+   * trigger another rebuild, and then calls \ref build.
+   *
+   * \param[in] particles The particles to place onto the grid.
+   * \param[in] min_cell_length The minimal length a cell must have.
+   * \param[in] timestep_duration Duration of the timestep in fm/c.
+   */
+  void rebuild(const Particles &particles, double min_cell_length,
+               double timestep_duration);
+
+  /**
+   * \return the one-dimensional cell-index for the particle \p p or -1 if \p p
+   * is outside the bounding box of a grid with normal boundaries.
+   */
+  SizeType cell_index_for(const ParticleData &p) const;
+
+  /**
+   * \return the 3-dim cell index for the particle \p p, moved to the closest
+   * cell if \p p is outside of the grid.
+   */
+  std::array<SizeType, 3> clamped_index_for(const ParticleData &p) const;
+
+  /// Adds the particle \p p to the cell with index \p cell.
+  void add_to_cell(const ParticleData &p, SizeType cell);
+
+  /**
+   * Removes the index at \p location from its cell. The last entry of the cell
+   * is moved into the freed position.
+   */
+  void remove_from_cell(CellLocation &location);
+
   /**
    * \return the one-dimensional cell-index from the 3-dim index \p x, \p y, \p
    * z.
@@ -156,8 +321,33 @@ class Grid : public GridBase {
     return make_index(idx[0], idx[1], idx[2]);
   }
 
+  /**
+   * Relative margin added on each side of the bounding box when the layout is
+   * recomputed by \ref update.
+   */
+  static constexpr double box_margin_ = 0.1;
+
+  /// The minimal coordinates of the grid.
+  std::array<double, 3> min_position_;
+
   /// The 3 lengths of the complete grid. Used for periodic boundary wrapping.
-  const std::array<double, 3> length_;
+  std::array<double, 3> length_;
+
+  /**
+   * Factor to convert a distance to min_position_ into a cell index. This
+   * normally equals 1/min_cell_length, but is smaller if the number of cells
+   * is reduced. It is zero in directions with a single cell.
+   */
+  std::array<double, 3> index_factor_;
+
+  /// The strategy for determining the cell size.
+  const CellSizeStrategy strategy_;
+
+  /// The minimal cell length the layout was built for.
+  double min_cell_length_;
+
+  /// The number of particles the layout was built for.
+  std::size_t particle_count_;
 
   /// The volume of a single cell.
   double cell_volume_;
@@ -165,8 +355,20 @@ class Grid : public GridBase {
   /// The number of cells in x, y, and z direction.
   std::array<int, 3> number_of_cells_;
 
-  /// The cell storage.
-  std::vector<ParticleList> cells_;
+  /// The particles on the grid.
+  const Particles *particles_;
+
+  /// The cell storage, holding indices into the storage of particles_.
+  std::vector<std::vector<unsigned>> cells_;
+
+  /// The cell locations of the particles, indexed like the Particles storage.
+  std::vector<CellLocation> locations_;
+
+  /// The number of calls to \ref update.
+  std::size_t update_count_ = 0;
+
+  /// The number of layout recomputations in \ref update.
+  std::size_t number_of_rebuilds_ = 0;
 };
 
 }  // namespace smash
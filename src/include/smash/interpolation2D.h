@@ -10,34 +10,44 @@
 #ifndef SRC_INCLUDE_INTERPOLATION2D_H_
 #define SRC_INCLUDE_INTERPOLATION2D_H_
 
-#include <gsl/gsl_spline2d.h>
-
+#include <array>
+#include <cstddef>
 #include <vector>
 
 namespace smash {
 
-/// Represent a bicubic spline interpolation.
+/**
+ * Represent a bicubic spline interpolation.
+ *
+ * The derivatives at the nodes are taken from natural cubic splines along
+ * the grid lines, as done by gsl_interp2d_bicubic, so the results agree with
+ * the GSL implementation. In contrast to GSL, the polynomial coefficients of
+ * all cells are computed once in the constructor and no lookup state is
+ * kept, so evaluation is cheap and const objects can be shared between
+ * threads.
+ */
 class InterpolateData2DSpline {
  public:
   /**
-   * Interpolate function f given discrete samples f(x_i, y_i) = z_i.
+   * Interpolate function f given discrete samples f(x_i, y_j) = z_k.
    *
-   * \param x x-values.
-   * \param y y-values.
-   * \param z z-values
+   * \param x x-values, strictly increasing.
+   * \param y y-values, strictly increasing.
+   * \param z z-values, with index k = j * DIM(x) + i.
    * \return The interpolation function.
    *
    * A bicubic spline interpolation is used.
    * Values outside the given samples will use the outmost sample
    * as a constant extrapolation.
+   *
+   * \throw std::runtime_error if the dimensions do not fit, if there are
+   *        fewer than 4 points in one of the dimensions or if x or y are not
+   *        strictly increasing.
    */
   InterpolateData2DSpline(const std::vector<double>& x,
                           const std::vector<double>& y,
                           const std::vector<double>& z);
 
-  /// Destructor
-  ~InterpolateData2DSpline();
-
   /**
    * Calculate bicubic interpolation for given x and y.
    *
@@ -47,22 +57,88 @@ class InterpolateData2DSpline {
    */
   double operator()(double xi, double yi) const;
 
+  /**
+   * Calculate bicubic interpolation for several x and the same y.
+   * The cell in y direction is only looked up once.
+   *
+   *  \param[in] xi Interpolation arguments in first dimension.
+   *  \param[in] yi Interpolation argument in second dimension.
+   *  \param[out] result Interpolated values, resized to the size of xi.
+   */
+  void operator()(const std::vector<double>& xi, double yi,
+                  std::vector<double>& result) const;
+
  private:
-  /// First x value.
-  double first_x_;
-  /// Last x value.
-  double last_x_;
-  /// First y value.
-  double first_y_;
-  /// Last y value.
-  double last_y_;
-
-  /// GSL iterator for interpolation lookups in x direction.
-  gsl_interp_accel* xacc_;
-  /// GSL iterator for interpolation lookupin y direction.
-  gsl_interp_accel* yacc_;
-  /// GSL spline in 2D.
-  gsl_spline2d* spline_;
+  /**
+   * Nodes in one dimension together with a fast lookup of the cell
+   * containing a given value.
+   *
+   * For (approximately) uniform and logarithmically uniform nodes the cell
+   * is computed from the spacing and then corrected by at most one against
+   * the actual nodes, which takes care of rounded tabulated nodes. Other
+   * nodes are searched by bisection.
+   */
+  class Grid {
+   public:
+    /**
+     * Analyze the spacing of the nodes.
+     *
+     * \param nodes Strictly increasing nodes.
+     */
+    explicit Grid(const std::vector<double>& nodes);
+
+    /// \return Number of nodes.
+    std::size_t size() const { return nodes_.size(); }
+
+    /**
+     * \param v Value to be looked up.
+     * \return v limited to the range of the nodes.
+     */
+    double clamp(double v) const;
+
+    /**
+     * Find the cell i with nodes[i] <= v <= nodes[i + 1].
+     *
+     * \param v Value within the range of the nodes.
+     * \return Index of the cell.
+     */
+    std::size_t cell(double v) const;
+
+    /**
+     * \param v Value within the range of the nodes.
+     * \param i Index of the cell containing v.
+     * \return Relative position of v in cell i, between 0 and 1.
+     */
+    double position(double v, std::size_t i) const {
+      return (v - nodes_[i]) * inverse_widths_[i];
+    }
+
+    /// Nodes.
+    const std::vector<double> nodes_;
+
+   private:
+    /// How the nodes are spaced.
+    enum class Spacing { Uniform, LogUniform, Irregular };
+    /// Spacing of the nodes.
+    Spacing spacing_;
+    /// First node, or its logarithm for log-uniform nodes.
+    double origin_;
+    /// Inverse of the (logarithmic) distance of the nodes.
+    double inverse_step_;
+    /// Inverse widths of the cells.
+    std::vector<double> inverse_widths_;
+  };
+
+  /// Nodes in x direction.
+  const Grid x_;
+  /// Nodes in y direction.
+  const Grid y_;
+  /**
+   * Polynomial coefficients of each cell, with cell index
+   * iy * (DIM(x) - 1) + ix. Within a cell, the value at relative position
+   * (t, u) is sum_{m,n} c[4 * m + n] t^m u^n.
+   */
+  std::vector<std::array<double, 16>> coefficients_;
 };
 
 }  // namespace smash
@@ -103,7 +103,7 @@ const std::initializer_list<double> KMINUSP_ELASTIC_SIG = {
     2.5400, 2.5300, 2.5100, 2.5200, 2.7400, 2.5900};
 
 /// An interpolation that gets lazily filled using the KMINUSP_ELASTIC data.
-static std::unique_ptr<InterpolateDataLinear<double>>
+static thread_local std::unique_ptr<InterpolateDataLinear<double>>
     kminusp_elastic_interpolation = nullptr;
 
 /// PDG data on K- p total cross section: momentum in lab frame.
@@ -240,7 +240,7 @@ const std::initializer_list<double> KMINUSP_RES_SIG = {
     0.39627220898,  0.57172926654, 0.51129452389,  0.44626386026};
 
 /// An interpolation that gets lazily filled using the KMINUSP_RES data.
-static std::unique_ptr<InterpolateDataSpline>
+static thread_local std::unique_ptr<InterpolateDataSpline>
     kminusp_elastic_res_interpolation = nullptr;
 
 /**
@@ -284,7 +284,7 @@ const std::initializer_list<double> KPLUSN_TOT_SIG = {
     19.63, 19.55, 19.74, 19.72, 19.82, 20.37, 20.61, 20.80};
 
 /// An interpolation that gets lazily filled using the KPLUSN_TOT data.
-static std::unique_ptr<InterpolateDataLinear<double>>
+static thread_local std::unique_ptr<InterpolateDataLinear<double>>
     kplusn_total_interpolation = nullptr;
 
 /// PDG data on K+ p total cross section: momentum in lab frame.
@@ -339,7 +339,7 @@ const std::initializer_list<double> KPLUSP_TOT_SIG = {
     19.52, 19.36, 19.33, 19.64, 18.20, 19.91, 19.84, 20.22, 20.45, 20.67};
 
 /// An interpolation that gets lazily filled using the KPLUSP_TOT data.
-static std::unique_ptr<InterpolateDataLinear<double>>
+static thread_local std::unique_ptr<InterpolateDataLinear<double>>
     kplusp_total_interpolation = nullptr;
 
 /// PDG data on pi- p elastic cross section: momentum in lab frame.
@@ -380,7 +380,7 @@ const std::initializer_list<double> PIMINUSP_ELASTIC_SIG = {
     7.57,   6.1};
 
 /// An interpolation that gets lazily filled using the PIMINUSP_ELASTIC data.
-static std::unique_ptr<InterpolateDataLinear<double>>
+static thread_local std::unique_ptr<InterpolateDataLinear<double>>
     piminusp_elastic_interpolation = nullptr;
 
 /// PDG data on pi- p to Lambda K0 cross section: momentum in lab frame.
@@ -411,7 +411,7 @@ const std::initializer_list<double> PIMINUSP_LAMBDAK0_SIG = {
     0.058, 0.0644, 0.049, 0.054, 0.038, 0.0221, 0.0157};
 
 /// An interpolation that gets lazily filled using the PIMINUSP_LAMBDAK0 data.
-static std::unique_ptr<InterpolateDataLinear<double>>
+static thread_local std::unique_ptr<InterpolateDataLinear<double>>
     piminusp_lambdak0_interpolation = nullptr;
 
 /// PDG data on pi- p to Sigma- K+ cross section: momentum in lab frame
@@ -432,7 +432,7 @@ const std::initializer_list<double> PIMINUSP_SIGMAMINUSKPLUS_SIG = {
  * An interpolation that gets lazily filled using the
  * PIMINUSP_SIGMAMINUSKPLUS data.
  */
-static std::unique_ptr<InterpolateDataLinear<double>>
+static thread_local std::unique_ptr<InterpolateDataLinear<double>>
     piminusp_sigmaminuskplus_interpolation = nullptr;
 
 /// pi- p to Sigma0 K0 cross section: square root s
@@ -478,7 +478,7 @@ const std::initializer_list<double> PIMINUSP_SIGMA0K0_RES_SIG = {
  * An interpolation that gets lazily filled using the
  * PIMINUSP_SIGMA0K0_RES data.
  */
-static std::unique_ptr<InterpolateDataLinear<double>>
+static thread_local std::unique_ptr<InterpolateDataLinear<double>>
     piminusp_sigma0k0_interpolation = nullptr;
 
 /// Center-of-mass energy.
@@ -629,7 +629,7 @@ const std::initializer_list<double> PIMINUSP_RES_SIG = {
     0.027723,  0.022456,  0.017122,  0.016299,  0.014606};
 
 /// An interpolation that gets lazily filled using the PIMINUSP_RES data.
-static std::unique_ptr<InterpolateDataSpline>
+static thread_local std::unique_ptr<InterpolateDataSpline>
     piminusp_elastic_res_interpolation = nullptr;
 
 /// PDG data on pi+ p elastic cross section: momentum in lab frame.
@@ -668,7 +668,7 @@ const std::initializer_list<double> PIPLUSP_ELASTIC_SIG = {
     3.1,   3.35,  3.3,   3.39,  3.24,  3.37,  3.17,  3.3};
 
 /// An interpolation that gets lazily filled using the PIPLUSP_ELASTIC_SIG data.
-static std::unique_ptr<InterpolateDataLinear<double>>
+static thread_local std::unique_ptr<InterpolateDataLinear<double>>
     piplusp_elastic_interpolation = nullptr;
 
 /// PDG data on pi+ p to Sigma+ K+ cross section: momentum in lab frame.
@@ -694,7 +694,7 @@ const std::initializer_list<double> PIPLUSP_SIGMAPLUSKPLUS_SIG = {
  * An interpolation that gets lazily filled using the
  * PIPLUSP_SIGMAPLUSKPLUS_SIG data.
  */
-static std::unique_ptr<InterpolateDataLinear<double>>
+static thread_local std::unique_ptr<InterpolateDataLinear<double>>
     piplusp_sigmapluskplus_interpolation = nullptr;
 
 /// Center-of-mass energy.
@@ -815,7 +815,7 @@ const std::initializer_list<double> PIPLUSP_RES_SIG = {
     0.079356,   0.042881,   0.041067,   0.026625,   0.026107};
 
 /// A null interpolation that gets filled using the PIPLUSP_RES data
-static std::unique_ptr<InterpolateDataSpline>
+static thread_local std::unique_ptr<InterpolateDataSpline>
     piplusp_elastic_res_interpolation = nullptr;
 }  // namespace smash
 
@@ -74,6 +74,13 @@ class ParticleData {
    */
   void set_id(int i) { id_ = i; }
 
+  /**
+   * Get the index of the particle in the Particles storage
+   * \return index of the particle (only meaningful for copies obtained from
+   *         Particles)
+   */
+  unsigned index() const { return index_; }
+
   /**
    * Get the pdgcode of the particle
    * \return pdgcode of the particle
@@ -105,6 +112,17 @@ class ParticleData {
    * \return Effective mass [GeV]
    */
   double effective_mass() const;
+  /**
+   * Get the total width of the hadronic decays at the invariant mass of the
+   * momentum, see ParticleType::total_width(double, WhichDecaymodes). It is
+   * cached for the last mass, so it is only computed again when the mass
+   * changes. This is only the width of get_partial_widths if
+   * ParticleType::potentials_affect_decays is false. Since the cache is
+   * modified, this must not be called concurrently for the same particle.
+   *
+   * \return total hadronic width [GeV]
+   */
+  double hadronic_width() const;
   /**
    * Get the type of the particle
    * \return ParticleType object associated to this particle.
@@ -375,7 +393,8 @@ class ParticleData {
   /**
    * Copies some information of the particle to the given particle \p dst.
    *
-   * Specifically it avoids to copy id_, index_, and type_.
+   * Specifically it avoids to copy id_, index_, generation_, and type_. The
+   * cached hadronic width is copied, so \p dst has to be of the same type.
    * \param[in] dst particle values are copied to
    */
   void copy_to(ParticleData &dst) const {
@@ -385,6 +404,8 @@ class ParticleData {
     dst.formation_time_ = formation_time_;
     dst.initial_xsec_scaling_factor_ = initial_xsec_scaling_factor_;
     dst.begin_formation_time_ = begin_formation_time_;
+    dst.hadronic_width_mass_ = hadronic_width_mass_;
+    dst.hadronic_width_ = hadronic_width_;
   }
 
   /**
@@ -407,6 +428,17 @@ class ParticleData {
    */
   unsigned index_ = std::numeric_limits<unsigned>::max();
 
+  /**
+   * Generation of the entry in the \ref Particles list at the time this copy
+   * was taken. It changes whenever the particle at index_ is removed,
+   * replaced or takes part in an interaction.
+   *
+   * The value is read and written from the Particles class.
+   *
+   * \see Particles::generations_
+   */
+  uint32_t generation_ = 0;
+
   /**
    * A reference to the ParticleType object for this particle (this contains
    * all the static information). Default-initialized with an invalid index.
@@ -444,6 +476,13 @@ class ParticleData {
   double initial_xsec_scaling_factor_ = 1.0;
   /// history information
   HistoryData history_;
+  /**
+   * Mass at which hadronic_width_ was computed, negative if it was not
+   * computed yet [GeV]
+   */
+  mutable double hadronic_width_mass_ = -1.;
+  /// Cached total width of the hadronic decays, see hadronic_width() [GeV]
+  mutable double hadronic_width_ = 0.;
 };
 
 /**
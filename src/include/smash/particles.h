@@ -7,6 +7,9 @@
 #ifndef SRC_INCLUDE_PARTICLES_H_
 #define SRC_INCLUDE_PARTICLES_H_
 
+#include <cassert>
+#include <cmath>
+#include <iterator>
 #include <memory>
 #include <type_traits>
 #include <vector>
@@ -18,13 +21,248 @@
 
 namespace smash {
 
+/**
+ * \ingroup data
+ *
+ * A lightweight, non-owning view of a list of particles.
+ *
+ * The view either refers to a contiguous array of ParticleData objects (e.g. a
+ * ParticleList) or to a list of indices into the storage of a Particles object
+ * (see Particles::view). The latter allows to pass the particles of a grid cell
+ * to the action finders without copying them.
+ *
+ * \note The view is only valid as long as the referenced storage is neither
+ * modified nor destroyed.
+ */
+class ParticleListView {
+ public:
+  /// Iterator over the ParticleData objects in the view.
+  class const_iterator
+      : public std::iterator<std::forward_iterator_tag, const ParticleData> {
+   public:
+    /**
+     * Constructs an iterator.
+     *
+     * \param[in] data Pointer to the current particle if \p index is null,
+     *                 otherwise pointer to the referenced storage.
+     * \param[in] index Pointer to the current index into \p data or null.
+     */
+    const_iterator(const ParticleData *data, const unsigned *index)
+        : data_(data), index_(index) {}
+    /// \return the current particle
+    const ParticleData &operator*() const {
+      return index_ ? data_[*index_] : *data_;
+    }
+    /// \return a pointer to the current particle
+    const ParticleData *operator->() const { return &operator*(); }
+    /// Advances the iterator to the next particle.
+    const_iterator &operator++() {
+      if (index_) {
+        ++index_;
+      } else {
+        ++data_;
+      }
+      return *this;
+    }
+    /// Advances the iterator to the next particle (postfix).
+    const_iterator operator++(int) {
+      const_iterator old = *this;
+      operator++();
+      return old;
+    }
+    /// \return whether two iterators point to the same particle
+    bool operator==(const const_iterator &rhs) const {
+      return data_ == rhs.data_ && index_ == rhs.index_;
+    }
+    /// \return whether two iterators point to different particles
+    bool operator!=(const const_iterator &rhs) const {
+      return !operator==(rhs);
+    }
+
+   private:
+    /// The current particle or the referenced storage.
+    const ParticleData *data_;
+    /// The current index into data_, or null for contiguous views.
+    const unsigned *index_;
+  };
+
+  /// Constructs a view of all particles in \p list.
+  ParticleListView(const ParticleList &list)  // NOLINT(runtime/explicit)
+      : data_(list.data()), indices_(nullptr), size_(list.size()) {}
+
+  /**
+   * Constructs a view of the particles in \p data selected by \p indices.
+   *
+   * \param[in] data The referenced particle storage.
+   * \param[in] indices Indices of the particles in \p data. If this is null,
+   *                    the view refers to the first \p size particles in
+   *                    \p data.
+   * \param[in] size The number of particles in the view.
+   */
+  ParticleListView(const ParticleData *data, const unsigned *indices,
+                   std::size_t size)
+      : data_(data), indices_(indices), size_(size) {}
+
+  /// \return the number of particles in the view
+  std::size_t size() const { return size_; }
+
+  /// \return whether the view is empty
+  bool empty() const { return size_ == 0; }
+
+  /// \return the \p i-th particle of the view
+  const ParticleData &operator[](std::size_t i) const {
+    assert(i < size_);
+    return indices_ ? data_[indices_[i]] : data_[i];
+  }
+
+  /// \return an iterator to the first particle
+  const_iterator begin() const { return {data_, indices_}; }
+
+  /// \return an iterator past the last particle
+  const_iterator end() const {
+    return indices_ ? const_iterator{data_, indices_ + size_}
+                    : const_iterator{data_ + size_, nullptr};
+  }
+
+  /// \return a copy of the viewed particles as a ParticleList
+  ParticleList copy_to_vector() const { return {begin(), end()}; }
+
+ private:
+  /// The referenced particle storage.
+  const ParticleData *data_;
+  /// Indices into data_, or null for contiguous views.
+  const unsigned *indices_;
+  /// The number of particles in the view.
+  std::size_t size_;
+};
+
+/**
+ * \ingroup data
+ *
+ * The fields of the particles in a Particles object that are used in the bulk
+ * loops over all particles (e.g. propagation, densities on the lattice and
+ * the conservation check), stored as a structure of arrays.
+ *
+ * The columns are the primary storage of positions and momenta. The bulk
+ * loops read and modify only the columns and never touch the rarely used
+ * fields like the history and the process ids, which are only stored in the
+ * ParticleData records of Particles. The records get the current positions
+ * and momenta from the columns when they are accessed next, see
+ * Particles::sync_records.
+ *
+ * Entry \c i of every column belongs to the entry \c i of the storage of
+ * Particles, i.e. the particle with ParticleData::index \c i. Holes in the
+ * storage are marked by an invalid type.
+ *
+ * \see Particles::columns, Particles::update_columns
+ */
+struct ParticleColumns {
+  /// Number of entries, including the holes.
+  unsigned size = 0;
+  /// Time components of the positions [fm]
+  std::vector<double> t;
+  /// x components of the positions [fm]
+  std::vector<double> x;
+  /// y components of the positions [fm]
+  std::vector<double> y;
+  /// z components of the positions [fm]
+  std::vector<double> z;
+  /// Energies [GeV]
+  std::vector<double> e;
+  /// x components of the momenta [GeV]
+  std::vector<double> px;
+  /// y components of the momenta [GeV]
+  std::vector<double> py;
+  /// z components of the momenta [GeV]
+  std::vector<double> pz;
+  /**
+   * Effective masses [GeV], see ParticleData::effective_mass. They are NaN
+   * for massive particles with a spacelike momentum.
+   */
+  std::vector<double> effective_mass;
+  /// Types, invalid for the holes
+  std::vector<ParticleTypePtr> type;
+  /// Ids of the particles
+  std::vector<int32_t> id;
+  /// Formation times [fm]
+  std::vector<double> formation_time;
+  /// Times when the formation starts [fm]
+  std::vector<double> begin_formation_time;
+
+  /// \return whether entry \p i holds a particle.
+  bool is_particle(unsigned i) const { return static_cast<bool>(type[i]); }
+  /// \return the position of the particle in entry \p i.
+  FourVector position(unsigned i) const { return {t[i], x[i], y[i], z[i]}; }
+  /// \return the momentum of the particle in entry \p i.
+  FourVector momentum(unsigned i) const {
+    return {e[i], px[i], py[i], pz[i]};
+  }
+
+  /**
+   * Resize all columns, keeping the existing entries.
+   *
+   * \param[in] capacity New number of entries in every column.
+   */
+  void resize(unsigned capacity);
+  /**
+   * Copy the fields of a particle into entry \p i.
+   *
+   * \param[in] i The entry.
+   * \param[in] p The particle.
+   */
+  void set(unsigned i, const ParticleData &p);
+  /**
+   * Set the position of the particle in entry \p i.
+   *
+   * \param[in] i The entry.
+   * \param[in] r The new position.
+   */
+  void set_position(unsigned i, const FourVector &r) {
+    t[i] = r.x0();
+    x[i] = r.x1();
+    y[i] = r.x2();
+    z[i] = r.x3();
+  }
+  /**
+   * Set the momentum of the particle in entry \p i, which also updates its
+   * effective mass.
+   *
+   * \param[in] i The entry.
+   * \param[in] mom The new momentum.
+   */
+  void set_momentum(unsigned i, const FourVector &mom);
+  /**
+   * Set the momentum of the particle in entry \p i from its mass and
+   * three-momentum, like ParticleData::set_4momentum.
+   *
+   * \param[in] i The entry.
+   * \param[in] mass The mass of the particle.
+   * \param[in] mom The three-momentum.
+   */
+  void set_momentum(unsigned i, double mass, const ThreeVector &mom) {
+    set_momentum(i, FourVector(std::sqrt(mass * mass + mom * mom), mom));
+  }
+  /// Mark entry \p i as a hole.
+  void set_hole(unsigned i) { type[i] = ParticleTypePtr(); }
+};
+
 /**
  * \ingroup data
  *
  * The Particles class abstracts the storage and manipulation of particles.
  *
  * There is one Particles object per Experiment. It stores
- * the data about all existing particles in the experiment (ParticleData).
+ * the data about all existing particles in the experiment. The frequently
+ * used fields are stored in ParticleColumns, the complete particles in
+ * ParticleData records, which are handed out by the accessors. The records
+ * take over the positions and momenta from the columns when the columns were
+ * modified (see update_columns and sync_records).
+ *
+ * Bulk modifications of the positions and momenta should use update_columns.
+ * The ParticleData records can still be modified through the non-const
+ * iterators, front(), back() and create(PdgCode). These mark the entries
+ * they hand out, whose fields are copied into the columns on the next call
+ * of columns().
  *
  * \note
  * The Particles object cannot be copied, because it does not make sense
@@ -42,12 +280,26 @@ class Particles {
 
   /// \return a copy of all particles as a std::vector<ParticleData>.
   ParticleList copy_to_vector() const {
+    sync_records();
     if (dirty_.empty()) {
       return {&data_[0], &data_[data_size_]};
     }
     return {begin(), end()};
   }
 
+  /**
+   * \return a view of the particles at the given indices, without copying
+   * them.
+   *
+   * \param[in] indices Indices into the internal storage (see
+   *            ParticleData::index). They must refer to existing particles and
+   *            must outlive the view.
+   */
+  ParticleListView view(const std::vector<unsigned> &indices) const {
+    sync_records();
+    return {&data_[0], indices.data(), indices.size()};
+  }
+
   /**
    * Inserts the particle \p into the list of particles.
    * The argument \p will afterwards not be a valid copy of a particle of the
@@ -79,7 +331,9 @@ class Particles {
    * Add one particle of the given \p pdg code
    *
    * \param[in] pdg PDG code of the added particle
-   * \return a reference to the added particle
+   * \return a reference to the added particle. Changes made through it are
+   *         taken over into the columns on the next call of columns(), so it
+   *         must not be used after that.
    */
   ParticleData &create(const PdgCode pdg);
 
@@ -108,6 +362,18 @@ class Particles {
    */
   void reset();
 
+  /**
+   * Replaces the content of this object by an exact copy of \p other,
+   * including the particle ids, the id counter and the positions of the
+   * particles in the internal storage.
+   *
+   * This is an explicit function instead of a copy constructor, because
+   * copying all particles is expensive and only rarely needed.
+   *
+   * \param[in] other The particles to be copied.
+   */
+  void copy_from(const Particles &other);
+
   /**
    * Check whether the ParticleData copy is still a valid copy of the one
    * stored in the Particles object.
@@ -121,13 +387,13 @@ class Particles {
     if (data_size_ <= copy.index_) {
       return false;
     }
-    /* Check if the particles still exists. If it decayed
-     * or scattered inelastically it is gone. */
-    return data_[copy.index_].id() == copy.id()
-           /* If the particle has scattered
-            * elastically, its id_process has
-            * changed and we consider it invalid. */
-           && data_[copy.index_].id_process() == copy.id_process();
+    /* The generation of the entry changes if the particle decayed or
+     * scattered inelastically, such that it is gone, and also if it
+     * scattered elastically, such that its id_process changed. */
+    assert(generations_[copy.index_] != copy.generation_ ||
+           (data_[copy.index_].id() == copy.id() &&
+            data_[copy.index_].id_process() == copy.id_process()));
+    return generations_[copy.index_] == copy.generation_;
   }
 
   /**
@@ -162,7 +428,8 @@ class Particles {
    * subsequently returned.
    *
    * The state update copies the id_process, momentum, and position from \p
-   * new_state.
+   * new_state. If the id_process changes, copies of the old state are not
+   * valid anymore.
    *
    * This function expects \p p to be a valid copy (i.e. is_valid returns \c
    * true) and it expects the ParticleType of \p p and \p new_state to be
@@ -177,7 +444,11 @@ class Particles {
     assert(is_valid(p));
     assert(p.type() == new_state.type());
     ParticleData &original = data_[p.index_];
+    if (original.id_process() != new_state.id_process()) {
+      next_generation(original);
+    }
     new_state.copy_to(original);
+    columns_.set(original.index_, original);
     return original;
   }
 
@@ -221,9 +492,125 @@ class Particles {
    */
   const ParticleData &lookup(const ParticleData &old_state) const {
     assert(is_valid(old_state));
+    sync_records();
     return data_[old_state.index_];
   }
 
+  /**
+   * \return the particle in entry \p index of the internal storage, which has
+   * to hold a particle (see ParticleColumns::is_particle).
+   *
+   * \param[in] index Index into the internal storage.
+   */
+  const ParticleData &at_index(unsigned index) const {
+    assert(index < data_size_ && !data_[index].hole_);
+    sync_records();
+    return data_[index];
+  }
+
+  /**
+   * \return whether entry \p index of the internal storage exists and holds a
+   * particle.
+   *
+   * \param[in] index Index into the internal storage.
+   */
+  bool holds_particle(unsigned index) const {
+    return index < data_size_ && !data_[index].hole_;
+  }
+
+  /**
+   * \return the history of the particle in entry \p index of the internal
+   * storage, which has to hold a particle. Unlike at_index, this does not
+   * need the positions and momenta of the ParticleData records to be
+   * current, so it can be used within update_columns.
+   *
+   * \param[in] index Index into the internal storage.
+   */
+  HistoryData history(unsigned index) const {
+    assert(index < data_size_ && !data_[index].hole_);
+    return data_[index].get_history();
+  }
+
+  /**
+   * \return the frequently used fields of all particles as a structure of
+   * arrays. Loops over all particles that only read these fields should use
+   * the columns instead of the ParticleData records.
+   *
+   * Changes made through the references handed out by create(PdgCode) and
+   * the non-const iterators are taken over here. This only copies the marked
+   * entries, but it modifies the object, so this function must not be called
+   * concurrently in that case.
+   */
+  const ParticleColumns &columns() const {
+    if (!modified_records_.empty()) {
+      sync_modified_records();
+    }
+    columns_.size = data_size_;
+    return columns_;
+  }
+
+  /**
+   * Applies \p update to the columns of every particle. Bulk modifications of
+   * the positions or momenta of all particles should use this function, since
+   * it does not touch the ParticleData records. They take over the changes
+   * when they are accessed next, see sync_records().
+   *
+   * \param[in] update Function called as \c update(columns, i) for every
+   *            entry \c i of the columns that holds a particle. It may only
+   *            modify the positions and momenta of entry \c i (see
+   *            ParticleColumns::set_position and
+   *            ParticleColumns::set_momentum).
+   */
+  template <typename F>
+  void update_columns(F &&update) {
+    columns();
+    for (unsigned i = 0; i < data_size_; ++i) {
+      if (columns_.is_particle(i)) {
+        update(columns_, i);
+      }
+    }
+    records_current_ = false;
+  }
+
+  /**
+   * Applies \p update to the ParticleData record of every particle and keeps
+   * the columns in sync. This is meant for modifications of other fields than
+   * the positions and momenta, e.g. when the particles are initialized, for
+   * which update_columns cannot be used.
+   *
+   * \param[in] update Function modifying a ParticleData object. It must not
+   *            modify this Particles object in any other way.
+   */
+  template <typename F>
+  void update_all(F &&update) {
+    columns();
+    sync_records();
+    for (unsigned i = 0; i < data_size_; ++i) {
+      if (!data_[i].hole_) {
+        update(data_[i]);
+        columns_.set(i, data_[i]);
+      }
+    }
+  }
+
+  /**
+   * Copies the positions and momenta from the columns into the ParticleData
+   * records, if the columns were modified by update_columns. Every function
+   * handing out ParticleData records calls this, so it only needs to be
+   * called explicitly before the records are accessed from several threads,
+   * because it modifies the object.
+   */
+  void sync_records() const {
+    if (!records_current_) {
+      // Changes of records handed out after update_columns must not be
+      // overwritten by the columns.
+      if (!modified_records_.empty()) {
+        sync_modified_records();
+      }
+      copy_columns_to_records();
+    }
+  }
+
   /**
    * \internal
    * Iterator type that skips over the holes in data_. It implements a standard
@@ -255,8 +642,27 @@ class Particles {
      */
     GenericIterator(pointer p) : ptr_(p) {}  // NOLINT(runtime/explicit)
 
+    /**
+     * Constructs an iterator pointing to the ParticleData pointed to by \p p,
+     * which marks the entries it hands out as modified in \p owner.
+     *
+     * \param[in] p The particle which is pointed by the iterator.
+     * \param[in] owner The Particles object containing \p p.
+     */
+    GenericIterator(pointer p, const Particles *owner)
+        : ptr_(p), owner_(owner) {}
+
+    /// Mark the current entry as modified, if this is a non-const iterator.
+    void touch() const {
+      if (owner_) {
+        owner_->mark_modified(ptr_->index_);
+      }
+    }
+
     /// The entry in Particles this iterator points to.
     pointer ptr_;
+    /// The Particles object to notify about modifications, if any.
+    const Particles *owner_ = nullptr;
 
    public:
     /**
@@ -314,14 +720,26 @@ class Particles {
     }
 
     /// \return the dereferenced iterator.
-    reference operator*() { return *ptr_; }
+    reference operator*() {
+      touch();
+      return *ptr_;
+    }
     /// \return the dereferenced iterator.
-    const_reference operator*() const { return *ptr_; }
+    const_reference operator*() const {
+      touch();
+      return *ptr_;
+    }
 
     /// \return the dereferenced iterator.
-    pointer operator->() { return ptr_; }
+    pointer operator->() {
+      touch();
+      return ptr_;
+    }
     /// \return the dereferenced iterator.
-    const_pointer operator->() const { return ptr_; }
+    const_pointer operator->() const {
+      touch();
+      return ptr_;
+    }
 
     /// \return whether two iterators point to the same object.
     bool operator==(const GenericIterator &rhs) const {
@@ -355,7 +773,11 @@ class Particles {
   /// An alias to the GenericIterator class of const ParticleData
   using const_iterator = GenericIterator<const ParticleData>;
 
-  /// \return a reference to the first particle in the list.
+  /**
+   * \return a reference to the first particle in the list.
+   * \note The particle is taken over into the columns on the next call of
+   * columns().
+   */
   ParticleData &front() { return *begin(); }
   /**
    * const overload of &front()
@@ -364,7 +786,11 @@ class Particles {
    */
   const ParticleData &front() const { return *begin(); }
 
-  /// \return a reference to the last particle in the list.
+  /**
+   * \return a reference to the last particle in the list.
+   * \note The particle is taken over into the columns on the next call of
+   * columns().
+   */
   ParticleData &back() { return *(--end()); }
   /**
    * const overload of &back()
@@ -376,13 +802,17 @@ class Particles {
   /**
    * \return an iterator pointing to the first particle in the list. Use it to
    * iterate over all particles in the list.
+   * \note The particles handed out by the iterator are taken over into the
+   * columns on the next call of columns(), see update_columns() for bulk
+   * modifications of the positions and momenta.
    */
   iterator begin() {
+    sync_records();
     ParticleData *first = &data_[0];
     while (first->hole_) {
       ++first;
     }
-    return first;
+    return {first, this};
   }
   /**
    * const overload of begin()
@@ -390,6 +820,7 @@ class Particles {
    * \return an iterator pointing to the first particle in the list.
    */
   const_iterator begin() const {
+    sync_records();
     ParticleData *first = &data_[0];
     while (first->hole_) {
       ++first;
@@ -401,7 +832,7 @@ class Particles {
    * \return an iterator pointing behind the last particle in the list. Use it
    * to iterate over all particles in the list.
    */
-  iterator end() { return &data_[data_size_]; }
+  iterator end() { return {&data_[data_size_], this}; }
   /**
    * const overload of end()
    *
@@ -464,6 +895,41 @@ class Particles {
    */
   inline void copy_in(ParticleData &to, const ParticleData &from);
 
+  /**
+   * \internal
+   * Advance the generation of an entry in data_, which invalidates all copies
+   * of it.
+   *
+   * \param[in,out] entry The entry in data_.
+   */
+  void next_generation(ParticleData &entry) {
+    entry.generation_ = ++generations_[entry.index_];
+  }
+
+  /**
+   * \internal
+   * Copy the entries of data_ that were handed out by create(PdgCode) into
+   * the columns.
+   */
+  void sync_modified_records() const;
+
+  /**
+   * \internal
+   * Mark an entry of data_ that was handed out as a modifiable reference, so
+   * that it is copied into the columns by sync_modified_records().
+   *
+   * \param[in] index The entry in data_.
+   */
+  void mark_modified(unsigned index) const {
+    if (!modified_flags_[index]) {
+      modified_flags_[index] = true;
+      modified_records_.push_back(index);
+    }
+  }
+
+  /// \internal Copy the positions and momenta of the columns into data_.
+  void copy_columns_to_records() const;
+
   /**
    * \internal
    * The number of elements in data_ (including holes, but excluding entries
@@ -482,6 +948,35 @@ class Particles {
    */
   std::unique_ptr<ParticleData[]> data_;
 
+  /**
+   * Generations of the entries in data_, see \ref ParticleData::generation_.
+   * They are kept apart from data_, such that checking the validity of a copy
+   * only reads a single integer. Its size is data_capacity_.
+   */
+  std::vector<uint32_t> generations_;
+
+  /**
+   * The frequently used fields of the entries in data_, see columns(). They
+   * are the primary storage of the positions and momenta. The size of every
+   * column is data_capacity_.
+   */
+  mutable ParticleColumns columns_;
+
+  /**
+   * Whether the positions and momenta in data_ agree with columns_. This is
+   * reset by update_columns.
+   */
+  mutable bool records_current_ = true;
+
+  /**
+   * Indices of the entries in data_ that were handed out as modifiable
+   * references and still have to be copied into columns_.
+   */
+  mutable std::vector<unsigned> modified_records_;
+
+  /// Whether an entry in data_ is contained in modified_records_.
+  mutable std::vector<bool> modified_flags_;
+
   /**
    * Stores the indexes in data_ that do not hold valid particle data and should
    * be reused when new particles are added.
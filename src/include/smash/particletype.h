@@ -15,6 +15,7 @@
 #include "forwarddeclarations.h"
 #include "macros.h"
 #include "pdgcode.h"
+#include "sha256.h"
 
 namespace smash {
 
@@ -288,11 +289,34 @@ class ParticleType {
   /**
    * Get the mass-dependent total width of a particle with mass m.
    *
+   * If the tabulation is enabled (see enable_width_tabulation), this is
+   * interpolated between the nodes for masses up to width_tabulation_range
+   * above the pole mass.
+   *
    * \param[in] m Invariant mass of the decaying particle.
    * \return the total width for all modes for this mass
    */
   double total_width(const double m) const;
 
+  /**
+   * Get the mass-dependent total width of the decay modes selected by \p wh.
+   * It is the sum of the widths from get_partial_widths for a particle of
+   * mass \p m that is not affected by potentials, but no branches are
+   * created.
+   *
+   * \param[in] m Invariant mass of the decaying particle.
+   * \param[in] wh enum that decides which decay modes are summed.
+   * \return the total width of the selected modes for this mass
+   */
+  double total_width(const double m, WhichDecaymodes wh) const;
+
+  /**
+   * \return whether the potentials shift the invariant mass that is used for
+   * the widths in get_partial_widths. Otherwise the widths of a particle only
+   * depend on its mass.
+   */
+  static bool potentials_affect_decays();
+
   /**
    * Helper Function that containes the if-statement logic that decides if a
    * decay mode is either a hadronic and dilepton decay mode.
@@ -314,6 +338,45 @@ class ParticleType {
   DecayBranchList get_partial_widths(const FourVector p, const ThreeVector x,
                                      WhichDecaymodes wh) const;
 
+  /**
+   * Get all the mass-dependent partial decay widths like above, but without
+   * creating the process branches.
+   *
+   * \param[in] p 4-momentum of the decaying particle.
+   * \param[in] x position of the decaying particle.
+   * \param[in] wh enum that decides which decay modes are included.
+   * \param[out] widths Resized to the number of decay modes and filled with
+   *             the partial widths, indexed like the decay mode list (see
+   *             decay_modes()). The width of a mode that is not included or
+   *             closed is 0. The buffer can be reused to avoid allocations.
+   * \return the sum of the partial widths, which equals the total weight of
+   * the branches returned by the function above.
+   */
+  double get_partial_widths(const FourVector p, const ThreeVector x,
+                            WhichDecaymodes wh,
+                            std::vector<double> &widths) const;
+
+  /**
+   * Create the process branch of one decay mode.
+   *
+   * \param[in] i Index of the decay mode in the decay mode list.
+   * \param[in] width Partial width of the mode, the weight of the branch.
+   * \return the branch.
+   */
+  DecayBranchPtr decay_branch(size_t i, double width) const;
+
+  /**
+   * Randomly choose one decay mode according to the partial widths and
+   * create its process branch.
+   *
+   * \param[in] widths The partial widths, see get_partial_widths.
+   * \param[in] total_width The sum of \p widths, which has to be positive.
+   * \return the branch of the chosen mode.
+   * \throw std::invalid_argument if none of the widths is positive.
+   */
+  DecayBranchPtr choose_decay_branch(const std::vector<double> &widths,
+                                     double total_width) const;
+
   /**
    * Get the mass-dependent partial width of a resonance with mass m,
    * decaying into two given daughter particles.
@@ -351,6 +414,10 @@ class ParticleType {
    *              spectral function is to be evaluated.
    * \return the value of the spectral function for this mass
    *
+   * If the tabulation is enabled (see enable_width_tabulation), this is
+   * interpolated between the nodes for masses up to width_tabulation_range
+   * above the pole mass.
+   *
    * \note The normalization factor N ensures that the spectral function is
    *       normalized to unity.
    */
@@ -553,6 +620,52 @@ class ParticleType {
    */
   static void check_consistency();
 
+  /**
+   * Computes all lazily initialized quantities of the particle types and
+   * their decay modes (minimal masses, isospin, normalization of the spectral
+   * function, threshold and tabulations of the decay modes).
+   *
+   * These are otherwise computed on first use, which is a race condition if
+   * particle properties or cross sections are evaluated by several threads.
+   * Therefore, this has to be called before doing so.
+   *
+   * Note that the particles and decay modes have to be initialized, otherwise
+   * calling this is undefined behavior.
+   */
+  static void prepare_for_multithreading();
+
+  /**
+   * Enable the tabulation of the total widths and the normalized spectral
+   * functions of all unstable particle types, which turns total_width and
+   * spectral_function into table lookups.
+   *
+   * The tabulations are set up when the width or spectral function of an
+   * unstable type is needed for the first time, so runs that never need them
+   * do not pay for it. They are read from the cache if it holds them for the
+   * same \p hash, and computed and stored there otherwise. The nodes of the
+   * widths are equidistant in \f$ \sqrt{m - m_{min}} \f$, where
+   * \f$ m_{min} \f$ is the kinematic minimal mass, so they are dense close to
+   * the threshold, where the width changes fastest. The nodes of the spectral
+   * functions are equidistant in \f$ \arctan((m - m_0) / \Gamma_0) \f$, so
+   * they are dense around the pole, independent of how narrow the resonance
+   * is.
+   *
+   * The particles and decay modes have to be initialized. The setup is
+   * thread-safe.
+   *
+   * \param hash The hash of the particle properties.
+   * \param tabulations_path The directory where the tabulations are cached,
+   *                         nothing is cached if it is empty.
+   */
+  static void enable_width_tabulation(sha256::Hash hash,
+                                      const bf::path &tabulations_path);
+
+  /**
+   * Largest distance of a mass above the pole mass for which the tabulated
+   * width and spectral function are used [GeV].
+   */
+  static constexpr double width_tabulation_range = 10.;
+
   /**
    * Returns an object that acts like a pointer, except that it requires only 2
    * bytes and inhibits pointer arithmetics.
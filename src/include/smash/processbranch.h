@@ -12,6 +12,7 @@
 #include <utility>
 #include <vector>
 
+#include "arena.h"
 #include "decaytype.h"
 #include "forwarddeclarations.h"
 #include "particletype.h"
@@ -139,6 +140,21 @@ class ProcessBranch {
    */
   virtual ~ProcessBranch() = default;
 
+  /**
+   * Branches are allocated from the Arena, because they are created for every
+   * channel of every action.
+   *
+   * \param[in] size Size of the branch [bytes].
+   * \return memory for the branch.
+   */
+  static void *operator new(std::size_t size) { return Arena::allocate(size); }
+  /**
+   * Release the memory of a branch.
+   *
+   * \param[in] ptr Memory of the branch.
+   */
+  static void operator delete(void *ptr) { Arena::deallocate(ptr); }
+
   /**
    * Set the weight of the branch.
    * In other words, how probable this branch is
@@ -11,6 +11,7 @@
 #define SRC_INCLUDE_PROCESSSTRING_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -174,6 +175,12 @@ class StringProcess {
   /// An object to compute cross-sections
   Pythia8::SigmaTotal pythia_sigmatot_;
 
+  /**
+   * Guards the cross-section computation with Pythia, which happens
+   * concurrently if actions are found with several threads.
+   */
+  std::mutex sigmatot_mutex_;
+
   /**
    * An object for the flavor selection in string fragmentation
    * in the case of separate fragmentation function for leading baryon
@@ -301,6 +308,7 @@ class StringProcess {
    */
   std::array<double, 3> cross_sections_diffractive(int pdg_a, int pdg_b,
                                                    double sqrt_s) {
+    std::lock_guard<std::mutex> lock(sigmatot_mutex_);
     // This threshold magic is following Pythia. Todo(ryu): take care of this.
     double sqrts_threshold = 2. * (1. + 1.0e-6);
     /* In the case of mesons, the corresponding vector meson masses
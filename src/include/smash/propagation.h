@@ -48,6 +48,21 @@ struct ExpansionProperties {
  */
 double calc_hubble(double time, const ExpansionProperties &metric);
 
+/**
+ * Propagates the position of a single particle on a straight line from the
+ * time of its last update, which is the time component of its 4-position,
+ * to a given moment.
+ *
+ * \param[in,out] data The particle
+ * \param[in] to_time final time [fm]
+ * \param[in] beam_momentum 4-momenta used instead of the actual ones for the
+ *            initial nucleons, if "frozen Fermi motion" is on, see below.
+ *            [GeV]
+ * \return dt time interval of propagation [fm]
+ */
+double propagate_straight_line(ParticleData &data, double to_time,
+                               const std::vector<FourVector> &beam_momentum);
+
 /**
  * Propagates the positions of all particles on a straight line
  * to a given moment.
@@ -98,8 +113,10 @@ void expand_space_time(Particles *particles,
  *            components of the Skyrme force
  * \param[in] FI3_lat Lattice for the electric and magnetic
  *            components of the symmetry force
+ * \return shortest time scale, energy over force, of the change of the
+ *         momenta, infinity without forces [fm]
  */
-void update_momenta(
+double update_momenta(
     Particles *particles, double dt, const Potentials &pot,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FB_lat,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FI3_lat);
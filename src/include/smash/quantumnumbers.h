@@ -90,8 +90,11 @@ class QuantumNumbers {
    * \return Constructed object.
    */
   explicit QuantumNumbers(const Particles& particles) : QuantumNumbers() {
-    for (const ParticleData& data : particles) {
-      add_values(data);
+    const ParticleColumns& columns = particles.columns();
+    for (unsigned i = 0; i < columns.size; ++i) {
+      if (columns.is_particle(i)) {
+        add_values(columns.momentum(i), columns.type[i]->pdgcode());
+      }
     }
   }
 
@@ -112,13 +115,22 @@ class QuantumNumbers {
    * \param[in] p particle whose quantum number is added to the collection
    */
   void add_values(const ParticleData& p) {
-    momentum_ += p.momentum();
-    charge_ += p.pdgcode().charge();
-    isospin3_ += p.pdgcode().isospin3();
-    strangeness_ += p.pdgcode().strangeness();
-    charmness_ += p.pdgcode().charmness();
-    bottomness_ += p.pdgcode().bottomness();
-    baryon_number_ += p.pdgcode().baryon_number();
+    add_values(p.momentum(), p.pdgcode());
+  }
+
+  /**
+   * Add the quantum numbers of a single particle to the collection.
+   * \param[in] momentum Momentum of the particle [GeV]
+   * \param[in] pdg PDG code of the particle
+   */
+  void add_values(const FourVector& momentum, const PdgCode& pdg) {
+    momentum_ += momentum;
+    charge_ += pdg.charge();
+    isospin3_ += pdg.isospin3();
+    strangeness_ += pdg.strangeness();
+    charmness_ += pdg.charmness();
+    bottomness_ += pdg.bottomness();
+    baryon_number_ += pdg.baryon_number();
   }
 
   /**
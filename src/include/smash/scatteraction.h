@@ -72,7 +72,23 @@ class ScatterAction : public Action {
    *
    * \return  squared distance \f$d^2_\mathrm{coll}\f$.
    */
-  double transverse_distance_sqr() const;
+  double transverse_distance_sqr() const {
+    return transverse_distance_sqr(incoming_particles_[0],
+                                   incoming_particles_[1]);
+  }
+
+  /**
+   * Calculate the transverse distance of two particles in their center of
+   * momentum frame, as in \ref transverse_distance_sqr() const, directly from
+   * their four-vectors. This is cheap enough to be used for rejecting
+   * candidate pairs before an action is created.
+   *
+   * \param[in] p_a First particle
+   * \param[in] p_b Second particle
+   * \return  squared distance \f$d^2_\mathrm{coll}\f$.
+   */
+  static double transverse_distance_sqr(const ParticleData &p_a,
+                                        const ParticleData &p_b);
 
   /**
    * Determine the Mandelstam s variable,
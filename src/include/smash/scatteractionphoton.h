@@ -35,15 +35,19 @@ class ScatterActionPhoton : public ScatterAction {
    *                            scattering.
    * \param[in] hadronic_cross_section_input Cross-section of
    *                                          underlying hadronic cross-section.
+   * \param[in] method How the photon cross-sections are computed.
    * \return The constructed object.
    */
 
-  ScatterActionPhoton(const ParticleList &in, const double time,
-                      const int n_frac_photons,
-                      const double hadronic_cross_section_input);
+  ScatterActionPhoton(
+      const ParticleList &in, const double time, const int n_frac_photons,
+      const double hadronic_cross_section_input,
+      const ComputationMethod method = ComputationMethod::Analytic);
 
   /**
-   * Create the photon final state and write to output.
+   * Create the final states of all fractional photons and write them to
+   * output. The kinematics which are the same for all photons are computed
+   * only once.
    *
    * \param[in] outputs List of all outputs. Does not have to be a specific
    *                     photon output, the function will take care of this.
@@ -190,6 +194,18 @@ class ScatterActionPhoton : public ScatterAction {
   /// Photonic process as determined from incoming particles.
   const ReactionType reac_;
 
+  /**
+   * Sample the final states of several photon / hadron pairs. The kinematics
+   * which do not depend on the sampled angles are computed once. Each final
+   * state is stored in the outgoing particles and the weight of the action,
+   * before it is passed on.
+   *
+   * \param[in] n_photons Number of final states to sample.
+   * \param[in] sampled Function called after each final state was sampled.
+   */
+  template <typename F>
+  void sample_photons(int n_photons, F &&sampled);
+
   /**
    * Number of photons created for each hadronic scattering, needed for correct
    * weighting. Note that in generate_final_state() only one photon + hadron is
@@ -225,6 +241,9 @@ class ScatterActionPhoton : public ScatterAction {
   /// Total hadronic cross section
   const double hadronic_cross_section_;
 
+  /// How the photon cross-sections are computed
+  const ComputationMethod computation_method_;
+
   /**
    * Calculate the differential cross section of  photon process.
    * Formfactors are not included
@@ -238,6 +257,23 @@ class ScatterActionPhoton : public ScatterAction {
   double diff_cross_section(const double t, const double m_rho,
                             MediatorType mediator = default_mediator_) const;
 
+  /**
+   * Calculate the differential cross section of photon process with the
+   * given computation method. See diff_cross_section.
+   *
+   * \tparam method Computation method of the cross-section.
+   * \param[in] s Mandelstam-s [GeV^2].
+   * \param[in] t Mandelstam-t [GeV^2].
+   * \param[in] m_rho Mass of the incoming or outgoing rho-particle [GeV]
+   * \param[in] mediator Switch for determing which mediating particle to use
+   *
+   * \return Differential cross section. [mb/\f$GeV^2\f$]
+   */
+  template <ComputationMethod method>
+  double diff_cross_section_by(const double s, const double t,
+                               const double m_rho,
+                               MediatorType mediator) const;
+
   /**
    * Find the mass of the participating rho-particle.
    *
@@ -260,6 +296,20 @@ class ScatterActionPhoton : public ScatterAction {
   CollisionBranchList photon_cross_sections(
       MediatorType mediator = default_mediator_);
 
+  /**
+   * Calculate the total cross section of the photon process with the given
+   * computation method.
+   *
+   * \tparam method Computation method of the cross-section.
+   * \param[in] s Mandelstam-s [GeV^2].
+   * \param[in] m_rho Mass of the incoming or outgoing rho-particle [GeV]
+   * \param[in] mediator Switch for determing which mediating particle to use.
+   * \returns Total cross section [mb].
+   */
+  template <ComputationMethod method>
+  double cross_section_by(const double s, const double m_rho,
+                          MediatorType mediator) const;
+
   /**
    * For processes which can happen via (pi, a1, rho) and omega exchange,
    * return the differential cross section for the (pi, a1, rho) process in
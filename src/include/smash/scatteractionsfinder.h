@@ -18,6 +18,8 @@
 #include "actionfinderfactory.h"
 #include "configuration.h"
 #include "constants.h"
+#include "crosssectionenvelope.h"
+#include "crosssectiontables.h"
 #include "scatteraction.h"
 
 namespace smash {
@@ -145,7 +147,7 @@ class ScatterActionsFinder : public ActionFinderInterface {
    * \return A list of possible scatter actions
    */
   ActionList find_actions_in_cell(
-      const ParticleList &search_list, double dt, const double cell_vol,
+      const ParticleListView &search_list, double dt, const double cell_vol,
       const std::vector<FourVector> &beam_momentum) const override;
 
   /**
@@ -161,8 +163,9 @@ class ScatterActionsFinder : public ActionFinderInterface {
    * \return A list of possible scatter actions
    */
   ActionList find_actions_with_neighbors(
-      const ParticleList &search_list, const ParticleList &neighbors_list,
-      double dt, const std::vector<FourVector> &beam_momentum) const override;
+      const ParticleListView &search_list,
+      const ParticleListView &neighbors_list, double dt,
+      const std::vector<FourVector> &beam_momentum) const override;
 
   /**
    * Search for all the possible secondary collisions between the outgoing
@@ -279,6 +282,10 @@ class ScatterActionsFinder : public ActionFinderInterface {
    * only necessary for frozen Fermi motion
    * \param[in] cell_vol (optional) volume of grid cell in which the collision
    *                                is checked
+   * \param[in] candidate_probability (optional) Probability with which the
+   *            pair was selected by sample_stochastic_collisions. The
+   *            stochastic criterion accepts the collision with its
+   *            probability divided by this one.
    * \return A null pointer if no collision happens or an action which contains
    *         the information of the outgoing particles.
    *
@@ -288,7 +295,46 @@ class ScatterActionsFinder : public ActionFinderInterface {
   ActionPtr check_collision(const ParticleData &data_a,
                             const ParticleData &data_b, double dt,
                             const std::vector<FourVector> &beam_momentum = {},
-                            const double cell_vol = 0.0) const;
+                            const double cell_vol = 0.0,
+                            const double candidate_probability = 1.0) const;
+
+  /**
+   * Find the collisions within one cell for the stochastic criterion by
+   * sampling pairs, in the spirit of the no-time-counter method of G. A.
+   * Bird, Molecular Gas Dynamics and the Direct Simulation of Gas Flows
+   * (1994).
+   *
+   * The collision probability of every pair is bounded by the one computed
+   * with the largest relative velocity in the cell. The number of candidate
+   * pairs is drawn from the binomial distribution with this bound, and the
+   * candidates are chosen uniformly among all pairs. Each is accepted with
+   * the ratio of its collision probability to the bound. Thus every pair
+   * collides with the same probability as in the check of all pairs, while
+   * the cost scales with the number of collisions instead of the squared
+   * number of particles in the cell.
+   *
+   * \param[in] search_list A list of particles within one cell
+   * \param[in] dt The maximum time interval at the current time step [fm]
+   * \param[in] cell_vol Volume of searched grid cell [fm^3]
+   * \param[in] beam_momentum [GeV] List of beam momenta for each particle;
+   * only necessary for frozen Fermi motion
+   * \param[out] actions The found actions are appended to this list.
+   * \return false if the bound is too large for sampling, such that all pairs
+   *         have to be checked, and true otherwise.
+   */
+  bool sample_stochastic_collisions(
+      const ParticleListView &search_list, double dt, double cell_vol,
+      const std::vector<FourVector> &beam_momentum,
+      std::vector<ActionPtr> &actions) const;
+
+  /**
+   * Add all collision branches of the incoming particles to the action. They
+   * are interpolated in the cross-section tables if these are enabled and
+   * cover the pair, otherwise they are computed directly.
+   *
+   * \param[in,out] act The action to which the branches are added.
+   */
+  void add_scatterings(ScatterAction &act) const;
 
   /// Class that deals with strings, interfacing Pythia.
   std::unique_ptr<StringProcess> string_process_interface_;
@@ -327,6 +373,18 @@ class ScatterActionsFinder : public ActionFinderInterface {
   const int N_proj_;
   /// Parameter for formation time
   const double string_formation_time_;
+  /// How the cross sections are obtained
+  const CrossSectionMode xs_mode_;
+  /// Sample the pairs of the stochastic criterion instead of checking all
+  const bool stochastic_pair_sampling_;
+  /**
+   * Upper bounds of the total cross sections, used to reject pairs in the
+   * geometric criterion before computing their cross section. Only created if
+   * enabled in the configuration.
+   */
+  std::unique_ptr<CrossSectionEnvelope> xs_envelope_;
+  /// Tabulated cross sections, only created if not in the direct mode
+  std::unique_ptr<CrossSectionTables> xs_tables_;
 };
 
 }  // namespace smash
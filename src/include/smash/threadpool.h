@@ -0,0 +1,119 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_THREADPOOL_H_
+#define SRC_INCLUDE_THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace smash {
+
+/**
+ * A fixed set of worker threads that process the items of a loop in parallel.
+ *
+ * The thread calling \ref parallel_for takes part in the work, so a pool of
+ * size N starts N - 1 additional threads. The items are handed out
+ * dynamically, so the assignment of items to threads is not reproducible.
+ * Callers that need reproducible results have to store the results per item
+ * and merge them in item order afterwards.
+ *
+ * \note The threads persist for the lifetime of the pool, such that
+ * thread_local caches (e.g. of integrators or the random number engine) are
+ * only set up once per thread.
+ */
+class ThreadPool {
+ public:
+  /**
+   * Starts the worker threads.
+   *
+   * \param[in] n_threads The total number of threads working on a loop,
+   *            including the calling thread.
+   * \throws std::invalid_argument if \p n_threads is smaller than 1.
+   */
+  explicit ThreadPool(int n_threads);
+
+  /// Cannot be copied
+  ThreadPool(const ThreadPool &) = delete;
+  /// Cannot be copied
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /// Stops and joins the worker threads.
+  ~ThreadPool();
+
+  /// \return the total number of threads, including the calling thread.
+  int size() const { return workers_.size() + 1; }
+
+  /**
+   * Calls \p func for every item index in [0, \p n_items) and returns after
+   * all calls have finished. The calls happen concurrently, so \p func must
+   * be thread-safe.
+   *
+   * \param[in] n_items Number of items.
+   * \param[in] func Function processing the item with the given index.
+   * \throws The first exception thrown by any call of \p func. No further
+   *         items are started after that; the function returns when the
+   *         items already being processed have finished.
+   */
+  void parallel_for(std::size_t n_items,
+                    const std::function<void(std::size_t)> &func);
+
+ private:
+  /// Loop of the worker threads, waiting for work until the pool is stopped.
+  void work();
+
+  /// Processes items of the current loop until none is left.
+  void run_items();
+
+  /// The worker threads.
+  std::vector<std::thread> workers_;
+
+  /// Guards the members describing the current loop.
+  std::mutex mutex_;
+
+  /// Signals the workers that a new loop starts or that the pool stops.
+  std::condition_variable start_;
+
+  /// Signals the calling thread that all workers finished the loop.
+  std::condition_variable done_;
+
+  /// The function of the current loop.
+  const std::function<void(std::size_t)> *func_ = nullptr;
+
+  /// The number of items of the current loop.
+  std::size_t n_items_ = 0;
+
+  /// The next item to be processed.
+  std::atomic<std::size_t> next_item_{0};
+
+  /// Counts the loops, such that the workers can detect a new loop.
+  std::size_t loop_count_ = 0;
+
+  /// The number of workers that did not finish the current loop yet.
+  std::size_t busy_workers_ = 0;
+
+  /// Whether the workers have to stop.
+  bool stop_ = false;
+
+  /// The first exception thrown in the current loop.
+  std::exception_ptr error_;
+
+  /// Whether an item of the current loop threw, such that no new items start.
+  std::atomic<bool> failed_{false};
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_THREADPOOL_H_
@@ -0,0 +1,158 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#ifndef SRC_INCLUDE_VERLETLISTS_H_
+#define SRC_INCLUDE_VERLETLISTS_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "grid.h"
+#include "particles.h"
+
+namespace smash {
+
+/**
+ * \ingroup action
+ *
+ * Neighbor lists of all particles on the grid, which contain the particles
+ * within the interaction length plus a skin distance. They replace the
+ * search of the grid cells at the beginning of a time step, such that only
+ * the pairs close to each other are handed to the action finders.
+ *
+ * The lists stay valid over several time steps: as long as no particle moved
+ * by more than half of the remaining skin since the lists were built, every
+ * pair that is closer than the interaction length is still in them. They are
+ * rebuilt otherwise.
+ *
+ * A particle is listed if it was on the grid when the lists were built. The
+ * particles created since then, e.g. by decays, and those that were not yet
+ * formed are unlisted. Their partners are searched in the cells around them,
+ * like for the outgoing particles of an action.
+ */
+class VerletLists {
+ public:
+  /**
+   * \param[in] skin Distance added to the interaction length for the lists
+   *            [fm]
+   * \throw std::invalid_argument if \p skin is not positive.
+   */
+  explicit VerletLists(double skin);
+
+  /**
+   * \return the minimal cell length of the grid from which the lists are
+   * built [fm].
+   *
+   * \param[in] interaction_length Largest distance of two particles that can
+   *            interact within the time step [fm]
+   */
+  double grid_cell_length(double interaction_length) const {
+    return interaction_length + skin_;
+  }
+
+  /**
+   * Rebuild the lists if they do not cover all pairs closer than \p
+   * interaction_length anymore or if more than a quarter of the particles is
+   * unlisted.
+   *
+   * \param[in] grid The grid, updated to the current state of \p particles
+   *            with a cell length of at least grid_cell_length().
+   * \param[in] particles The particles.
+   * \param[in] interaction_length Largest distance of two particles that can
+   *            interact within the time step [fm]
+   * \param[in] timestep_duration Duration of the time step [fm]
+   * \return whether the lists were rebuilt.
+   */
+  template <GridOptions O>
+  bool update(const Grid<O> &grid, const Particles &particles,
+              double interaction_length, double timestep_duration);
+
+  /**
+   * \return whether \p p is listed, i.e. it was on the grid when the lists
+   * were built.
+   */
+  bool is_listed(const ParticleData &p) const {
+    return p.index() < ids_.size() && ids_[p.index()] == p.id();
+  }
+
+  /**
+   * Collect the partners of \p p, such that every pair of particles on the
+   * grid that may interact is found exactly once when this is called for all
+   * of them. These are the listed neighbors with a larger id for a listed
+   * particle, and the listed particles and the unlisted ones with a larger id
+   * in the cells around it for an unlisted particle.
+   *
+   * \param[in] grid The grid, see update().
+   * \param[in] particles The particles, unchanged since the last update().
+   * \param[in] p The particle, which has to be on the grid.
+   * \param[out] partners Replaced by the indices of the partners in the
+   *             storage of \p particles (see Particles::view).
+   */
+  template <GridOptions O>
+  void collect_partners(const Grid<O> &grid, const Particles &particles,
+                        const ParticleData &p,
+                        std::vector<unsigned> &partners) const;
+
+  /// \return the number of calls to update().
+  std::size_t number_of_updates() const { return number_of_updates_; }
+
+  /// \return the number of times the lists were built.
+  std::size_t number_of_builds() const { return number_of_builds_; }
+
+ private:
+  /**
+   * Build the lists for all particles on the grid.
+   *
+   * \param[in] grid See update().
+   * \param[in] particles See update().
+   * \param[in] interaction_length See update().
+   * \param[in] timestep_duration See update().
+   */
+  template <GridOptions O>
+  void build(const Grid<O> &grid, const Particles &particles,
+             double interaction_length, double timestep_duration);
+
+  /// Distance added to the interaction length [fm]
+  const double skin_;
+
+  /// Radius of the lists, the interaction length plus the skin at the build
+  double radius_ = 0.;
+
+  /**
+   * Ids of the listed particles, indexed like the Particles storage, and -1
+   * for the entries without a listed particle.
+   */
+  std::vector<int> ids_;
+
+  /// x components of the positions at the build [fm]
+  std::vector<double> x_;
+  /// y components of the positions at the build [fm]
+  std::vector<double> y_;
+  /// z components of the positions at the build [fm]
+  std::vector<double> z_;
+
+  /**
+   * The neighbors of the listed particle with storage index i are
+   * neighbors_[offsets_[i]] to neighbors_[offsets_[i + 1] - 1].
+   */
+  std::vector<std::size_t> offsets_;
+
+  /// Storage indices of the neighbors of all listed particles
+  std::vector<unsigned> neighbors_;
+
+  /// Number of calls to update()
+  std::size_t number_of_updates_ = 0;
+
+  /// Number of builds of the lists
+  std::size_t number_of_builds_ = 0;
+};
+
+}  // namespace smash
+
+#endif  // SRC_INCLUDE_VERLETLISTS_H_
@@ -7,15 +7,141 @@
 
 #include "smash/interpolation2D.h"
 
-#include <initializer_list>
-#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <stdexcept>
 
 namespace smash {
 
+namespace {
+/**
+ * Compute the first derivatives at the nodes of a natural cubic spline, in
+ * the same way as gsl_interp_cspline.
+ *
+ * \param x Strictly increasing nodes (at least 3).
+ * \param y Values at the nodes.
+ * \return Derivatives of the spline at the nodes.
+ */
+std::vector<double> spline_derivatives(const std::vector<double>& x,
+                                       const std::vector<double>& y) {
+  const size_t n = x.size();
+  // c are half the second derivatives, vanishing at the boundaries for a
+  // natural spline. The inner ones follow from a tridiagonal system, which is
+  // solved with the Thomas algorithm.
+  std::vector<double> c(n, 0.), diag(n), rhs(n);
+  for (size_t i = 1; i < n - 1; i++) {
+    const double h_lo = x[i] - x[i - 1], h_hi = x[i + 1] - x[i];
+    diag[i] = 2. * (h_lo + h_hi);
+    rhs[i] = 3. * ((y[i + 1] - y[i]) / h_hi - (y[i] - y[i - 1]) / h_lo);
+    if (i > 1) {
+      const double factor = h_lo / diag[i - 1];
+      diag[i] -= factor * h_lo;
+      rhs[i] -= factor * rhs[i - 1];
+    }
+  }
+  for (size_t i = n - 2; i > 0; i--) {
+    c[i] = (rhs[i] - (x[i + 1] - x[i]) * c[i + 1]) / diag[i];
+  }
+
+  std::vector<double> derivatives(n);
+  for (size_t i = 0; i < n - 1; i++) {
+    const double h = x[i + 1] - x[i];
+    derivatives[i] = (y[i + 1] - y[i]) / h - h * (c[i + 1] + 2. * c[i]) / 3.;
+  }
+  const double h = x[n - 1] - x[n - 2];
+  derivatives[n - 1] =
+      (y[n - 1] - y[n - 2]) / h + h * (2. * c[n - 1] + c[n - 2]) / 3.;
+  return derivatives;
+}
+
+/**
+ * Check whether the nodes deviate from the given equidistant ones by less
+ * than a tenth of the spacing, so that the cell guessed from the spacing is
+ * off by at most one.
+ *
+ * \param nodes Nodes (possibly transformed).
+ * \param origin First equidistant node.
+ * \param step Spacing of the equidistant nodes.
+ * \return Whether the nodes are approximately equidistant.
+ */
+bool is_equidistant(const std::vector<double>& nodes, double origin,
+                    double step) {
+  for (size_t i = 0; i < nodes.size(); i++) {
+    if (std::abs(nodes[i] - (origin + i * step)) > 0.1 * step) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+InterpolateData2DSpline::Grid::Grid(const std::vector<double>& nodes)
+    : nodes_(nodes), spacing_(Spacing::Irregular), origin_(0.),
+      inverse_step_(0.) {
+  const size_t n = nodes_.size();
+  if (n < 2) {
+    // not usable for interpolation, rejected by InterpolateData2DSpline
+    return;
+  }
+  inverse_widths_.reserve(n - 1);
+  for (size_t i = 0; i < n - 1; i++) {
+    inverse_widths_.push_back(1. / (nodes_[i + 1] - nodes_[i]));
+  }
+
+  const double step = (nodes_.back() - nodes_.front()) / (n - 1);
+  if (is_equidistant(nodes_, nodes_.front(), step)) {
+    spacing_ = Spacing::Uniform;
+    origin_ = nodes_.front();
+    inverse_step_ = 1. / step;
+    return;
+  }
+  if (nodes_.front() > 0.) {
+    std::vector<double> logs(n);
+    std::transform(nodes_.begin(), nodes_.end(), logs.begin(),
+                   [](double v) { return std::log(v); });
+    const double log_step = (logs.back() - logs.front()) / (n - 1);
+    if (is_equidistant(logs, logs.front(), log_step)) {
+      spacing_ = Spacing::LogUniform;
+      origin_ = logs.front();
+      inverse_step_ = 1. / log_step;
+    }
+  }
+}
+
+double InterpolateData2DSpline::Grid::clamp(double v) const {
+  return std::min(std::max(v, nodes_.front()), nodes_.back());
+}
+
+size_t InterpolateData2DSpline::Grid::cell(double v) const {
+  const ptrdiff_t last = nodes_.size() - 2;
+  double guess;
+  switch (spacing_) {
+    case Spacing::Uniform:
+      guess = (v - origin_) * inverse_step_;
+      break;
+    case Spacing::LogUniform:
+      guess = (std::log(v) - origin_) * inverse_step_;
+      break;
+    default: {
+      const auto upper =
+          std::upper_bound(nodes_.begin() + 1, nodes_.end() - 1, v);
+      return upper - nodes_.begin() - 1;
+    }
+  }
+  ptrdiff_t i = std::min(std::max(static_cast<ptrdiff_t>(guess),
+                                  static_cast<ptrdiff_t>(0)),
+                         last);
+  // The guess is off by at most one cell, correct it against the nodes.
+  i += static_cast<ptrdiff_t>(v >= nodes_[i + 1]) -
+       static_cast<ptrdiff_t>(v < nodes_[i]);
+  return std::min(i, last);
+}
+
 InterpolateData2DSpline::InterpolateData2DSpline(const std::vector<double>& x,
                                                  const std::vector<double>& y,
-                                                 const std::vector<double>& z) {
+                                                 const std::vector<double>& z)
+    : x_(x), y_(y) {
   const size_t M = x.size();
   const size_t N = y.size();
 
@@ -31,41 +157,126 @@ InterpolateData2DSpline::InterpolateData2DSpline(const std::vector<double>& x,
         "interpolation.");
   }
 
-  // Assign lower and upper bounds for constant extrapolation
-  first_x_ = x.front();
-  last_x_ = x.back();
-  first_y_ = y.front();
-  last_y_ = y.back();
-
-  // cast vectors into arrays, as GSL functions can only handle arrays
-  const double* xa = &x[0];
-  const double* ya = &y[0];
-  const double* za = &z[0];
+  const auto not_increasing = std::greater_equal<double>();
+  if (std::adjacent_find(x.begin(), x.end(), not_increasing) != x.end() ||
+      std::adjacent_find(y.begin(), y.end(), not_increasing) != y.end()) {
+    throw std::runtime_error(
+        "Nodes of 2D interpolation have to be strictly increasing.");
+  }
 
-  // Create accelerator objects (interpolation lookups)
-  xacc_ = gsl_interp_accel_alloc();
-  yacc_ = gsl_interp_accel_alloc();
+  // Derivatives at the nodes: dz/dx from splines along x, dz/dy from splines
+  // along y and d2z/dxdy from splines of dz/dy along x.
+  std::vector<double> zx(N * M), zy(N * M), zxy(N * M);
+  std::vector<double> line(M), derivatives;
+  for (size_t j = 0; j < N; j++) {
+    std::copy(z.begin() + j * M, z.begin() + (j + 1) * M, line.begin());
+    derivatives = spline_derivatives(x, line);
+    std::copy(derivatives.begin(), derivatives.end(), zx.begin() + j * M);
+  }
+  line.resize(N);
+  for (size_t i = 0; i < M; i++) {
+    for (size_t j = 0; j < N; j++) {
+      line[j] = z[j * M + i];
+    }
+    derivatives = spline_derivatives(y, line);
+    for (size_t j = 0; j < N; j++) {
+      zy[j * M + i] = derivatives[j];
+    }
+  }
+  line.resize(M);
+  for (size_t j = 0; j < N; j++) {
+    std::copy(zy.begin() + j * M, zy.begin() + (j + 1) * M, line.begin());
+    derivatives = spline_derivatives(x, line);
+    std::copy(derivatives.begin(), derivatives.end(), zxy.begin() + j * M);
+  }
 
-  // Initialize bicubic spline interpolation
-  spline_ = gsl_spline2d_alloc(gsl_interp2d_bicubic, M, N);
-  gsl_spline2d_init(spline_, xa, ya, za, M, N);
+  // Hermite basis in matrix form: the coefficients of a cell are
+  // A = H F H^T, where F holds the values and the derivatives (in units of
+  // the cell widths) at the corners.
+  constexpr double H[4][4] = {
+      {1, 0, 0, 0}, {0, 0, 1, 0}, {-3, 3, -2, -1}, {2, -2, 1, 1}};
+  coefficients_.resize((N - 1) * (M - 1));
+  for (size_t j = 0; j < N - 1; j++) {
+    const double dy = y[j + 1] - y[j];
+    for (size_t i = 0; i < M - 1; i++) {
+      const double dx = x[i + 1] - x[i];
+      double F[4][4];
+      for (size_t a = 0; a < 2; a++) {
+        for (size_t b = 0; b < 2; b++) {
+          const size_t k = (j + b) * M + i + a;
+          F[a][b] = z[k];
+          F[a][b + 2] = zy[k] * dy;
+          F[a + 2][b] = zx[k] * dx;
+          F[a + 2][b + 2] = zxy[k] * dx * dy;
+        }
+      }
+      double HF[4][4];
+      for (size_t m = 0; m < 4; m++) {
+        for (size_t n = 0; n < 4; n++) {
+          HF[m][n] = 0.;
+          for (size_t l = 0; l < 4; l++) {
+            HF[m][n] += H[m][l] * F[l][n];
+          }
+        }
+      }
+      std::array<double, 16>& c = coefficients_[j * (M - 1) + i];
+      for (size_t m = 0; m < 4; m++) {
+        for (size_t n = 0; n < 4; n++) {
+          c[4 * m + n] = 0.;
+          for (size_t l = 0; l < 4; l++) {
+            c[4 * m + n] += HF[m][l] * H[n][l];
+          }
+        }
+      }
+    }
+  }
 }
 
-InterpolateData2DSpline::~InterpolateData2DSpline() {
-  gsl_spline2d_free(spline_);
-  gsl_interp_accel_free(xacc_);
-  gsl_interp_accel_free(yacc_);
+namespace {
+/**
+ * Evaluate the bicubic polynomial of a cell.
+ *
+ * \param c Coefficients of the cell.
+ * \param t Relative position in x direction.
+ * \param u Relative position in y direction.
+ * \return Value of the polynomial.
+ */
+inline double evaluate_cell(const std::array<double, 16>& c, double t,
+                            double u) {
+  double result = 0.;
+  for (int m = 3; m >= 0; m--) {
+    const double* row = &c[4 * m];
+    result = result * t + (((row[3] * u + row[2]) * u + row[1]) * u + row[0]);
+  }
+  return result;
 }
+}  // namespace
 
 double InterpolateData2DSpline::operator()(double xi, double yi) const {
   // constant extrapolation at the edges
-  xi = (xi < first_x_) ? first_x_ : xi;
-  xi = (xi > last_x_) ? last_x_ : xi;
-  yi = (yi < first_y_) ? first_y_ : yi;
-  yi = (yi > last_y_) ? last_y_ : yi;
+  xi = x_.clamp(xi);
+  yi = y_.clamp(yi);
 
-  // bicubic spline interpolation
-  return gsl_spline2d_eval(spline_, xi, yi, xacc_, yacc_);
+  const size_t i = x_.cell(xi);
+  const size_t j = y_.cell(yi);
+  return evaluate_cell(coefficients_[j * (x_.size() - 1) + i],
+                       x_.position(xi, i), y_.position(yi, j));
+}
+
+void InterpolateData2DSpline::operator()(const std::vector<double>& xi,
+                                         double yi,
+                                         std::vector<double>& result) const {
+  yi = y_.clamp(yi);
+  const size_t j = y_.cell(yi);
+  const double u = y_.position(yi, j);
+  const auto row = coefficients_.begin() + j * (x_.size() - 1);
+
+  result.resize(xi.size());
+  for (size_t k = 0; k < xi.size(); k++) {
+    const double v = x_.clamp(xi[k]);
+    const size_t i = x_.cell(v);
+    result[k] = evaluate_cell(row[i], x_.position(v, i), u);
+  }
 }
 
 }  // namespace smash
@@ -264,6 +264,36 @@ inline void cache_integral(
   }
 }
 
+/**
+ * Find the tabulation of a multiplet.
+ *
+ * \param tabulations The tabulations of one kind of integral.
+ * \param name The name of the multiplet.
+ * \return The tabulation, or nullptr if there is none for \p name.
+ */
+static Tabulation *find_tabulation(
+    std::unordered_map<std::string, Tabulation> &tabulations,
+    const std::string &name) {
+  const auto found = tabulations.find(name);
+  return found == tabulations.end() ? nullptr : &found->second;
+}
+
+/**
+ * Get a tabulation that was looked up by IsoParticleType::tabulate_integrals.
+ *
+ * \param tabulation The looked up tabulation, might be nullptr.
+ * \param tabulations The tabulations of one kind of integral.
+ * \param name The name of the multiplet.
+ * \return The tabulation for \p name.
+ * \throw std::out_of_range if there is no tabulation for \p name.
+ */
+static const Tabulation &get_tabulation(
+    const Tabulation *tabulation,
+    const std::unordered_map<std::string, Tabulation> &tabulations,
+    const std::string &name) {
+  return tabulation != nullptr ? *tabulation : tabulations.at(name);
+}
+
 void IsoParticleType::tabulate_integrals(sha256::Hash hash,
                                          const bf::path &tabulations_path) {
   // To avoid race conditions, make sure we are the only ones currently storing
@@ -300,60 +330,49 @@ void IsoParticleType::tabulate_integrals(sha256::Hash hash,
   if (rho && h1) {
     cache_integral(rhoR_tabulations, dir, hash, *rho, *h1, nullptr, true);
   }
+  /* Look up the tabulations of each multiplet here instead of on first use.
+   * The collision finding can run in several threads and then only reads
+   * them. */
+  for (IsoParticleType &multiplet : iso_type_list) {
+    const std::string &name = multiplet.name();
+    multiplet.XS_NR_tabulation_ = find_tabulation(NR_tabulations, name);
+    multiplet.XS_piR_tabulation_ = find_tabulation(piR_tabulations, name);
+    multiplet.XS_RK_tabulation_ = find_tabulation(RK_tabulations, name);
+    multiplet.XS_DeltaR_tabulation_ =
+        find_tabulation(DeltaR_tabulations, name);
+    multiplet.XS_rhoR_tabulation_ = find_tabulation(rhoR_tabulations, name);
+  }
 }
 
 double IsoParticleType::get_integral_NR(double sqrts) {
-  if (XS_NR_tabulation_ == nullptr) {
-    const auto res = states_[0]->iso_multiplet();
-    XS_NR_tabulation_ = &NR_tabulations.at(res->name());
-  }
-  return XS_NR_tabulation_->get_value_linear(sqrts);
+  return get_tabulation(XS_NR_tabulation_, NR_tabulations, name())
+      .get_value_linear(sqrts);
 }
 
 double IsoParticleType::get_integral_piR(double sqrts) {
-  if (XS_piR_tabulation_ == nullptr) {
-    const auto res = states_[0]->iso_multiplet();
-    XS_piR_tabulation_ = &piR_tabulations.at(res->name());
-  }
-  return XS_piR_tabulation_->get_value_linear(sqrts);
+  return get_tabulation(XS_piR_tabulation_, piR_tabulations, name())
+      .get_value_linear(sqrts);
 }
 
 double IsoParticleType::get_integral_RK(double sqrts) {
-  if (XS_RK_tabulation_ == nullptr) {
-    const auto res = states_[0]->iso_multiplet();
-    XS_RK_tabulation_ = &RK_tabulations.at(res->name());
-  }
-  return XS_RK_tabulation_->get_value_linear(sqrts);
+  return get_tabulation(XS_RK_tabulation_, RK_tabulations, name())
+      .get_value_linear(sqrts);
 }
 
 double IsoParticleType::get_integral_rhoR(double sqrts) {
-  if (XS_rhoR_tabulation_ == nullptr) {
-    const auto res = states_[0]->iso_multiplet();
-    XS_rhoR_tabulation_ = &rhoR_tabulations.at(res->name());
-  }
-  return XS_rhoR_tabulation_->get_value_linear(sqrts);
+  return get_tabulation(XS_rhoR_tabulation_, rhoR_tabulations, name())
+      .get_value_linear(sqrts);
 }
 
 double IsoParticleType::get_integral_RR(IsoParticleType *type_res_2,
                                         double sqrts) {
-  const auto res = states_[0]->iso_multiplet();
   if (type_res_2->states_[0]->is_Delta()) {
-    if (XS_DeltaR_tabulation_ == nullptr) {
-      XS_DeltaR_tabulation_ = &DeltaR_tabulations.at(res->name());
-    }
-    return XS_DeltaR_tabulation_->get_value_linear(sqrts);
+    return get_tabulation(XS_DeltaR_tabulation_, DeltaR_tabulations, name())
+        .get_value_linear(sqrts);
   }
-  if (type_res_2->name() == "ρ") {
-    if (XS_rhoR_tabulation_ == nullptr) {
-      XS_rhoR_tabulation_ = &rhoR_tabulations.at(res->name());
-    }
-    return XS_rhoR_tabulation_->get_value_linear(sqrts);
-  }
-  if (type_res_2->name() == "h₁(1170)") {
-    if (XS_rhoR_tabulation_ == nullptr) {
-      XS_rhoR_tabulation_ = &rhoR_tabulations.at(res->name());
-    }
-    return XS_rhoR_tabulation_->get_value_linear(sqrts);
+  if (type_res_2->name() == "ρ" || type_res_2->name() == "h₁(1170)") {
+    return get_tabulation(XS_rhoR_tabulation_, rhoR_tabulations, name())
+        .get_value_linear(sqrts);
   }
   std::stringstream err;
   err << "RR=" << name() << type_res_2->name() << " is not implemented";
@@ -28,6 +28,15 @@ double ParticleData::effective_mass() const {
   }
 }
 
+double ParticleData::hadronic_width() const {
+  const double m = momentum_.abs();
+  if (m != hadronic_width_mass_) {
+    hadronic_width_ = type().total_width(m, WhichDecaymodes::Hadronic);
+    hadronic_width_mass_ = m;
+  }
+  return hadronic_width_;
+}
+
 void ParticleData::set_history(int ncoll, uint32_t pid, ProcessType pt,
                                double time_last_coll,
                                const ParticleList &plist) {
@@ -11,13 +11,53 @@
 
 #include <iomanip>
 #include <iostream>
+#include <limits>
 
 namespace smash {
 
-Particles::Particles() : data_(new ParticleData[data_capacity_]) {
+void ParticleColumns::resize(unsigned capacity) {
+  for (std::vector<double> *column :
+       {&t, &x, &y, &z, &e, &px, &py, &pz, &effective_mass, &formation_time,
+        &begin_formation_time}) {
+    column->resize(capacity);
+  }
+  type.resize(capacity);
+  id.resize(capacity);
+}
+
+void ParticleColumns::set(unsigned i, const ParticleData &p) {
+  type[i] = &p.type();
+  id[i] = p.id();
+  set_position(i, p.position());
+  set_momentum(i, p.momentum());
+  formation_time[i] = p.formation_time();
+  begin_formation_time[i] = p.begin_formation_time();
+}
+
+void ParticleColumns::set_momentum(unsigned i, const FourVector &mom) {
+  e[i] = mom.x0();
+  px[i] = mom.x1();
+  py[i] = mom.x2();
+  pz[i] = mom.x3();
+  // Same as ParticleData::effective_mass, but without throwing.
+  const double m_pole = type[i]->mass();
+  const double m_sqr = mom.sqr();
+  if (m_pole < really_small) {
+    effective_mass[i] = m_pole;
+  } else if (m_sqr > -really_small) {
+    effective_mass[i] = std::sqrt(std::abs(m_sqr));
+  } else {
+    effective_mass[i] = std::numeric_limits<double>::quiet_NaN();
+  }
+}
+
+Particles::Particles()
+    : data_(new ParticleData[data_capacity_]), generations_(data_capacity_) {
   for (unsigned i = 0; i < data_capacity_; ++i) {
     data_[i].index_ = i;
   }
+  columns_.resize(data_capacity_);
+  modified_flags_.resize(data_capacity_);
 }
 
 inline void Particles::ensure_capacity(unsigned to_add) {
@@ -39,12 +79,17 @@ void Particles::increase_capacity(unsigned new_capacity) {
     new_memory[i].index_ = i;
   }
   std::swap(data_, new_memory);
+  generations_.resize(data_capacity_);
+  columns_.resize(data_capacity_);
+  modified_flags_.resize(data_capacity_);
 }
 
 inline void Particles::copy_in(ParticleData &to, const ParticleData &from) {
   to.id_ = ++id_max_;
   to.type_ = from.type_;
   from.copy_to(to);
+  next_generation(to);
+  columns_.set(to.index_, to);
 }
 
 const ParticleData &Particles::insert(const ParticleData &p) {
@@ -72,6 +117,8 @@ void Particles::create(size_t number, PdgCode pdg) {
     data_[offset].id_ = ++id_max_;
     data_[offset].type_ = pd.type_;
     data_[offset].hole_ = false;
+    next_generation(data_[offset]);
+    columns_.set(offset, data_[offset]);
     --number;
   }
   if (number) {
@@ -81,6 +128,8 @@ void Particles::create(size_t number, PdgCode pdg) {
       pd.copy_to(*ptr);
       ptr->id_ = ++id_max_;
       ptr->type_ = pd.type_;
+      next_generation(*ptr);
+      columns_.set(ptr->index_, *ptr);
     }
     data_size_ += number;
   }
@@ -102,12 +151,18 @@ ParticleData &Particles::create(const PdgCode pdg) {
   pd.copy_to(*ptr);
   ptr->id_ = ++id_max_;
   ptr->type_ = pd.type_;
+  next_generation(*ptr);
+  columns_.set(ptr->index_, *ptr);
+  // The caller may modify the particle through the returned reference.
+  mark_modified(ptr->index_);
   return *ptr;
 }
 
 void Particles::remove(const ParticleData &p) {
   assert(is_valid(p));
   const unsigned index = p.index_;
+  next_generation(data_[index]);
+  columns_.set_hole(index);
   if (index == data_size_ - 1) {
     --data_size_;
   } else {
@@ -125,6 +180,7 @@ void Particles::replace(const ParticleList &to_remove, ParticleList &to_add) {
     copy_in(data_[index], to_add[i]);
     to_add[i].id_ = data_[index].id_;
     to_add[i].index_ = index;
+    to_add[i].generation_ = data_[index].generation_;
   }
   for (; i < to_remove.size(); ++i) {
     remove(to_remove[i]);
@@ -133,19 +189,70 @@ void Particles::replace(const ParticleList &to_remove, ParticleList &to_add) {
     const ParticleData &p = insert(to_add[i]);
     to_add[i].id_ = p.id_;
     to_add[i].index_ = p.index_;
+    to_add[i].generation_ = p.generation_;
   }
 }
 
 void Particles::reset() {
   id_max_ = -1;
   data_size_ = 0;
+  records_current_ = true;
+  for (unsigned index : modified_records_) {
+    modified_flags_[index] = false;
+  }
+  modified_records_.clear();
   for (auto index : dirty_) {
     data_[index].hole_ = false;
   }
   dirty_.clear();
 }
 
+void Particles::copy_from(const Particles &other) {
+  other.sync_records();
+  reset();
+  if (other.data_size_ >= data_capacity_) {
+    increase_capacity(other.data_size_ + 1);
+  }
+  for (unsigned i = 0; i < other.data_size_; ++i) {
+    data_[i] = other.data_[i];
+  }
+  std::copy(other.generations_.begin(),
+            other.generations_.begin() + other.data_size_,
+            generations_.begin());
+  data_size_ = other.data_size_;
+  id_max_ = other.id_max_;
+  dirty_ = other.dirty_;
+  for (unsigned i = 0; i < data_size_; ++i) {
+    if (data_[i].hole_) {
+      columns_.set_hole(i);
+    } else {
+      columns_.set(i, data_[i]);
+    }
+  }
+}
+
+void Particles::sync_modified_records() const {
+  for (unsigned index : modified_records_) {
+    if (index < data_size_ && !data_[index].hole_) {
+      columns_.set(index, data_[index]);
+    }
+    modified_flags_[index] = false;
+  }
+  modified_records_.clear();
+}
+
+void Particles::copy_columns_to_records() const {
+  for (unsigned i = 0; i < data_size_; ++i) {
+    if (columns_.is_particle(i)) {
+      data_[i].position_ = columns_.position(i);
+      data_[i].momentum_ = columns_.momentum(i);
+    }
+  }
+  records_current_ = true;
+}
+
 std::ostream &operator<<(std::ostream &out, const Particles &particles) {
+  particles.sync_records();
   out << particles.size() << " Particles:\n";
   for (unsigned i = 0; i < particles.data_size_; ++i) {
     const auto &p = particles.data_[i];
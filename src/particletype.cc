@@ -11,13 +11,20 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <atomic>
+#include <fstream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
+#include <boost/filesystem.hpp>
+
 #include "smash/constants.h"
 #include "smash/cxx14compat.h"
 #include "smash/decaymodes.h"
 #include "smash/distributions.h"
+#include "smash/filelock.h"
 #include "smash/formfactors.h"
 #include "smash/inputfunctions.h"
 #include "smash/integrate.h"
@@ -31,7 +38,9 @@
 #include "smash/potential_globals.h"
 #include "smash/pow.h"
 #include "smash/processbranch.h"
+#include "smash/random.h"
 #include "smash/stringfunctions.h"
+#include "smash/tabulation.h"
 
 namespace smash {
 static constexpr int LParticleType = LogArea::ParticleType::id;
@@ -52,6 +61,30 @@ ParticleTypePtrList anti_deltas_list;
 ParticleTypePtrList baryon_resonances_list;
 /// Global pointer to the Particle Type list of light nuclei
 ParticleTypePtrList light_nuclei_list;
+/// Tabulations of an unstable type, see ParticleType::enable_width_tabulation.
+struct ResonanceTabulation {
+  /// Total width as a function of \f$ \sqrt{m - m_{min}} \f$.
+  Tabulation width;
+  /**
+   * Normalized spectral function times \f$ dm/dt \f$ as a function of
+   * \f$ t = \arctan((m - m_0) / \Gamma_0) \f$, which is smooth also for
+   * narrow resonances. Empty if the width at the pole is below the cutoff.
+   */
+  Tabulation spectral_function;
+};
+/// Whether the widths and spectral functions are tabulated on first use.
+bool width_tabulation_enabled = false;
+/// Hash of the particle properties the tabulations are cached for.
+sha256::Hash width_tabulation_hash;
+/// Directory where the tabulations are cached.
+bf::path width_tabulation_path;
+/// Serializes the setup of the tabulations.
+std::mutex width_tabulation_mutex;
+/// Owns the tabulations, indexed like the Particle Type list.
+std::unique_ptr<const std::vector<ResonanceTabulation>> width_tabulations;
+/// Points to the tabulations once they are set up, nullptr before.
+std::atomic<const std::vector<ResonanceTabulation> *> width_tabulations_ready{
+    nullptr};
 }  // unnamed namespace
 
 const ParticleTypeList &ParticleType::list_all() {
@@ -206,6 +239,9 @@ void ParticleType::create_type_list(const std::string &input) {  // {{{
   static ParticleTypeList type_list;
   type_list.clear();  // in case LoadFailure was thrown and caught and we should
                       // try again
+  width_tabulation_enabled = false;
+  width_tabulations_ready = nullptr;
+  width_tabulations.reset();
   for (const Line &line : line_parser(input)) {
     std::istringstream lineinput(line.text);
     std::string name;
@@ -432,15 +468,132 @@ const DecayModes &ParticleType::decay_modes() const {
   return modes;
 }
 
+/**
+ * Set up the tabulations of the widths and spectral functions of all unstable
+ * types, see ParticleType::enable_width_tabulation.
+ *
+ * \param hash The hash of the particle properties.
+ * \param tabulations_path The directory where the tabulations are cached.
+ * \return The tabulations, indexed like the Particle Type list.
+ */
+static std::vector<ResonanceTabulation> tabulate_widths(
+    sha256::Hash hash, const bf::path &tabulations_path) {
+  // Number of intervals of each tabulation
+  constexpr size_t n_intervals = 1000;
+  constexpr double range = ParticleType::width_tabulation_range;
+  // See IsoParticleType::tabulate_integrals.
+  FileLock lock(tabulations_path / "tabulations.lock");
+  const bf::path &dir = lock.acquire() ? tabulations_path : "";
+  const bf::path path = dir / "resonances.bin";
+
+  // The file holds the tabulations of the unstable types in their order.
+  const ParticleTypeList &types = ParticleType::list_all();
+  std::vector<ResonanceTabulation> tabulations(types.size());
+  bool found = !dir.empty() && bf::exists(path);
+  if (found) {
+    std::ifstream file(path.string());
+    for (size_t i = 0; i < types.size() && found; i++) {
+      if (!types[i].is_stable()) {
+        tabulations[i].width = Tabulation::from_file(file, hash);
+        tabulations[i].spectral_function = Tabulation::from_file(file, hash);
+        found = !tabulations[i].width.is_empty() && file;
+      }
+    }
+  }
+  if (found) {
+    return tabulations;
+  }
+  logg[LParticleType].info("Tabulating widths and spectral functions...");
+  for (size_t i = 0; i < types.size(); i++) {
+    const ParticleType &ptype = types[i];
+    if (ptype.is_stable()) {
+      continue;
+    }
+    const double m_min = ptype.min_mass_kinematic();
+    const double x_max = std::sqrt(ptype.mass() + range - m_min);
+    tabulations[i].width = Tabulation(0., x_max, n_intervals, [&](double x) {
+      return ptype.total_width(m_min + x * x, WhichDecaymodes::All);
+    });
+    const double width = ptype.width_at_pole();
+    if (width < ParticleType::width_cutoff) {
+      continue;
+    }
+    const double t_min = std::atan((m_min - ptype.mass()) / width);
+    const double t_max = std::atan(range / width);
+    tabulations[i].spectral_function =
+        Tabulation(t_min, t_max - t_min, n_intervals, [&](double t) {
+          const double tant = std::tan(t);
+          const double jacobian = width * (1. + tant * tant);
+          return ptype.spectral_function(ptype.mass() + width * tant) *
+                 jacobian;
+        });
+  }
+  if (!dir.empty()) {
+    std::ofstream file(path.string());
+    for (size_t i = 0; i < types.size(); i++) {
+      if (!types[i].is_stable()) {
+        tabulations[i].width.write(file, hash);
+        tabulations[i].spectral_function.write(file, hash);
+      }
+    }
+  }
+  return tabulations;
+}
+
+/**
+ * Get the tabulations of the widths and spectral functions, which are set up
+ * on the first call after ParticleType::enable_width_tabulation.
+ *
+ * \return The tabulations, or nullptr if they are not enabled or currently
+ *         being set up by this thread.
+ */
+static const std::vector<ResonanceTabulation> *get_width_tabulations() {
+  const auto *tabulations =
+      width_tabulations_ready.load(std::memory_order_acquire);
+  if (tabulations != nullptr || !width_tabulation_enabled) {
+    return tabulations;
+  }
+  /* The setup evaluates widths and spectral functions (also those of the
+   * decay products), which have to be computed directly meanwhile. */
+  static thread_local bool in_setup = false;
+  if (in_setup) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> guard(width_tabulation_mutex);
+  tabulations = width_tabulations_ready.load(std::memory_order_acquire);
+  if (tabulations == nullptr) {
+    in_setup = true;
+    try {
+      width_tabulations = make_unique<const std::vector<ResonanceTabulation>>(
+          tabulate_widths(width_tabulation_hash, width_tabulation_path));
+    } catch (...) {
+      in_setup = false;
+      throw;
+    }
+    in_setup = false;
+    tabulations = width_tabulations.get();
+    width_tabulations_ready.store(tabulations, std::memory_order_release);
+  }
+  return tabulations;
+}
+
 double ParticleType::total_width(const double m) const {
   double w = 0.;
   if (is_stable()) {
     return w;
   }
-  /* Loop over decay modes and sum up all partial widths. */
-  const auto &modes = decay_modes().decay_mode_list();
-  for (unsigned int i = 0; i < modes.size(); i++) {
-    w = w + partial_width(m, modes[i].get());
+  const auto *tabulations = get_width_tabulations();
+  if (tabulations != nullptr && m >= min_mass_kinematic() &&
+      m <= mass() + width_tabulation_range) {
+    const auto offset = this - std::addressof(list_all()[0]);
+    w = (*tabulations)[offset].width.get_value_linear(
+        std::sqrt(m - min_mass_kinematic()));
+  } else {
+    /* Loop over decay modes and sum up all partial widths. */
+    const auto &modes = decay_modes().decay_mode_list();
+    for (unsigned int i = 0; i < modes.size(); i++) {
+      w = w + partial_width(m, modes[i].get());
+    }
   }
   if (w < width_cutoff) {
     return 0.;
@@ -448,6 +601,27 @@ double ParticleType::total_width(const double m) const {
   return w;
 }
 
+double ParticleType::total_width(const double m, WhichDecaymodes wh) const {
+  double w = 0.;
+  if (wh == WhichDecaymodes::Hadronic && is_stable()) {
+    return w;
+  }
+  /* Same order of the summation as in total_weight for the branches of
+   * get_partial_widths, such that the result is identical. */
+  for (const auto &mode : decay_modes().decay_mode_list()) {
+    const double partial = partial_width(m, mode.get());
+    if (partial > 0. && wanted_decaymode(mode->type(), wh)) {
+      w += partial;
+    }
+  }
+  return w;
+}
+
+bool ParticleType::potentials_affect_decays() {
+  return pot_pointer != nullptr &&
+         (UB_lat_pointer != nullptr || UI3_lat_pointer != nullptr);
+}
+
 void ParticleType::check_consistency() {
   for (const ParticleType &ptype : ParticleType::list_all()) {
     if (!ptype.is_stable() && ptype.decay_modes().is_empty()) {
@@ -457,9 +631,36 @@ void ParticleType::check_consistency() {
   }
 }
 
+void ParticleType::enable_width_tabulation(sha256::Hash hash,
+                                           const bf::path &tabulations_path) {
+  width_tabulations_ready = nullptr;
+  width_tabulations.reset();
+  width_tabulation_hash = hash;
+  width_tabulation_path = tabulations_path;
+  width_tabulation_enabled = true;
+}
+
+void ParticleType::prepare_for_multithreading() {
+  for (const ParticleType &ptype : ParticleType::list_all()) {
+    ptype.min_mass_kinematic();
+    ptype.min_mass_spectral();
+    ptype.isospin();
+    if (ptype.is_stable()) {
+      continue;
+    }
+    // normalizes the spectral function
+    ptype.spectral_function(ptype.mass());
+    for (const auto &mode : ptype.decay_modes().decay_mode_list()) {
+      mode->threshold();
+      // fills the tabulations of the decay type
+      mode->type().width(ptype.mass(), ptype.width_at_pole(), ptype.mass());
+    }
+  }
+}
+
 bool ParticleType::wanted_decaymode(const DecayType &t,
                                     WhichDecaymodes wh) const {
-  const auto FinalTypes = t.particle_types();
+  const auto &FinalTypes = t.particle_types();
   switch (wh) {
     case WhichDecaymodes::All: {
       return true;
@@ -492,10 +693,27 @@ bool ParticleType::wanted_decaymode(const DecayType &t,
 DecayBranchList ParticleType::get_partial_widths(const FourVector p,
                                                  const ThreeVector x,
                                                  WhichDecaymodes wh) const {
+  std::vector<double> widths;
+  get_partial_widths(p, x, wh, widths);
+  DecayBranchList partial;
+  partial.reserve(widths.size());
+  for (size_t i = 0; i < widths.size(); i++) {
+    if (widths[i] > 0.) {
+      partial.push_back(decay_branch(i, widths[i]));
+    }
+  }
+  return partial;
+}
+
+double ParticleType::get_partial_widths(const FourVector p,
+                                        const ThreeVector x,
+                                        WhichDecaymodes wh,
+                                        std::vector<double> &widths) const {
   const auto &decay_mode_list = decay_modes().decay_mode_list();
+  widths.assign(decay_mode_list.size(), 0.);
   if (decay_mode_list.size() == 0 ||
       (wh == WhichDecaymodes::Hadronic && is_stable())) {
-    return {};
+    return 0.;
   }
   /* Determine whether the decay is affected by the potentials. If it's
    * affected, read the values of the potentials at the position of the
@@ -508,34 +726,67 @@ DecayBranchList ParticleType::get_partial_widths(const FourVector p,
   if (UI3_lat_pointer != nullptr) {
     UI3_lat_pointer->value_at(x, UI3);
   }
+  /* The scale factors of the mother, those of the final states are stored
+   * with the decay types. */
+  double mother_scale_B = 0.0;
+  double mother_scale_I3 = 0.0;
+  if (pot_pointer != nullptr) {
+    const auto scale = pot_pointer->force_scale(*this);
+    mother_scale_B = scale.first;
+    mother_scale_I3 = scale.second * isospin3_rel();
+  }
   /* Loop over decay modes and calculate all partial widths. */
-  DecayBranchList partial;
-  partial.reserve(decay_mode_list.size());
-  for (unsigned int i = 0; i < decay_mode_list.size(); i++) {
+  double total = 0.;
+  for (size_t i = 0; i < decay_mode_list.size(); i++) {
+    const DecayType &type = decay_mode_list[i]->type();
+    if (!wanted_decaymode(type, wh)) {
+      continue;
+    }
     /* Calculate the sqare root s of the final state particles. */
-    const auto FinalTypes = decay_mode_list[i]->type().particle_types();
     double scale_B = 0.0;
     double scale_I3 = 0.0;
     if (pot_pointer != nullptr) {
-      scale_B += pot_pointer->force_scale(*this).first;
-      scale_I3 += pot_pointer->force_scale(*this).second * isospin3_rel();
-      for (const auto finaltype : FinalTypes) {
-        scale_B -= pot_pointer->force_scale(*finaltype).first;
-        scale_I3 -= pot_pointer->force_scale(*finaltype).second *
-                    finaltype->isospin3_rel();
-      }
+      scale_B = mother_scale_B - type.final_state_scale_B();
+      scale_I3 = mother_scale_I3 - type.final_state_scale_I3();
     }
-    double sqrt_s = (p + UB * scale_B + UI3 * scale_I3).abs();
+    const double sqrt_s = (p + UB * scale_B + UI3 * scale_I3).abs();
 
     const double w = partial_width(sqrt_s, decay_mode_list[i].get());
     if (w > 0.) {
-      if (wanted_decaymode(decay_mode_list[i]->type(), wh)) {
-        partial.push_back(
-            make_unique<DecayBranch>(decay_mode_list[i]->type(), w));
+      widths[i] = w;
+      total += w;
+    }
+  }
+  return total;
+}
+
+DecayBranchPtr ParticleType::decay_branch(size_t i, double width) const {
+  return make_unique<DecayBranch>(decay_modes().decay_mode_list()[i]->type(),
+                                  width);
+}
+
+DecayBranchPtr ParticleType::choose_decay_branch(
+    const std::vector<double> &widths, double total_width) const {
+  /* Same selection as in Action::choose_channel for the branches of all
+   * modes. */
+  const double random_weight = random::uniform(0., total_width);
+  double weight_sum = 0.;
+  size_t last = widths.size();
+  for (size_t i = 0; i < widths.size(); i++) {
+    if (widths[i] > 0.) {
+      weight_sum += widths[i];
+      last = i;
+      if (random_weight <= weight_sum) {
+        return decay_branch(i, widths[i]);
       }
     }
   }
-  return partial;
+  if (last == widths.size()) {
+    throw std::invalid_argument("No open decay mode of " + name() +
+                                " to choose from.");
+  }
+  // Only reached due to rounding if total_width is not exactly the sum.
+  return decay_branch(last, widths[last]);
 }
 
 double ParticleType::get_partial_width(const double m, const ParticleType &t_a,
@@ -575,10 +826,22 @@ double ParticleType::get_partial_in_width(const double m,
 }
 
 double ParticleType::spectral_function(double m) const {
+  const auto *tabulations = get_width_tabulations();
+  if (tabulations != nullptr && m >= min_mass_kinematic() &&
+      m <= mass() + width_tabulation_range) {
+    const auto offset = this - std::addressof(list_all()[0]);
+    const Tabulation &tabulation = (*tabulations)[offset].spectral_function;
+    if (!tabulation.is_empty()) {
+      const double width = width_at_pole();
+      const double x = (m - mass()) / width;
+      return tabulation.get_value_linear(std::atan(x)) /
+             (width * (1. + x * x));
+    }
+  }
   if (norm_factor_ < 0.) {
     /* Initialize the normalization factor
      * by integrating over the unnormalized spectral function. */
-    static /*thread_local (see #3075)*/ Integrator integrate;
+    static thread_local Integrator integrate;
     const double width = width_at_pole();
     const double m_pole = mass();
     // We transform the integral using m = m_min + width_pole * tan(x), to
@@ -9,6 +9,8 @@
 
 #include "smash/propagation.h"
 
+#include <cmath>
+
 #include "smash/boxmodus.h"
 #include "smash/collidermodus.h"
 #include "smash/listmodus.h"
@@ -41,45 +43,68 @@ double calc_hubble(double time, const ExpansionProperties &metric) {
   return h;
 }
 
+double propagate_straight_line(ParticleData &data, double to_time,
+                               const std::vector<FourVector> &beam_momentum) {
+  const double dt = to_time - data.position().x0();
+  assert(dt >= 0.0);
+  /* "Frozen Fermi motion": Fermi momenta are only used for collisions,
+   * but not for propagation. This is done to avoid nucleus flying apart
+   * even if potentials are off. Initial nucleons before the first collision
+   * are propagated only according to beam momentum.
+   * Initial nucleons are distinguished by data.id() < the size of
+   * beam_momentum, which is by default zero except for the collider modus
+   * with the fermi motion == frozen.
+   * todo(m. mayer): improve this condition (see comment #11 issue #4213)*/
+  assert(data.id() >= 0);
+  const bool avoid_fermi_motion =
+      (static_cast<uint64_t>(data.id()) <
+       static_cast<uint64_t>(beam_momentum.size())) &&
+      (data.get_history().collisions_per_particle == 0);
+  ThreeVector v;
+  if (avoid_fermi_motion) {
+    const FourVector vbeam = beam_momentum[data.id()];
+    v = vbeam.velocity();
+  } else {
+    v = data.velocity();
+  }
+  const FourVector distance = FourVector(0.0, v * dt);
+  logg[LPropagation].debug("Particle ", data, " motion: ", distance);
+  FourVector position = data.position() + distance;
+  position.set_x0(to_time);
+  data.set_4position(position);
+  return dt;
+}
+
 double propagate_straight_line(Particles *particles, double to_time,
                                const std::vector<FourVector> &beam_momentum) {
   bool negative_dt_error = false;
   double dt = 0.0;
-  for (ParticleData &data : *particles) {
-    const double t0 = data.position().x0();
-    dt = to_time - t0;
+  particles->update_columns([&](ParticleColumns &columns, unsigned i) {
+    dt = to_time - columns.t[i];
     if (dt < 0.0 && !negative_dt_error) {
       // Print error message once, not for every particle
       negative_dt_error = true;
       logg[LPropagation].error("propagate_straight_line - negative dt = ", dt);
     }
     assert(dt >= 0.0);
-    /* "Frozen Fermi motion": Fermi momenta are only used for collisions,
-     * but not for propagation. This is done to avoid nucleus flying apart
-     * even if potentials are off. Initial nucleons before the first collision
-     * are propagated only according to beam momentum.
-     * Initial nucleons are distinguished by data.id() < the size of
-     * beam_momentum, which is by default zero except for the collider modus
-     * with the fermi motion == frozen.
-     * todo(m. mayer): improve this condition (see comment #11 issue #4213)*/
-    assert(data.id() >= 0);
-    const bool avoid_fermi_motion =
-        (static_cast<uint64_t>(data.id()) <
-         static_cast<uint64_t>(beam_momentum.size())) &&
-        (data.get_history().collisions_per_particle == 0);
+    /* "Frozen Fermi motion" for the initial nucleons, see the
+     * propagate_straight_line of a single particle. */
+    const int32_t id = columns.id[i];
+    assert(id >= 0);
     ThreeVector v;
-    if (avoid_fermi_motion) {
-      const FourVector vbeam = beam_momentum[data.id()];
-      v = vbeam.velocity();
+    if (static_cast<uint64_t>(id) <
+            static_cast<uint64_t>(beam_momentum.size()) &&
+        particles->history(i).collisions_per_particle == 0) {
+      v = beam_momentum[id].velocity();
     } else {
-      v = data.velocity();
+      v = columns.momentum(i).velocity();
     }
     const FourVector distance = FourVector(0.0, v * dt);
-    logg[LPropagation].debug("Particle ", data, " motion: ", distance);
-    FourVector position = data.position() + distance;
+    logg[LPropagation].debug("Particle ", id, " motion: ", distance);
+    FourVector position = columns.position(i) + distance;
     position.set_x0(to_time);
-    data.set_4position(position);
-  }
+    columns.set_position(i, position);
+  });
   return dt;
 }
 
@@ -87,28 +112,25 @@ void expand_space_time(Particles *particles,
                        const ExperimentParameters &parameters,
                        const ExpansionProperties &metric) {
   const double dt = parameters.labclock->timestep_duration();
-  for (ParticleData &data : *particles) {
+  const double h = calc_hubble(parameters.labclock->current_time(), metric);
+  particles->update_columns([&](ParticleColumns &columns, unsigned i) {
     // Momentum and position modification to ensure appropriate expansion
-    const double h = calc_hubble(parameters.labclock->current_time(), metric);
-    FourVector delta_mom = FourVector(0.0, h * data.momentum().threevec() * dt);
-    FourVector expan_dist =
-        FourVector(0.0, h * data.position().threevec() * dt);
+    const FourVector position = columns.position(i);
+    const FourVector momentum = columns.momentum(i);
+    FourVector delta_mom = FourVector(0.0, h * momentum.threevec() * dt);
+    FourVector expan_dist = FourVector(0.0, h * position.threevec() * dt);
 
-    logg[LPropagation].debug("Particle ", data,
+    logg[LPropagation].debug("Particle ", columns.id[i],
                              " expansion motion: ", expan_dist);
     // New position and momentum
-    FourVector position = data.position() + expan_dist;
-    FourVector momentum = data.momentum() - delta_mom;
-
-    // set the new momentum and position variables
-    data.set_4position(position);
-    data.set_4momentum(momentum);
+    columns.set_position(i, position + expan_dist);
     // force the on shell condition to ensure correct energy
-    data.set_4momentum(data.pole_mass(), data.momentum().threevec());
-  }
+    columns.set_momentum(i, columns.type[i]->mass(),
+                         (momentum - delta_mom).threevec());
+  });
 }
 
-void update_momenta(
+double update_momenta(
     Particles *particles, double dt, const Potentials &pot,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FB_lat,
     RectangularLattice<std::pair<ThreeVector, ThreeVector>> *FI3_lat) {
@@ -121,13 +143,14 @@ void update_momenta(
   std::pair<ThreeVector, ThreeVector> FB, FI3;
   double min_time_scale = std::numeric_limits<double>::infinity();
 
-  for (ParticleData &data : *particles) {
+  particles->update_columns([&](ParticleColumns &columns, unsigned i) {
+    const ParticleType &type = *columns.type[i];
     // Only baryons and nuclei will be affected by the potentials
-    if (!(data.is_baryon() || data.is_nucleus())) {
-      continue;
+    if (!(type.is_baryon() || type.is_nucleus())) {
+      return;
     }
-    const auto scale = pot.force_scale(data.type());
-    const ThreeVector r = data.position().threevec();
+    const auto scale = pot.force_scale(type);
+    const ThreeVector r = columns.position(i).threevec();
     /* Lattices can be used for calculation if 1-2 are fulfilled:
      * 1) Required lattices are not nullptr - possibly_use_lattice
      * 2) r is not out of required lattices */
@@ -146,25 +169,30 @@ void update_momenta(
       FB = std::make_pair(std::get<0>(tmp), std::get<1>(tmp));
       FI3 = std::make_pair(std::get<2>(tmp), std::get<3>(tmp));
     }
+    const FourVector momentum = columns.momentum(i);
     const ThreeVector Force =
         scale.first *
-            (FB.first + data.momentum().velocity().cross_product(FB.second)) +
-        scale.second * data.type().isospin3_rel() *
-            (FI3.first + data.momentum().velocity().cross_product(FI3.second));
+            (FB.first + momentum.velocity().cross_product(FB.second)) +
+        scale.second * type.isospin3_rel() *
+            (FI3.first + momentum.velocity().cross_product(FI3.second));
     logg[LPropagation].debug("Update momenta: F [GeV/fm] = ", Force);
-    data.set_4momentum(data.effective_mass(),
-                       data.momentum().threevec() + Force * dt);
+    double mass = columns.effective_mass[i];
+    if (std::isnan(mass)) {
+      // Throws like ParticleData::effective_mass for spacelike momenta.
+      mass = momentum.abs();
+    }
+    columns.set_momentum(i, mass, momentum.threevec() + Force * dt);
 
     // calculate the time scale of the change in momentum
     const double Force_abs = Force.abs();
     if (Force_abs < really_small) {
-      continue;
+      return;
     }
-    const double time_scale = data.momentum().x0() / Force_abs;
+    const double time_scale = columns.e[i] / Force_abs;
     if (time_scale < min_time_scale) {
       min_time_scale = time_scale;
     }
-  }
+  });
 
   // warn if the time step is too big
   constexpr double safety_factor = 0.1;
@@ -174,6 +202,7 @@ void update_momenta(
         << "with potentials. Maximum safe value: "
         << safety_factor * min_time_scale << " fm/c.";
   }
+  return min_time_scale;
 }
 
 }  // namespace smash
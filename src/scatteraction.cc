@@ -165,22 +165,16 @@ double ScatterAction::cm_momentum_squared() const {
   return pCM_sqr(sqrt_s(), m1, m2);
 }
 
-double ScatterAction::transverse_distance_sqr() const {
-  // local copy of particles (since we need to boost them)
-  ParticleData p_a = incoming_particles_[0];
-  ParticleData p_b = incoming_particles_[1];
-  /* Boost particles to center-of-momentum frame. */
-  const ThreeVector velocity = beta_cm();
-  p_a.boost(velocity);
-  p_b.boost(velocity);
+double ScatterAction::transverse_distance_sqr(const ParticleData &p_a,
+                                              const ParticleData &p_b) {
+  /* Boost the four-vectors to the center-of-momentum frame. */
+  const ThreeVector velocity = (p_a.momentum() + p_b.momentum()).velocity();
   const ThreeVector pos_diff =
-      p_a.position().threevec() - p_b.position().threevec();
+      p_a.position().lorentz_boost(velocity).threevec() -
+      p_b.position().lorentz_boost(velocity).threevec();
   const ThreeVector mom_diff =
-      p_a.momentum().threevec() - p_b.momentum().threevec();
-
-  logg[LScatterAction].debug("Particle ", incoming_particles_,
-                             " position difference [fm]: ", pos_diff,
-                             ", momentum difference [GeV]: ", mom_diff);
+      p_a.momentum().lorentz_boost(velocity).threevec() -
+      p_b.momentum().lorentz_boost(velocity).threevec();
 
   const double dp2 = mom_diff.sqr();
   const double dr2 = pos_diff.sqr();
@@ -10,6 +10,7 @@
 #include "smash/scatteractionphoton.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "smash/angles.h"
 #include "smash/constants.h"
@@ -29,13 +30,14 @@ static constexpr int LScatterAction = LogArea::ScatterAction::id;
 
 ScatterActionPhoton::ScatterActionPhoton(
     const ParticleList &in, const double time, const int n_frac_photons,
-    const double hadronic_cross_section_input)
+    const double hadronic_cross_section_input, const ComputationMethod method)
     : ScatterAction(in[0], in[1], time),
       reac_(photon_reaction_type(in)),
       number_of_fractional_photons_(n_frac_photons),
       hadron_out_t_(outgoing_hadron_type(in)),
       hadron_out_mass_(sample_out_hadron_mass(hadron_out_t_)),
-      hadronic_cross_section_(hadronic_cross_section_input) {}
+      hadronic_cross_section_(hadronic_cross_section_input),
+      computation_method_(method) {}
 
 ScatterActionPhoton::ReactionType ScatterActionPhoton::photon_reaction_type(
     const ParticleList &in) {
@@ -91,15 +93,18 @@ ScatterActionPhoton::ReactionType ScatterActionPhoton::photon_reaction_type(
 }
 
 void ScatterActionPhoton::perform_photons(const OutputsList &outputs) {
-  for (int i = 0; i < number_of_fractional_photons_; i++) {
-    generate_final_state();
-    for (const auto &output : outputs) {
-      if (output->is_photon_output()) {
-        // we do not care about the local density
-        output->at_interaction(*this, 0.0);
-      }
+  std::vector<OutputInterface *> photon_outputs;
+  for (const auto &output : outputs) {
+    if (output->is_photon_output()) {
+      photon_outputs.push_back(output.get());
     }
   }
+  sample_photons(number_of_fractional_photons_, [&]() {
+    for (OutputInterface *output : photon_outputs) {
+      // we do not care about the local density
+      output->at_interaction(*this, 0.0);
+    }
+  });
 }
 
 ParticleTypePtr ScatterActionPhoton::outgoing_hadron_type(
@@ -192,6 +197,11 @@ bool ScatterActionPhoton::is_kinematically_possible(const double s_sqrt,
 }
 
 void ScatterActionPhoton::generate_final_state() {
+  sample_photons(1, []() {});
+}
+
+template <typename F>
+void ScatterActionPhoton::sample_photons(int n_photons, F &&sampled) {
   // we have only one reaction per incoming particle pair
   if (collision_processes_photons_.size() != 1) {
     logg[LScatterAction].fatal()
@@ -229,56 +239,67 @@ void ScatterActionPhoton::generate_final_state() {
   const double pcm_in = cm_momentum();
   const double pcm_out = pCM(sqrts, m_out, 0.0);
 
-  const double t = random::uniform(t1, t2);
-
-  double costheta = (t - pow_int(m2, 2) +
-                     0.5 * (s + pow_int(m2, 2) - pow_int(m1, 2)) *
-                         (s - pow_int(m_out, 2)) / s) /
-                    (pcm_in * (s - pow_int(m_out, 2)) / sqrts);
-
-  // on very rare occasions near the kinematic threshold numerical issues give
-  // unphysical angles.
-  if (costheta > 1 || costheta < -1) {
-    logg[LScatterAction].warn()
-        << "Cos(theta)of photon scattering out of physical bounds in "
-           "the following scattering: "
-        << incoming_particles_ << "Clamping to [-1,1].";
-    if (costheta > 1.0)
-      costheta = 1.0;
-    if (costheta < -1.0)
-      costheta = -1.0;
-  }
-  Angles phitheta(random::uniform(0.0, twopi), costheta);
-  outgoing_particles_[0].set_4momentum(hadron_out_mass_,
-                                       phitheta.threevec() * pcm_out);
-  outgoing_particles_[1].set_4momentum(0.0, -phitheta.threevec() * pcm_out);
-
-  // Set positions & boost to computational frame.
-  for (ParticleData &new_particle : outgoing_particles_) {
-    new_particle.set_4position(middle_point);
-    new_particle.boost_momentum(-beta_cm());
-  }
+  // The parts of cos(theta) which do not depend on t, see below.
+  const double m2_sqr = pow_int(m2, 2);
+  const double costheta_offset =
+      0.5 * (s + m2_sqr - pow_int(m1, 2)) * (s - pow_int(m_out, 2)) / s;
+  const double costheta_norm = pcm_in * (s - pow_int(m_out, 2)) / sqrts;
 
-  const double E_Photon = outgoing_particles_[1].momentum()[0];
+  const ThreeVector beta = beta_cm();
 
   // if rho in final state take already sampled mass (same as m_out). If rho is
   // incoming take the mass of the incoming particle
   const double m_rho = rho_mass();
 
-  // compute the differential cross section with form factor included
-  const double diff_xs = diff_cross_section_w_ff(t, m_rho, E_Photon);
+  for (int i = 0; i < n_photons; i++) {
+    const double t = random::uniform(t1, t2);
+
+    double costheta = (t - m2_sqr + costheta_offset) / costheta_norm;
+
+    // on very rare occasions near the kinematic threshold numerical issues
+    // give unphysical angles.
+    if (costheta > 1 || costheta < -1) {
+      logg[LScatterAction].warn()
+          << "Cos(theta)of photon scattering out of physical bounds in "
+             "the following scattering: "
+          << incoming_particles_ << "Clamping to [-1,1].";
+      if (costheta > 1.0)
+        costheta = 1.0;
+      if (costheta < -1.0)
+        costheta = -1.0;
+    }
+    Angles phitheta(random::uniform(0.0, twopi), costheta);
+    outgoing_particles_[0].set_4momentum(hadron_out_mass_,
+                                         phitheta.threevec() * pcm_out);
+    outgoing_particles_[1].set_4momentum(0.0, -phitheta.threevec() * pcm_out);
+
+    // Set positions & boost to computational frame.
+    for (ParticleData &new_particle : outgoing_particles_) {
+      new_particle.set_4position(middle_point);
+      new_particle.boost_momentum(-beta);
+    }
 
-  // Weighing of the fractional photons
-  if (number_of_fractional_photons_ > 1) {
-    weight_ = diff_xs * (t2 - t1) /
-              (number_of_fractional_photons_ * hadronic_cross_section());
-  } else {
-    weight_ = proc->weight() / hadronic_cross_section();
+    const double E_Photon = outgoing_particles_[1].momentum()[0];
+
+    // compute the differential cross section with form factor included
+    const double diff_xs = diff_cross_section_w_ff(t, m_rho, E_Photon);
+
+    // Weighing of the fractional photons
+    if (number_of_fractional_photons_ > 1) {
+      weight_ = diff_xs * (t2 - t1) /
+                (number_of_fractional_photons_ * hadronic_cross_section());
+    } else {
+      weight_ = proc->weight() / hadronic_cross_section();
+    }
+    /* Photons are not really part of the normal processes, so we have to set
+     * a constant arbitrary number. The final states only differ in the
+     * directions of the momenta, so it is enough to check the first one. */
+    if (i == 0) {
+      const auto id_process = ID_PROCESS_PHOTON;
+      Action::check_conservation(id_process);
+    }
+    sampled();
   }
-  // Photons are not really part of the normal processes, so we have to set a
-  // constant arbitrary number.
-  const auto id_process = ID_PROCESS_PHOTON;
-  Action::check_conservation(id_process);
 }
 
 void ScatterActionPhoton::add_dummy_hadronic_process(
@@ -331,18 +352,11 @@ double ScatterActionPhoton::rho_mass() const {
   }
 }
 
-CollisionBranchList ScatterActionPhoton::photon_cross_sections(
-    MediatorType mediator) {
-  CollisionBranchList process_list;
-  CrosssectionsPhoton<ComputationMethod::Analytic> xs_object;
-
-  static ParticleTypePtr photon_particle = &ParticleType::find(pdg::photon);
-
-  const double s = mandelstam_s();
-  // the mass of the mediating particle depends on the channel. For an incoming
-  // rho it is the mass of the incoming particle, for an outgoing rho it is the
-  // sampled mass
-  const double m_rho = rho_mass();
+template <ComputationMethod method>
+double ScatterActionPhoton::cross_section_by(const double s,
+                                             const double m_rho,
+                                             MediatorType mediator) const {
+  CrosssectionsPhoton<method> xs_object;
   double xsection = 0.0;
 
   switch (reac_) {
@@ -398,6 +412,25 @@ CollisionBranchList ScatterActionPhoton::photon_cross_sections(
       break;
   }
 
+  return xsection;
+}
+
+CollisionBranchList ScatterActionPhoton::photon_cross_sections(
+    MediatorType mediator) {
+  CollisionBranchList process_list;
+
+  static ParticleTypePtr photon_particle = &ParticleType::find(pdg::photon);
+
+  const double s = mandelstam_s();
+  // the mass of the mediating particle depends on the channel. For an incoming
+  // rho it is the mass of the incoming particle, for an outgoing rho it is the
+  // sampled mass
+  const double m_rho = rho_mass();
+  double xsection =
+      computation_method_ == ComputationMethod::Lookup
+          ? cross_section_by<ComputationMethod::Lookup>(s, m_rho, mediator)
+          : cross_section_by<ComputationMethod::Analytic>(s, m_rho, mediator);
+
   // Due to numerical reasons it can happen that the calculated cross sections
   // are negative (approximately -1e-15) if sqrt(s) is close to the threshold
   // energy. In those cases the cross section is manually set to 0.1 mb, which
@@ -418,9 +451,21 @@ double ScatterActionPhoton::diff_cross_section(const double t,
                                                const double m_rho,
                                                MediatorType mediator) const {
   const double s = mandelstam_s();
+  return computation_method_ == ComputationMethod::Lookup
+             ? diff_cross_section_by<ComputationMethod::Lookup>(s, t, m_rho,
+                                                                mediator)
+             : diff_cross_section_by<ComputationMethod::Analytic>(s, t, m_rho,
+                                                                  mediator);
+}
+
+template <ComputationMethod method>
+double ScatterActionPhoton::diff_cross_section_by(const double s,
+                                                  const double t,
+                                                  const double m_rho,
+                                                  MediatorType mediator) const {
   double diff_xsection = 0.0;
 
-  CrosssectionsPhoton<ComputationMethod::Analytic> xs_object;
+  CrosssectionsPhoton<method> xs_object;
 
   switch (reac_) {
     case ReactionType::pi_p_pi_m_rho_z:
@@ -10,9 +10,12 @@
 #include "smash/scatteractionsfinder.h"
 
 #include <algorithm>
+#include <limits>
 #include <map>
+#include <unordered_set>
 #include <vector>
 
+#include "smash/collisioncandidates.h"
 #include "smash/configuration.h"
 #include "smash/constants.h"
 #include "smash/crosssections.h"
@@ -23,12 +26,34 @@
 #include "smash/logging.h"
 #include "smash/macros.h"
 #include "smash/particles.h"
+#include "smash/potential_globals.h"
 #include "smash/scatteraction.h"
 #include "smash/scatteractionphoton.h"
 #include "smash/stringfunctions.h"
 
 namespace smash {
 static constexpr int LFindScatter = LogArea::FindScatter::id;
+
+namespace {
+/// Memory for the batched search of collision candidates
+struct CandidateBuffers {
+  /// Particles of the search list
+  ParticleBatch search;
+  /// Particles of the neighbors list
+  ParticleBatch neighbors;
+  /// Candidates for the current particle of the search list
+  std::vector<unsigned char> marks;
+};
+
+/**
+ * \return the buffers of the calling thread, which are reused by all its
+ *         searches.
+ */
+CandidateBuffers &candidate_buffers() {
+  static thread_local CandidateBuffers buffers;
+  return buffers;
+}
+}  // namespace
 /*!\Userguide
  * \page input_collision_term_ Collision_Term
  * \key Collision_Criterion (string, optional, default = "Geometric") \n
@@ -41,6 +66,18 @@ static constexpr int LFindScatter = LogArea::FindScatter::id;
  * Babovsky, W. Cassing, U. Mosel, H. G. Reusch, and K. Weber, J. Comp. Phys.
  * 106, 391 (1993).
  *
+ * \key Stochastic_Pair_Sampling (bool, optional, default = \key false) \n
+ * Only used with the stochastic criterion. If enabled, the candidate pairs
+ * of a cell are drawn with an upper bound of their collision probability and
+ * accepted with the ratio of the actual probability to the bound, instead of
+ * checking all pairs. The collision probabilities are the same, but the cost
+ * per cell is proportional to the number of collisions instead of the
+ * squared number of particles. The bound assumes the constant elastic cross
+ * section, so the option is only valid for the setups supported by the
+ * stochastic criterion (see above). All pairs are checked in cells where the
+ * bound exceeds 1/2. Note that the sampled collisions differ from the ones
+ * without the option for the same random seed.
+ *
  * \key Elastic_Cross_Section (double, optional, default = -1.0 [mb]) \n
  * If a non-negative value is given, it will override the parametrized
  * elastic cross sections (which are energy-dependent) with a constant value.
@@ -49,6 +86,30 @@ static constexpr int LFindScatter = LogArea::FindScatter::id;
  * \key Isotropic (bool, optional, default = \key false) \n
  * Do all collisions isotropically.
  *
+ * \key Cross_Section_Envelope (bool, optional, default = \key false) \n
+ * Reject pairs in the geometric collision criterion by an upper bound of
+ * their total cross section before computing it. The bound is tabulated
+ * for each pair of species as a function of \f$\sqrt{s}\f$, when it is
+ * needed for the first time. It is found by sampling the cross section and
+ * applying a safety factor of 1.5. The pairs within this margin get their
+ * full cross section computed, which checks the bound: a cross section above
+ * it raises the bound and is reported as a warning, since a collision could
+ * have been missed. It is not used if potentials affect the thresholds.
+ *
+ * \key Cross_Section_Mode (string, optional, default = "Direct") \n
+ * How the partial cross sections of a pair are obtained:
+ * \li \key "Direct" - Compute them for every pair.
+ * \li \key "Tabulated" - Interpolate them in tables of the pairs of stable
+ * species, which are filled at their first use. Pairs of unstable or
+ * off-shell particles are computed directly, as well as all pairs if
+ * potentials are used.
+ * \li \key "Validated" - Compute them directly, but also interpolate them
+ * and report the deviations between both at the end.
+ *
+ * \key Cross_Section_Accuracy (double, optional, default = 0.001) \n
+ * Relative spacing in \f$\sqrt{s}\f$ of the nodes of the cross-section
+ * tables. In the validated mode, deviations larger than this are counted.
+ *
  * \key Elastic_NN_Cutoff_Sqrts (double, optional, default = 1.98): \n
  * The elastic collisions betwen two nucleons with sqrt_s below
  * Elastic_NN_Cutoff_Sqrts, in GeV, cannot happen. \n
@@ -249,7 +310,11 @@ ScatterActionsFinder::ScatterActionsFinder(
       N_tot_(N_tot),
       N_proj_(N_proj),
       string_formation_time_(config.take(
-          {"Collision_Term", "String_Parameters", "Formation_Time"}, 1.)) {
+          {"Collision_Term", "String_Parameters", "Formation_Time"}, 1.)),
+      xs_mode_(config.take({"Collision_Term", "Cross_Section_Mode"},
+                           CrossSectionMode::Direct)),
+      stochastic_pair_sampling_(
+          config.take({"Collision_Term", "Stochastic_Pair_Sampling"}, false)) {
   if (coll_crit_ == CollisionCriterion::Stochastic &&
       !(is_constant_elastic_isotropic())) {
     throw std::invalid_argument(
@@ -283,11 +348,72 @@ ScatterActionsFinder::ScatterActionsFinder(
         subconfig.take({"Separate_Fragment_Baryon"}, true),
         subconfig.take({"Popcorn_Rate"}, 0.15));
   }
+  if (config.take({"Collision_Term", "Cross_Section_Envelope"}, false) &&
+      coll_crit_ == CollisionCriterion::Geometric &&
+      !is_constant_elastic_isotropic()) {
+    xs_envelope_ = make_unique<CrossSectionEnvelope>(
+        [this](const ParticleData& data_a, const ParticleData& data_b) {
+          ScatterAction act(data_a, data_b, 0., isotropic_,
+                            string_formation_time_);
+          if (strings_switch_) {
+            act.set_string_interface(string_process_interface_.get());
+          }
+          act.add_all_scatterings(elastic_parameter_, two_to_one_, incl_set_,
+                                  low_snn_cut_, strings_switch_, use_AQM_,
+                                  strings_with_probability_, nnbar_treatment_);
+          return act.cross_section();
+        });
+  }
+  if (xs_mode_ != CrossSectionMode::Direct &&
+      !is_constant_elastic_isotropic()) {
+    xs_tables_ = make_unique<CrossSectionTables>(
+        [this](const ParticleData& data_a, const ParticleData& data_b) {
+          ScatterAction act(data_a, data_b, 0., isotropic_,
+                            string_formation_time_);
+          if (strings_switch_) {
+            act.set_string_interface(string_process_interface_.get());
+          }
+          act.add_all_scatterings(elastic_parameter_, two_to_one_, incl_set_,
+                                  low_snn_cut_, strings_switch_, use_AQM_,
+                                  strings_with_probability_, nnbar_treatment_);
+          CollisionBranchList branches;
+          for (const auto& branch : act.collision_channels()) {
+            branches.emplace_back(make_unique<CollisionBranch>(
+                branch->particle_types(), branch->weight(),
+                branch->get_type()));
+          }
+          return branches;
+        },
+        config.take({"Collision_Term", "Cross_Section_Accuracy"}, 1e-3));
+  }
+}
+
+void ScatterActionsFinder::add_scatterings(ScatterAction& act) const {
+  const ParticleList& incoming = act.incoming_particles();
+  if (!xs_tables_ || UB_lat_pointer != nullptr ||
+      UI3_lat_pointer != nullptr ||
+      !xs_tables_->covers(incoming[0], incoming[1])) {
+    act.add_all_scatterings(elastic_parameter_, two_to_one_, incl_set_,
+                            low_snn_cut_, strings_switch_, use_AQM_,
+                            strings_with_probability_, nnbar_treatment_);
+    return;
+  }
+  CollisionBranchList tabulated = xs_tables_->collision_list(
+      incoming[0].type(), incoming[1].type(), act.sqrt_s());
+  if (xs_mode_ == CrossSectionMode::Validated) {
+    act.add_all_scatterings(elastic_parameter_, two_to_one_, incl_set_,
+                            low_snn_cut_, strings_switch_, use_AQM_,
+                            strings_with_probability_, nnbar_treatment_);
+    xs_tables_->validate(tabulated, act.collision_channels(), act.sqrt_s());
+  } else {
+    act.add_collisions(std::move(tabulated));
+  }
 }
 
 ActionPtr ScatterActionsFinder::check_collision(
     const ParticleData& data_a, const ParticleData& data_b, double dt,
-    const std::vector<FourVector>& beam_momentum, const double cell_vol) const {
+    const std::vector<FourVector>& beam_momentum, const double cell_vol,
+    const double candidate_probability) const {
   /* If the two particles
    * 1) belong to the two colliding nuclei
    * 2) are within the same nucleus
@@ -312,6 +438,48 @@ ActionPtr ScatterActionsFinder::check_collision(
     return nullptr;
   }
 
+  /* Cheap checks on the particles alone come first, such that the action
+   * is only created for pairs that can still collide. */
+  double distance_squared = 0.;
+  const bool use_envelope = xs_envelope_ && UB_lat_pointer == nullptr &&
+                            UI3_lat_pointer == nullptr;
+  if (coll_crit_ == CollisionCriterion::Stochastic) {
+    // No grid or search in cell
+    if (cell_vol < really_small) {
+      return nullptr;
+    }
+  } else if (coll_crit_ == CollisionCriterion::Geometric) {
+    // just collided with this particle
+    if (data_a.id_process() > 0 && data_a.id_process() == data_b.id_process()) {
+      logg[LFindScatter].debug("Skipping collided particles at time ",
+                               data_a.position().x0(), " due to process ",
+                               data_a.id_process(), "\n    ", data_a, "\n<-> ",
+                               data_b);
+
+      return nullptr;
+    }
+
+    distance_squared = ScatterAction::transverse_distance_sqr(data_a, data_b);
+
+    // Don't calculate cross section if the particles are very far apart.
+    if (distance_squared >= max_transverse_distance_sqr(testparticles_)) {
+      return nullptr;
+    }
+
+    // Nor if they are farther apart than their cross section could allow.
+    if (use_envelope) {
+      const double sqrt_s = (data_a.momentum() + data_b.momentum()).abs();
+      const double max_xs =
+          xs_envelope_->upper_bound(data_a.type(), data_b.type(), sqrt_s);
+      if (distance_squared >=
+          max_xs * fm2_mb * M_1_PI / static_cast<double>(testparticles_) *
+              data_a.xsec_scaling_factor(time_until_collision) *
+              data_b.xsec_scaling_factor(time_until_collision)) {
+        return nullptr;
+      }
+    }
+  }
+
   // Create ScatterAction object.
   ScatterActionPtr act = make_unique<ScatterAction>(
       data_a, data_b, time_until_collision, isotropic_, string_formation_time_);
@@ -321,15 +489,8 @@ ActionPtr ScatterActionsFinder::check_collision(
   }
 
   if (coll_crit_ == CollisionCriterion::Stochastic) {
-    // No grid or search in cell
-    if (cell_vol < really_small) {
-      return nullptr;
-    }
-
     // Add various subprocesses.
-    act->add_all_scatterings(elastic_parameter_, two_to_one_, incl_set_,
-                             low_snn_cut_, strings_switch_, use_AQM_,
-                             strings_with_probability_, nnbar_treatment_);
+    add_scatterings(*act);
 
     const double xs = act->cross_section() * fm2_mb;
 
@@ -362,33 +523,21 @@ ActionPtr ScatterActionsFinder::check_collision(
 
     // probability criterion
     double random_no = random::uniform(0., 1.);
-    if (random_no > p_22) {
+    if (random_no * candidate_probability > p_22) {
       return nullptr;
     }
 
   } else if (coll_crit_ == CollisionCriterion::Geometric) {
-    // just collided with this particle
-    if (data_a.id_process() > 0 && data_a.id_process() == data_b.id_process()) {
-      logg[LFindScatter].debug("Skipping collided particles at time ",
-                               data_a.position().x0(), " due to process ",
-                               data_a.id_process(), "\n    ", data_a, "\n<-> ",
-                               data_b);
-
-      return nullptr;
-    }
-
-    const double distance_squared = act->transverse_distance_sqr();
+    // Add various subprocesses.
+    add_scatterings(*act);
 
-    // Don't calculate cross section if the particles are very far apart.
-    if (distance_squared >= max_transverse_distance_sqr(testparticles_)) {
-      return nullptr;
+    // The bound of the envelope is sampled, so check it with every pair.
+    if (use_envelope) {
+      xs_envelope_->verify(data_a.type(), data_b.type(),
+                           std::sqrt(act->mandelstam_s()),
+                           act->cross_section());
     }
 
-    // Add various subprocesses.
-    act->add_all_scatterings(elastic_parameter_, two_to_one_, incl_set_,
-                             low_snn_cut_, strings_switch_, use_AQM_,
-                             strings_with_probability_, nnbar_treatment_);
-
     // Cross section for collision criterion
     double cross_section_criterion = act->cross_section() * fm2_mb * M_1_PI /
                                      static_cast<double>(testparticles_);
@@ -412,9 +561,37 @@ ActionPtr ScatterActionsFinder::check_collision(
 }
 
 ActionList ScatterActionsFinder::find_actions_in_cell(
-    const ParticleList& search_list, double dt, const double cell_vol,
+    const ParticleListView& search_list, double dt, const double cell_vol,
     const std::vector<FourVector>& beam_momentum) const {
   std::vector<ActionPtr> actions;
+  if (coll_crit_ == CollisionCriterion::Geometric) {
+    /* Only the pairs passing the cuts on the collision time and the
+     * transverse distance in the batched search are checked in detail. */
+    CandidateBuffers& buffers = candidate_buffers();
+    const ParticleBatch& batch = buffers.search;
+    buffers.search.assign(search_list, beam_momentum);
+    const double max_distance_sqr = max_transverse_distance_sqr(testparticles_);
+    for (std::size_t i = 0; i < batch.size(); i++) {
+      batch.mark_candidates(batch, i, dt, max_distance_sqr, buffers.marks);
+      const ParticleData& p1 = batch[i];
+      for (std::size_t j = 0; j < batch.size(); j++) {
+        if (buffers.marks[j] && p1.id() < batch[j].id()) {
+          ActionPtr act =
+              check_collision(p1, batch[j], dt, beam_momentum, cell_vol);
+          if (act) {
+            actions.push_back(std::move(act));
+          }
+        }
+      }
+    }
+    return actions;
+  }
+  if (coll_crit_ == CollisionCriterion::Stochastic &&
+      stochastic_pair_sampling_ &&
+      sample_stochastic_collisions(search_list, dt, cell_vol, beam_momentum,
+                                   actions)) {
+    return actions;
+  }
   for (const ParticleData& p1 : search_list) {
     for (const ParticleData& p2 : search_list) {
       if (p1.id() < p2.id()) {
@@ -429,21 +606,85 @@ ActionList ScatterActionsFinder::find_actions_in_cell(
   return actions;
 }
 
+bool ScatterActionsFinder::sample_stochastic_collisions(
+    const ParticleListView& search_list, double dt, double cell_vol,
+    const std::vector<FourVector>& beam_momentum,
+    std::vector<ActionPtr>& actions) const {
+  const std::size_t n = search_list.size();
+  if (n < 2 || cell_vol < really_small) {
+    return true;
+  }
+  /* The relative velocity of two particles, sqrt((v_1 - v_2)^2 - (v_1 x
+   * v_2)^2), is at most the sum of their speeds. The cross section is the
+   * constant elastic one, see is_constant_elastic_isotropic. */
+  double max_speed = 0.;
+  for (const ParticleData& p : search_list) {
+    max_speed = std::max(max_speed, p.momentum().velocity().abs());
+  }
+  const double max_probability = elastic_parameter_ * fm2_mb *
+                                 std::min(2., 2. * max_speed) * dt /
+                                 (cell_vol * testparticles_);
+  const uint64_t n_pairs = static_cast<uint64_t>(n) * (n - 1) / 2;
+  /* Drawing distinct pairs becomes inefficient if a large fraction of them
+   * is needed. */
+  if (max_probability > 0.5 ||
+      n_pairs > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+    return false;
+  }
+  if (max_probability <= 0.) {
+    return true;
+  }
+  const int n_candidates =
+      random::binomial(static_cast<int>(n_pairs), max_probability);
+  std::unordered_set<uint64_t> drawn;
+  drawn.reserve(n_candidates);
+  while (drawn.size() < static_cast<std::size_t>(n_candidates)) {
+    // Uniform among the ordered pairs and thus among the unordered ones
+    std::size_t i = random::uniform_int<std::size_t>(0, n - 1);
+    std::size_t j = random::uniform_int<std::size_t>(0, n - 2);
+    if (j >= i) {
+      ++j;
+    } else {
+      std::swap(i, j);
+    }
+    if (!drawn.insert(static_cast<uint64_t>(i) * n + j).second) {
+      continue;
+    }
+    ActionPtr act = check_collision(search_list[i], search_list[j], dt,
+                                    beam_momentum, cell_vol, max_probability);
+    if (act) {
+      actions.push_back(std::move(act));
+    }
+  }
+  return true;
+}
+
 ActionList ScatterActionsFinder::find_actions_with_neighbors(
-    const ParticleList& search_list, const ParticleList& neighbors_list,
-    double dt, const std::vector<FourVector>& beam_momentum) const {
+    const ParticleListView& search_list,
+    const ParticleListView& neighbors_list, double dt,
+    const std::vector<FourVector>& beam_momentum) const {
   std::vector<ActionPtr> actions;
   if (coll_crit_ == CollisionCriterion::Stochastic) {
     // Only search in cells
     return actions;
   }
-  for (const ParticleData& p1 : search_list) {
-    for (const ParticleData& p2 : neighbors_list) {
-      assert(p1.id() != p2.id());
+  CandidateBuffers& buffers = candidate_buffers();
+  buffers.search.assign(search_list, beam_momentum);
+  buffers.neighbors.assign(neighbors_list, beam_momentum);
+  const ParticleBatch& search = buffers.search;
+  const ParticleBatch& neighbors = buffers.neighbors;
+  const double max_distance_sqr = max_transverse_distance_sqr(testparticles_);
+  for (std::size_t i = 0; i < search.size(); i++) {
+    neighbors.mark_candidates(search, i, dt, max_distance_sqr, buffers.marks);
+    for (std::size_t j = 0; j < neighbors.size(); j++) {
+      assert(search[i].id() != neighbors[j].id());
       // Check if a collision is possible.
-      ActionPtr act = check_collision(p1, p2, dt, beam_momentum);
-      if (act) {
-        actions.push_back(std::move(act));
+      if (buffers.marks[j]) {
+        ActionPtr act = check_collision(search[i], neighbors[j], dt,
+                                        beam_momentum);
+        if (act) {
+          actions.push_back(std::move(act));
+        }
       }
     }
   }
@@ -14,6 +14,8 @@
 
 #include <boost/filesystem/fstream.hpp>
 
+#include "smash/crosssectionsbrems.h"
+#include "smash/crosssectionsphoton.h"
 #include "smash/cxx14compat.h"
 #include "smash/decaymodes.h"
 #include "smash/experiment.h"
@@ -385,8 +387,20 @@ void initialize_particles_and_decays(Configuration &configuration,
                                      sha256::Hash hash,
                                      bf::path tabulations_path) {
   initialize_particles_and_decays(configuration);
+  ParticleType::enable_width_tabulation(hash, tabulations_path);
+  set_brems_tabulations_path(tabulations_path);
   logg[LMain].info("Tabulating cross section integrals...");
   IsoParticleType::tabulate_integrals(hash, tabulations_path);
+  if (configuration.has_value(
+          {"Collision_Term", "Photons", "Cross_Sections"})) {
+    const ComputationMethod method =
+        configuration.read({"Collision_Term", "Photons", "Cross_Sections"});
+    if (method == ComputationMethod::Lookup) {
+      logg[LMain].info("Tabulating photon cross sections...");
+      CrosssectionsPhoton<ComputationMethod::Lookup>::tabulate(
+          hash, tabulations_path);
+    }
+  }
 }
 
 }  // unnamed namespace
@@ -65,3 +65,39 @@ TEST(construct_and_insert) {
 
   VERIFY(actions.is_empty());
 }
+
+TEST(remove_invalid) {
+  Particles particles;
+  const ParticleData a = particles.insert(Test::smashon(
+      Test::Momentum{0.2, 0., .1, 0.}, Test::Position{0., 1., .9, 1.}));
+  const ParticleData b = particles.insert(Test::smashon(
+      Test::Momentum{0.2, 0., .1, 0.}, Test::Position{0., 2., .9, 1.}));
+  const ParticleData c = particles.insert(Test::smashon(
+      Test::Momentum{0.2, 0., .1, 0.}, Test::Position{0., 3., .9, 1.}));
+
+  ActionList action_vec;
+  action_vec.push_back(make_unique<DecayAction>(a, 3.));
+  action_vec.push_back(make_unique<DecayAction>(b, 1.));
+  action_vec.push_back(make_unique<DecayAction>(c, 2.));
+  action_vec.push_back(make_unique<DecayAction>(b, 4.));
+  Actions actions(std::move(action_vec));
+  COMPARE(actions.remove_invalid(particles), 0u);
+  COMPARE(actions.size(), 4u);
+
+  // An elastic collision changes the process id of b.
+  ParticleData b_after = b;
+  b_after.set_history(1, 1, ProcessType::Elastic, 0., ParticleList{});
+  particles.update_particle(b, b_after);
+  VERIFY(!particles.is_valid(b));
+  // Moving a particle keeps its copies valid.
+  ParticleData c_after = c;
+  c_after.set_4position(FourVector(1., 3.2, .9, 1.));
+  particles.update_particle(c, c_after);
+  VERIFY(particles.is_valid(c));
+
+  COMPARE(actions.remove_invalid(particles), 2u);
+  COMPARE(actions.size(), 2u);
+  COMPARE(actions.pop()->time_of_execution(), 2.);
+  COMPARE(actions.pop()->time_of_execution(), 3.);
+  VERIFY(actions.is_empty());
+}
@@ -0,0 +1,67 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "../include/smash/adaptivetimestep.h"
+
+using namespace smash;
+
+TEST(defaults) {
+  Configuration config("General: {}");
+  const AdaptiveTimeStep adaptive(config, 0.5, 4.);
+  COMPARE(adaptive.min_timestep(), 0.05);
+  COMPARE(adaptive.max_timestep(), 5.);
+}
+
+TEST(follows_actions) {
+  Configuration config(
+      "General:\n"
+      "  Adaptive_Time_Step:\n"
+      "    Min_Delta_Time: 0.1\n"
+      "    Max_Delta_Time: 10.0\n"
+      "    Actions_Per_Particle: 0.2\n"
+      "    Max_Change: 4.0\n");
+  const AdaptiveTimeStep adaptive(config, 1., 4.);
+  TimeStepMeasurements measured;
+  measured.actions_per_particle = 0.1;
+  COMPARE(adaptive.next_timestep(1., measured), 2.);
+  measured.actions_per_particle = 0.4;
+  COMPARE(adaptive.next_timestep(1., measured), 0.5);
+  // the change per step is limited
+  measured.actions_per_particle = 100.;
+  COMPARE(adaptive.next_timestep(1., measured), 0.25);
+  measured.actions_per_particle = 0.;
+  COMPARE(adaptive.next_timestep(1., measured), 4.);
+  // and so is the size
+  COMPARE(adaptive.next_timestep(8., measured), 10.);
+  measured.actions_per_particle = 100.;
+  COMPARE(adaptive.next_timestep(0.2, measured), 0.1);
+}
+
+TEST(limited_by_density_and_forces) {
+  Configuration config("General: {}");
+  const AdaptiveTimeStep adaptive(config, 1., 4.);
+  TimeStepMeasurements measured;
+  measured.actions_per_particle = 0.1;
+  // mean free time 1 / (0.125 fm^-3 * 4 fm^2) = 2 fm
+  measured.max_density = 0.125;
+  COMPARE(adaptive.next_timestep(3., measured), 2.);
+  measured.force_time_scale = 10.;
+  COMPARE(adaptive.next_timestep(3., measured), 1.);
+}
+
+TEST_CATCH(invalid_bounds, std::invalid_argument) {
+  Configuration config(
+      "General:\n"
+      "  Adaptive_Time_Step:\n"
+      "    Min_Delta_Time: 1.0\n"
+      "    Max_Delta_Time: 0.5\n");
+  AdaptiveTimeStep adaptive(config, 1., 4.);
+}
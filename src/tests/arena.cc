@@ -0,0 +1,88 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "../include/smash/arena.h"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace smash;
+
+TEST(aligned) {
+  std::vector<void *> memory;
+  for (std::size_t size : {1, 3, 8, 17, 100, 1000}) {
+    memory.push_back(Arena::allocate(size));
+    const auto address = reinterpret_cast<std::uintptr_t>(memory.back());
+    COMPARE(address % alignof(std::max_align_t), 0u);
+  }
+  for (void *ptr : memory) {
+    Arena::deallocate(ptr);
+  }
+  Arena::deallocate(nullptr);
+}
+
+TEST(memory_is_recycled) {
+  std::vector<void *> first;
+  for (int i = 0; i < 1000; i++) {
+    first.push_back(Arena::allocate(64));
+  }
+  for (void *ptr : first) {
+    Arena::deallocate(ptr);
+  }
+  const Arena::Statistics before = Arena::statistics();
+  // All objects were released, so the same memory is used again.
+  std::vector<void *> second;
+  for (int i = 0; i < 1000; i++) {
+    second.push_back(Arena::allocate(64));
+  }
+  COMPARE(second, first);
+  const Arena::Statistics after = Arena::statistics();
+  COMPARE(after.allocations, before.allocations + 1000);
+  COMPARE(after.reserved_bytes, before.reserved_bytes);
+  VERIFY(after.recycled_chunks > before.recycled_chunks);
+  for (void *ptr : second) {
+    Arena::deallocate(ptr);
+  }
+}
+
+TEST(live_objects_are_kept) {
+  void *kept = Arena::allocate(64);
+  *static_cast<int *>(kept) = 42;
+  // Fill several chunks, releasing everything else.
+  for (std::size_t i = 0; i < 4 * Arena::chunk_size / 1024; i++) {
+    Arena::deallocate(Arena::allocate(1000));
+  }
+  COMPARE(*static_cast<int *>(kept), 42);
+  Arena::deallocate(kept);
+}
+
+TEST(large_objects_on_heap) {
+  const Arena::Statistics before = Arena::statistics();
+  void *large = Arena::allocate(Arena::chunk_size);
+  COMPARE(Arena::statistics().heap_allocations, before.heap_allocations + 1);
+  Arena::deallocate(large);
+}
+
+TEST(release_in_other_thread) {
+  std::vector<void *> memory;
+  std::thread allocating([&]() {
+    for (int i = 0; i < 100; i++) {
+      memory.push_back(Arena::allocate(32));
+    }
+  });
+  allocating.join();
+  // The arena of the thread is gone, its chunk is freed with the last object.
+  for (void *ptr : memory) {
+    Arena::deallocate(ptr);
+  }
+  VERIFY(Arena::statistics().allocations >= 100u);
+}
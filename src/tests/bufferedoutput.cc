@@ -0,0 +1,105 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "setup.h"
+
+#include <string>
+#include <vector>
+
+#include "../include/smash/bufferedoutput.h"
+#include "../include/smash/clock.h"
+#include "../include/smash/wallcrossingaction.h"
+
+using namespace smash;
+
+namespace {
+/// Output that logs the calls it receives.
+class LoggingOutput : public OutputInterface {
+ public:
+  explicit LoggingOutput(std::string name) : OutputInterface(name) {}
+
+  void at_eventstart(const Particles &particles,
+                     const int event_number) override {
+    log.push_back("start " + std::to_string(event_number) + " " +
+                  ids_of(particles));
+  }
+  void at_eventend(const Particles &particles, const int event_number,
+                   double impact_parameter, bool empty_event) override {
+    log.push_back("end " + std::to_string(event_number) + " " +
+                  ids_of(particles) + " " + std::to_string(impact_parameter) +
+                  " " + std::to_string(empty_event));
+  }
+  void at_interaction(const Action &action, const double density) override {
+    log.push_back("interaction " +
+                  std::to_string(static_cast<int>(action.get_type())) + " " +
+                  std::to_string(action.incoming_particles()[0].id()) + " " +
+                  std::to_string(density));
+  }
+  void at_intermediate_time(const Particles &particles,
+                            const std::unique_ptr<Clock> &clock,
+                            const DensityParameters &) override {
+    log.push_back("intermediate " + std::to_string(clock->current_time()) +
+                  " " + ids_of(particles));
+  }
+
+  std::vector<std::string> log;
+
+ private:
+  static std::string ids_of(const Particles &particles) {
+    std::string ids;
+    for (const auto &p : particles) {
+      ids += std::to_string(p.id());
+    }
+    return ids;
+  }
+};
+}  // namespace
+
+TEST(init_particle_types) { Test::create_smashon_particletypes(); }
+
+TEST(replay_in_order) {
+  Particles particles;
+  particles.create(3, 0x661);
+  const ExperimentParameters par = Test::default_parameters();
+  const DensityParameters dens_par(par);
+
+  LoggingOutput direct("Particles");
+  BufferedOutput buffer(direct);
+  for (OutputInterface *output :
+       std::vector<OutputInterface *>{&direct, &buffer}) {
+    output->at_eventstart(particles, 2);
+    const std::unique_ptr<Clock> clock = make_unique<UniformClock>(1.5, 0.1);
+    output->at_intermediate_time(particles, clock, dens_par);
+    WallcrossingAction action(particles.front(), particles.front());
+    output->at_interaction(action, 0.25);
+    output->at_eventend(particles, 2, 3.0, true);
+  }
+  // changes after recording do not affect the buffer
+  particles.remove(particles.front());
+
+  VERIFY(!buffer.empty());
+  LoggingOutput replayed("Particles");
+  buffer.replay(replayed);
+  VERIFY(buffer.empty());
+  COMPARE(replayed.log.size(), 4u);
+  COMPARE(replayed.log, direct.log);
+}
+
+TEST(kind_of_output) {
+  LoggingOutput dileptons("Dileptons");
+  LoggingOutput photons("Photons");
+  LoggingOutput particles("Particles");
+  VERIFY(BufferedOutput(dileptons).is_dilepton_output());
+  VERIFY(BufferedOutput(photons).is_photon_output());
+  VERIFY(!BufferedOutput(particles).is_dilepton_output());
+  VERIFY(!BufferedOutput(particles).is_photon_output());
+  VERIFY(!BufferedOutput(particles).is_IC_output());
+}
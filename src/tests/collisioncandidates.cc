@@ -0,0 +1,103 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "setup.h"
+
+#include "../include/smash/collisioncandidates.h"
+#include "../include/smash/fpenvironment.h"
+#include "../include/smash/scatteraction.h"
+
+using namespace smash;
+using smash::Test::Momentum;
+using smash::Test::Position;
+
+TEST(init_particle_types) { Test::create_smashon_particletypes(); }
+
+/// Collision time as in ScatterActionsFinder::collision_time
+static double collision_time(const ParticleData &p1, const ParticleData &p2) {
+  const FourVector p1_mom = p1.momentum(), p2_mom = p2.momentum();
+  const ThreeVector dv_times_e1e2 =
+      p1_mom.threevec() * p2_mom.x0() - p2_mom.threevec() * p1_mom.x0();
+  const double dv_times_e1e2_sqr = dv_times_e1e2.sqr();
+  if (dv_times_e1e2_sqr < really_small) {
+    return -1.0;
+  }
+  const ThreeVector dr = p1.position().threevec() - p2.position().threevec();
+  return -(dr * dv_times_e1e2) *
+         (p1_mom.x0() * p2_mom.x0() / dv_times_e1e2_sqr);
+}
+
+TEST(same_as_scalar_criterion) {
+  /* The vectorized loop evaluates all expressions for every pair, which must
+   * not raise floating-point exceptions. */
+  setup_default_float_traps();
+  constexpr double dt = 1.;
+  constexpr double max_distance_sqr = 2.;
+  ParticleList list;
+  for (int i = 0; i < 300; i++) {
+    const double x = random::uniform(-3., 3.), y = random::uniform(-3., 3.),
+                 z = random::uniform(-3., 3.);
+    ParticleData p = Test::smashon(Position{1., x, y, z}, i);
+    p.set_4momentum(Test::smashon_mass, random::uniform(-1., 1.),
+                    random::uniform(-1., 1.), random::uniform(-1., 1.));
+    list.push_back(p);
+  }
+  // A pair without relative motion
+  const Momentum at_rest{Test::smashon_mass, 0., 0., 0.};
+  list.push_back(Test::smashon(Position{1., 0., 0., 0.}, at_rest, 300));
+  list.push_back(Test::smashon(Position{1., 0.1, 0., 0.}, at_rest, 301));
+
+  ParticleBatch batch;
+  batch.assign(list, {});
+  COMPARE(batch.size(), list.size());
+  std::vector<unsigned char> marks;
+  int candidates = 0, collisions = 0;
+  for (std::size_t i = 0; i < list.size(); i++) {
+    batch.mark_candidates(batch, i, dt, max_distance_sqr, marks);
+    COMPARE(marks.size(), list.size());
+    for (std::size_t j = 0; j < list.size(); j++) {
+      COMPARE(&batch[j], &list[j]);
+      if (i == j) {
+        continue;
+      }
+      const double time = collision_time(list[i], list[j]);
+      const bool collides =
+          time >= 0. && time < dt &&
+          ScatterAction::transverse_distance_sqr(list[i], list[j]) <
+              max_distance_sqr;
+      if (collides) {
+        VERIFY(marks[j]) << i << ' ' << j;
+        collisions++;
+      }
+      candidates += marks[j];
+    }
+  }
+  VERIFY(collisions > 0);
+  // Only pairs extremely close to the limits are marked in addition.
+  COMPARE(candidates, collisions);
+}
+
+TEST(beam_momentum_for_collision_time) {
+  // The particles move apart, but their beam momenta point to each other.
+  const ParticleList list = {
+      Test::smashon(Position{0., -0.5, 0., 0.}, Momentum{1., -0.5, 0., 0.}, 0),
+      Test::smashon(Position{0., 0.5, 0., 0.}, Momentum{1., 0.5, 0., 0.}, 1)};
+  const std::vector<FourVector> beam_momentum = {FourVector(1., 0.5, 0., 0.),
+                                                 FourVector(1., -0.5, 0., 0.)};
+  std::vector<unsigned char> marks;
+  ParticleBatch batch;
+  batch.assign(list, {});
+  batch.mark_candidates(batch, 0, 2., 1., marks);
+  VERIFY(!marks[1]);
+  batch.assign(list, beam_momentum);
+  batch.mark_candidates(batch, 0, 2., 1., marks);
+  VERIFY(marks[1]);
+}
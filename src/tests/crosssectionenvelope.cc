@@ -0,0 +1,111 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "../include/smash/crosssectionenvelope.h"
+
+#include <cmath>
+#include <limits>
+
+#include "../include/smash/particletype.h"
+
+using namespace smash;
+
+TEST(init_particle_types) {
+  ParticleType::create_type_list(
+      "# NAME MASS[GEV] WIDTH[GEV] PARITY PDG\n"
+      "η1⁰ 0.400 -1.0 + 10661\n"
+      "η2⁰ 0.600 -1.0 + 20661\n"
+      "η3⁰ 1.200 0.01 + 30661");
+}
+
+/// A narrow peak at the mass of η3 on top of a constant background [mb]
+static double peaked_xs(double sqrt_s) {
+  const double x = (sqrt_s - 1.2) / 0.005;
+  return 1. + 10. / (1. + x * x);
+}
+
+static double sqrt_s_of(const ParticleData &a, const ParticleData &b) {
+  return (a.momentum() + b.momentum()).abs();
+}
+
+TEST(bounds_cross_section) {
+  const ParticleType &eta1 = ParticleType::find(0x10661);
+  const ParticleType &eta2 = ParticleType::find(0x20661);
+  CrossSectionEnvelope envelope(
+      [](const ParticleData &a, const ParticleData &b) {
+        return peaked_xs(sqrt_s_of(a, b));
+      });
+  // The threshold is 1 GeV, the table ends at ~147 GeV.
+  for (double sqrt_s = 1.; sqrt_s < 5.; sqrt_s += 0.0007) {
+    const double bound = envelope.upper_bound(eta1, eta2, sqrt_s);
+    VERIFY(bound >= peaked_xs(sqrt_s)) << sqrt_s;
+    VERIFY(bound <= 1.5 * 11.) << sqrt_s;
+  }
+  const double bound_at_peak = envelope.upper_bound(eta1, eta2, 1.2);
+  COMPARE_RELATIVE_ERROR(bound_at_peak, 1.5 * 11., 1e-12);
+  COMPARE(envelope.upper_bound(eta1, eta2, 200.),
+          std::numeric_limits<double>::infinity());
+}
+
+TEST(symmetric_and_lazy) {
+  const ParticleType &eta1 = ParticleType::find(0x10661);
+  const ParticleType &eta2 = ParticleType::find(0x20661);
+  int n_evaluations = 0;
+  CrossSectionEnvelope envelope(
+      [&](const ParticleData &a, const ParticleData &b) {
+        ++n_evaluations;
+        // not symmetric on purpose, to check that one order is used
+        return a.type().mass() + 0.1 * sqrt_s_of(a, b);
+      },
+      1.);
+  const double bound = envelope.upper_bound(eta1, eta2, 2.);
+  const int n_first = n_evaluations;
+  VERIFY(n_first > 0);
+  COMPARE(envelope.upper_bound(eta2, eta1, 2.), bound);
+  COMPARE(n_evaluations, n_first);
+  // the upper edge of the bin gives the largest value
+  VERIFY(bound >= 0.4 + 0.2);
+  VERIFY(bound <= 0.4 + 0.2 * 1.005);
+}
+
+TEST(verify_raises_bound) {
+  const ParticleType &eta1 = ParticleType::find(0x10661);
+  const ParticleType &eta2 = ParticleType::find(0x20661);
+  // A spike between the sampled points of its bin is missed by the sampling.
+  CrossSectionEnvelope envelope(
+      [](const ParticleData &, const ParticleData &) { return 1.; });
+  const double sqrt_s = 2.;
+  COMPARE(envelope.upper_bound(eta1, eta2, sqrt_s), 1.5);
+  VERIFY(envelope.verify(eta1, eta2, sqrt_s, 1.2));
+  COMPARE_RELATIVE_ERROR(envelope.upper_bound(eta1, eta2, sqrt_s), 1.8,
+                         1e-12);
+  COMPARE(envelope.violations(), 0u);
+  VERIFY(!envelope.verify(eta2, eta1, sqrt_s, 4.));
+  COMPARE(envelope.upper_bound(eta1, eta2, sqrt_s), 6.);
+  COMPARE(envelope.violations(), 1u);
+  // a smaller cross section does not lower the bound
+  VERIFY(envelope.verify(eta1, eta2, sqrt_s, 0.5));
+  COMPARE(envelope.upper_bound(eta1, eta2, sqrt_s), 6.);
+}
+
+TEST(non_finite_sample_is_unbounded) {
+  const ParticleType &eta1 = ParticleType::find(0x10661);
+  const ParticleType &eta2 = ParticleType::find(0x20661);
+  // not defined close to the threshold
+  CrossSectionEnvelope envelope(
+      [](const ParticleData &a, const ParticleData &b) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        return sqrt_s_of(a, b) < 1.003 ? nan : 1.;
+      });
+  COMPARE(envelope.upper_bound(eta1, eta2, 1.001),
+          std::numeric_limits<double>::infinity());
+  VERIFY(std::isfinite(envelope.upper_bound(eta1, eta2, 2.)));
+}
@@ -0,0 +1,121 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "../include/smash/crosssectiontables.h"
+
+#include <cmath>
+
+#include "../include/smash/cxx14compat.h"
+#include "../include/smash/kinematics.h"
+#include "../include/smash/particletype.h"
+
+using namespace smash;
+
+TEST(init_particle_types) {
+  ParticleType::create_type_list(
+      "# NAME MASS[GEV] WIDTH[GEV] PARITY PDG\n"
+      "η1⁰ 0.400 -1.0 + 10661\n"
+      "η2⁰ 0.600 -1.0 + 20661\n"
+      "η3⁰ 1.000 -1.0 + 30661\n"
+      "η4⁰ 1.200 0.1 + 40661");
+}
+
+static int n_calls = 0;
+
+/**
+ * Elastic scattering with a smooth cross section and an inelastic channel,
+ * which opens at 1.4 GeV.
+ */
+static CollisionBranchList fake_collisions(const ParticleData &a,
+                                           const ParticleData &b) {
+  n_calls++;
+  const double sqrt_s = (a.momentum() + b.momentum()).abs();
+  const ParticleType &eta1 = ParticleType::find(0x10661);
+  const ParticleType &eta3 = ParticleType::find(0x30661);
+  CollisionBranchList list;
+  list.emplace_back(make_unique<CollisionBranch>(a.type(), b.type(),
+                                                 10. / sqrt_s,
+                                                 ProcessType::Elastic));
+  if (sqrt_s > 1.4) {
+    list.emplace_back(make_unique<CollisionBranch>(
+        eta1, eta3, 2. * (sqrt_s - 1.4), ProcessType::TwoToTwo));
+  }
+  return list;
+}
+
+static ParticleData on_shell(const ParticleType &type, double p_z) {
+  ParticleData data{type};
+  data.set_4momentum(type.mass(), 0., 0., p_z);
+  return data;
+}
+
+TEST(covers) {
+  const ParticleType &eta1 = ParticleType::find(0x10661);
+  const ParticleType &eta2 = ParticleType::find(0x20661);
+  const ParticleType &eta4 = ParticleType::find(0x40661);
+  CrossSectionTables tables(fake_collisions, 1e-3);
+  const double p_cm = pCM(2., eta1.mass(), eta2.mass());
+  VERIFY(tables.covers(on_shell(eta1, p_cm), on_shell(eta2, -p_cm)));
+  // unstable particles
+  VERIFY(!tables.covers(on_shell(eta1, p_cm), on_shell(eta4, -p_cm)));
+  // off-shell particles
+  ParticleData off_shell{eta2};
+  off_shell.set_4momentum(0.65, 0., 0., -p_cm);
+  VERIFY(!tables.covers(on_shell(eta1, p_cm), off_shell));
+  // right above the threshold
+  const double p_threshold = pCM(1.0001, eta1.mass(), eta2.mass());
+  VERIFY(!tables.covers(on_shell(eta1, p_threshold),
+                        on_shell(eta2, -p_threshold)));
+  COMPARE(n_calls, 0);
+}
+
+TEST(interpolation) {
+  const ParticleType &eta1 = ParticleType::find(0x10661);
+  const ParticleType &eta2 = ParticleType::find(0x20661);
+  CrossSectionTables tables(fake_collisions, 1e-3);
+  for (double sqrt_s = 1.002; sqrt_s < 3.; sqrt_s += 0.0013) {
+    const CollisionBranchList tabulated =
+        tables.collision_list(eta1, eta2, sqrt_s);
+    const CollisionBranchList direct =
+        fake_collisions(on_shell(eta1, pCM(sqrt_s, 0.4, 0.6)),
+                        on_shell(eta2, -pCM(sqrt_s, 0.4, 0.6)));
+    VERIFY(tabulated.size() == direct.size() || std::abs(sqrt_s - 1.4) < 0.01)
+        << sqrt_s;
+    COMPARE_RELATIVE_ERROR(total_weight(tabulated), total_weight(direct),
+                           std::abs(sqrt_s - 1.4) < 0.01 ? 1e-2 : 1e-5)
+        << sqrt_s;
+    VERIFY(tables.validate(tabulated, direct, sqrt_s) <
+           (std::abs(sqrt_s - 1.4) < 0.01 ? 1e-2 : 1e-5))
+        << sqrt_s;
+    for (const auto &branch : tabulated) {
+      VERIFY(branch->threshold() < sqrt_s);
+    }
+  }
+}
+
+TEST(nodes_are_computed_once) {
+  const ParticleType &eta1 = ParticleType::find(0x10661);
+  const ParticleType &eta2 = ParticleType::find(0x20661);
+  CrossSectionTables tables(fake_collisions, 1e-3);
+  n_calls = 0;
+  tables.collision_list(eta1, eta2, 2.);
+  COMPARE(n_calls, 2);
+  tables.collision_list(eta1, eta2, 2.);
+  tables.collision_list(eta1, eta2, 2.0001);
+  COMPARE(n_calls, 2);
+  // the other order of the pair is tabulated separately
+  tables.collision_list(eta2, eta1, 2.);
+  COMPARE(n_calls, 4);
+}
+
+TEST_CATCH(invalid_step, std::invalid_argument) {
+  CrossSectionTables tables(fake_collisions, 0.);
+}
@@ -126,3 +126,60 @@ TEST(create_decayaction) {
   const auto act = make_unique<DecayAction>(H, time_of_execution);
   std::cout << *act << std::endl;
 }
+
+TEST(cached_hadronic_width) {
+  ParticleData H{ParticleType::find(0x50661)};
+  const auto widths_from_branches = [&H]() {
+    return total_weight<DecayBranch>(H.type().get_partial_widths(
+        H.momentum(), H.position().threevec(), WhichDecaymodes::Hadronic));
+  };
+  H.set_4momentum(4.0, ThreeVector(1.0, 0.0, 0.0));
+  const double width = widths_from_branches();
+  VERIFY(width > 0.);
+  COMPARE(H.hadronic_width(), width);
+  COMPARE(H.type().total_width(H.momentum().abs(), WhichDecaymodes::Hadronic),
+          width);
+  // copies give the same width
+  const ParticleData copy = H;
+  COMPARE(copy.hadronic_width(), width);
+  // and recomputed for a different mass
+  H.set_4momentum(3.5, ThreeVector(1.0, 0.0, 0.0));
+  VERIFY(widths_from_branches() != width);
+  COMPARE(H.hadronic_width(), widths_from_branches());
+}
+
+TEST(partial_widths_buffer) {
+  ParticleData H{ParticleType::find(0x50661)};
+  H.set_4momentum(4.0, ThreeVector(1.0, 0.0, 0.0));
+  const ParticleType &type = H.type();
+  const DecayBranchList branches = type.get_partial_widths(
+      H.momentum(), H.position().threevec(), WhichDecaymodes::All);
+  // The buffer is resized, stale values are overwritten.
+  std::vector<double> widths(7, 1.);
+  const double width = type.get_partial_widths(
+      H.momentum(), H.position().threevec(), WhichDecaymodes::All, widths);
+  COMPARE(widths.size(), type.decay_modes().decay_mode_list().size());
+  COMPARE(width, total_weight<DecayBranch>(branches));
+  size_t n = 0;
+  for (size_t i = 0; i < widths.size(); i++) {
+    if (widths[i] > 0.) {
+      COMPARE(widths[i], branches[n]->weight());
+      COMPARE(&type.decay_branch(i, widths[i])->type(), &branches[n]->type());
+      n++;
+    }
+  }
+  COMPARE(n, branches.size());
+
+  // The decay that was chosen is performed.
+  for (int i = 0; i < 10; i++) {
+    DecayBranchPtr branch = type.choose_decay_branch(widths, width);
+    const size_t n_out = branch->particle_number();
+    const double partial_width = branch->weight();
+    DecayAction act(H, 0.);
+    act.add_chosen_decay(std::move(branch), width);
+    COMPARE(act.total_width(), width);
+    act.generate_final_state();
+    COMPARE(act.outgoing_particles().size(), n_out);
+    COMPARE(act.get_partial_weight(), partial_width);
+  }
+}
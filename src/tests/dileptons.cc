@@ -10,6 +10,7 @@
 #include "setup.h"
 
 #include "../include/smash/decayactiondilepton.h"
+#include "../include/smash/decayactionsfinderdilepton.h"
 
 using namespace smash;
 
@@ -21,6 +22,7 @@ TEST(init_particle_types) {
       "# NAME MASS[GEV] WIDTH[GEV] PARITY PDG\n"
       "π  0.138  7.7e-9 - 111 211\n"
       "η  0.548 1.31e-6 - 221\n"
+      "ρ  0.776 0.149   - 113 213\n"
       "e⁻ 0.000511 0    +  11\n"
       "γ  0        0    +  22\n");
 }
@@ -36,7 +38,11 @@ TEST(init_decay_modes) {
       "0.326   0  π⁰ π⁰ π⁰\n"
       "0.227   0  π⁺ π⁻ π⁰\n"
       "0.046   1  π⁺ π⁻ γ\n"
-      "6.9e-3  0  e⁻ e⁺ γ\n");
+      "6.9e-3  0  e⁻ e⁺ γ\n"
+      "\n"
+      "ρ\n"
+      "1.      1  π π\n"
+      "4.72e-5 0  e⁻ e⁺\n");
 }
 
 TEST(pion_decay) {
@@ -109,3 +115,56 @@ TEST(eta_decay) {
   // (to an accuracy of five percent)
   COMPARE_RELATIVE_ERROR(weight_sum / N_samples, 0.0069, 0.05);
 }
+
+/// Output that sums up the weights of the dilepton decays.
+class DileptonWeights : public OutputInterface {
+ public:
+  DileptonWeights() : OutputInterface("Dileptons") {}
+  void at_eventstart(const Particles &, const int) override {}
+  void at_eventend(const Particles &, const int, double, bool) override {}
+  void at_interaction(const Action &action, const double) override {
+    weight += action.get_total_weight();
+  }
+  /// Sum of the weights
+  double weight = 0.;
+};
+
+TEST(batched_shining) {
+  const ParticleType &type_rho = ParticleType::find(0x113);
+  ParticleData rho{type_rho};
+  rho.set_4momentum(0.7, ThreeVector(0.3, 0., 0.));
+  rho.set_4position(FourVector(1., 0., 0., 0.));
+  Particles particles;
+  particles.insert(rho);
+
+  OutputsList outputs;
+  outputs.emplace_back(make_unique<DileptonWeights>());
+  const auto &batched = static_cast<DileptonWeights &>(*outputs[0]);
+  DileptonWeights per_step;
+
+  // A batch of one fm gives the same weight as the shining over one fm.
+  DecayActionsFinderDilepton finder(true);
+  VERIFY(finder.batched());
+  finder.start_batches(0.);
+  finder.shine_batch(particles, 1., outputs);
+  VERIFY(batched.weight > 0.);
+  DecayActionsFinderDilepton(false).shine(particles, &per_step, 1.);
+  COMPARE_RELATIVE_ERROR(batched.weight, per_step.weight, 1e-4);
+
+  // The particle only shines after it is formed.
+  const double weight_per_fm = batched.weight;
+  for (ParticleData &p : particles) {
+    p.set_formation_time(1.6);
+    p.set_4position(FourVector(2., 0., 0., 0.));
+  }
+  finder.shine_batch(particles, 2., outputs);
+  COMPARE_RELATIVE_ERROR(batched.weight, 1.4 * weight_per_fm, 1e-10);
+
+  // The incoming particles of an action shine until it is performed.
+  for (ParticleData &p : particles) {
+    p.set_4position(FourVector(2.5, 0., 0., 0.));
+  }
+  DecayAction action(particles.front(), 0.);
+  finder.shine_incoming(action, outputs);
+  COMPARE_RELATIVE_ERROR(batched.weight, 1.9 * weight_per_fm, 1e-10);
+}
@@ -18,6 +18,8 @@ using namespace smash;
 
 TEST(init_particle_types) { Test::create_actual_particletypes(); }
 
+TEST(init_decay_modes) { Test::create_actual_decaymodes(); }
+
 TEST(create_box) {
   VERIFY(!!Test::experiment(
       Configuration("General:\n"
@@ -74,6 +76,32 @@ TEST(create_sphere) {
                     "      661: 724\n")));
 }
 
+TEST_CATCH(failing_parallel_events, ParticleType::PdgNotFoundFailure) {
+  /* The jet type does not exist, so every event throws when sampling the
+   * initial conditions. The first failure stops the run instead of running
+   * all events. */
+  auto exp = Test::experiment(
+      Configuration("General:\n"
+                    "  Modus: Box\n"
+                    "  End_Time: 1.0\n"
+                    "  Nevents: 100000\n"
+                    "  Event_Threads: 2\n"
+                    "  Randomseed: 1\n"
+                    "Collision_Term:\n"
+                    "  Strings: False\n"
+                    "Modi: \n"
+                    "  Box:\n"
+                    "    Initial_Condition: \"peaked momenta\"\n"
+                    "    Length: 10.0\n"
+                    "    Temperature: 0.2\n"
+                    "    Start_Time: 0.0\n"
+                    "    Init_Multiplicities:\n"
+                    "      211: 10\n"
+                    "    Jet:\n"
+                    "      Jet_PDG: 3336\n"));
+  exp->run();
+}
+
 TEST_CATCH(create_invalid, ExperimentBase::InvalidModusRequest) {
   Test::experiment("General: {Modus: Invalid}");
 }
@@ -154,7 +154,7 @@ TEST(grid_construction) {
       auto idsIt = param.ids.begin();
       auto neighbors = param.neighbors;
       grid.iterate_cells(
-          [&](const ParticleList &search) {
+          [&](const ParticleListView &search) {
             auto ids = *idsIt++;
             for (const auto &p : search) {
               COMPARE(ids.erase(p.id()), 1u)
@@ -162,7 +162,7 @@ TEST(grid_construction) {
             }
             COMPARE(ids.size(), 0u);
           },
-          [&](const ParticleList &search, const ParticleList &n) {
+          [&](const ParticleListView &search, const ParticleListView &n) {
             for (const auto &p : search) {
               for (const auto &p2 : n) {
                 COMPARE(neighbors.erase({std::min(p.id(), p2.id()),
@@ -219,7 +219,7 @@ TEST(periodic_grid) {
       std::vector<std::pair<ParticleData, ParticleData>> neighbor_pairs;
 
       grid.iterate_cells(
-          [&](const ParticleList &search) {
+          [&](const ParticleListView &search) {
             for (const ParticleData &p : search) {
               {
                 const auto it = find(list, p);
@@ -240,13 +240,14 @@ TEST(periodic_grid) {
                   const auto it = find(neighbor_pairs, pair);
                   COMPARE(it, neighbor_pairs.end())
                       << "\np: " << p << "\nq: " << q << '\n'
-                      << detailed(search);
+                      << detailed(search.copy_to_vector());
                   neighbor_pairs.emplace_back(std::move(pair));
                 }
               }
             }
           },
-          [&](const ParticleList &search, const ParticleList &neighbors) {
+          [&](const ParticleListView &search,
+              const ParticleListView &neighbors) {
             // for each particle in neighbors, find the same particle in list
             for (const ParticleData &p : neighbors) {
               const auto it = find(list, p);
@@ -422,6 +423,157 @@ TEST(periodic_grid) {
   }
 }
 
+TEST(grid_update) {
+  using Test::Position;
+  const double min_cell_length = minimal_cell_length(1);
+  Particles list;
+  for (int x = 0; x < 5; ++x) {
+    for (int y = 0; y < 5; ++y) {
+      for (int z = 0; z < 5; ++z) {
+        list.insert(Test::smashon(Position{0., x * min_cell_length,
+                                           y * min_cell_length,
+                                           z * min_cell_length}));
+      }
+    }
+  }
+  Grid<GridOptions::Normal> grid(list, min_cell_length, timestep);
+
+  // Checks that every particle of list is found exactly once in the grid with
+  // its current position and that every close pair is found.
+  auto &&verify_grid = [&]() {
+    std::set<int> ids;
+    std::set<std::pair<int, int>> close_pairs;
+    auto &&add_pairs = [&](const ParticleListView &a,
+                           const ParticleListView &b) {
+      for (const ParticleData &p : a) {
+        for (const ParticleData &q : b) {
+          const auto sqr_distance =
+              (p.position().threevec() - q.position().threevec()).sqr();
+          if (p.id() != q.id() &&
+              sqr_distance < min_cell_length * min_cell_length) {
+            close_pairs.insert(
+                {std::min(p.id(), q.id()), std::max(p.id(), q.id())});
+          }
+        }
+      }
+    };
+    grid.iterate_cells(
+        [&](const ParticleListView &search) {
+          for (const ParticleData &p : search) {
+            VERIFY(list.is_valid(p)) << p;
+            COMPARE(list.lookup(p).position(), p.position());
+            VERIFY(ids.insert(p.id()).second) << p;
+          }
+          add_pairs(search, search);
+        },
+        [&](const ParticleListView &search,
+            const ParticleListView &neighbors) {
+          add_pairs(search, neighbors);
+        });
+    COMPARE(ids.size(), list.size());
+    for (const ParticleData &p : list) {
+      for (const ParticleData &q : list) {
+        const auto sqr_distance =
+            (p.position().threevec() - q.position().threevec()).sqr();
+        if (p.id() < q.id() &&
+            sqr_distance < min_cell_length * min_cell_length) {
+          VERIFY(close_pairs.count({p.id(), q.id()}) == 1)
+              << "\np: " << p << "\nq: " << q;
+        }
+      }
+    }
+  };
+  verify_grid();
+
+  // move some particles into other cells and remove and insert others
+  int n = 0;
+  for (ParticleData &p : list) {
+    if (n++ % 3 == 0) {
+      p.set_4position(p.position() +
+                      FourVector(0., 0.6 * min_cell_length,
+                                 -0.4 * min_cell_length, 0.));
+    }
+  }
+  list.remove(list.front());
+  list.insert(Test::smashon(Position{0., 1.5 * min_cell_length,
+                                     2.5 * min_cell_length,
+                                     3.5 * min_cell_length}));
+  grid.update(list, min_cell_length, timestep);
+  COMPARE(grid.number_of_rebuilds(), 1u);  // the box was tight
+  verify_grid();
+
+  // moving inside the enlarged box does not change the layout
+  for (ParticleData &p : list) {
+    p.set_4position(p.position() +
+                    FourVector(0., 0.1 * min_cell_length, 0., 0.));
+  }
+  grid.update(list, min_cell_length, timestep);
+  COMPARE(grid.number_of_rebuilds(), 1u);
+  verify_grid();
+
+  // a particle far outside of the box requires a new layout
+  list.insert(Test::smashon(Position{0., 20. * min_cell_length, 0., 0.}));
+  grid.update(list, min_cell_length, timestep);
+  COMPARE(grid.number_of_rebuilds(), 2u);
+  verify_grid();
+}
+
+TEST(neighborhood) {
+  using Test::Position;
+  const double min_cell_length = minimal_cell_length(1);
+  Particles list;
+  for (int x = 0; x < 5; ++x) {
+    for (int y = 0; y < 5; ++y) {
+      for (int z = 0; z < 5; ++z) {
+        list.insert(Test::smashon(Position{0., x * min_cell_length,
+                                           y * min_cell_length,
+                                           z * min_cell_length}));
+      }
+    }
+  }
+  Grid<GridOptions::Normal> grid(list, min_cell_length, timestep);
+
+  // Checks that all particles close to p are found once, and no removed ones.
+  auto &&verify_neighborhood = [&](const ParticleData &p) {
+    std::set<int> found;
+    grid.iterate_neighborhood(p, [&](const ParticleListView &cell) {
+      for (const ParticleData &q : cell) {
+        VERIFY(list.is_valid(q)) << q;
+        VERIFY(found.insert(q.id()).second) << q;
+      }
+    });
+    for (const ParticleData &q : list) {
+      const auto sqr_distance =
+          (p.position().threevec() - q.position().threevec()).sqr();
+      if (sqr_distance < min_cell_length * min_cell_length) {
+        VERIFY(found.count(q.id()) == 1) << "\np: " << p << "\nq: " << q;
+      }
+    }
+  };
+  verify_neighborhood(Test::smashon(Position{0., 2.2 * min_cell_length,
+                                             1.7 * min_cell_length,
+                                             0.1 * min_cell_length}));
+  // positions outside of the grid
+  verify_neighborhood(Test::smashon(Position{0., -0.5 * min_cell_length,
+                                             4.5 * min_cell_length,
+                                             9. * min_cell_length}));
+
+  // perform an "action" that replaces one particle by two others
+  const ParticleData removed = list.front();
+  grid.remove(removed);
+  list.remove(removed);
+  const ParticleData &first = list.insert(Test::smashon(
+      Position{0., 1.2 * min_cell_length, 0.2 * min_cell_length, 0.}));
+  grid.insert(first, timestep);
+  const ParticleData &second = list.insert(Test::smashon(
+      Position{0., 3.2 * min_cell_length, 3.7 * min_cell_length, 0.}));
+  grid.insert(second, timestep);
+  verify_neighborhood(removed);
+  verify_neighborhood(list.back());
+  verify_neighborhood(Test::smashon(Position{0., 3. * min_cell_length,
+                                             3. * min_cell_length, 0.}));
+}
+
 TEST(max_positions_periodic_grid) {
   constexpr int testparticles = 1;
   const double min_cell_length = minimal_cell_length(testparticles);
@@ -463,3 +615,70 @@ TEST(max_positions_normal_grid) {
   // still generates an out-of-bounds cell index.
   Grid<GridOptions::Normal> grid2(list, testparticles, 1.0);
 }
+
+TEST(anisotropic_cells) {
+  using Test::Position;
+  const double min_cell_length = minimal_cell_length(1);
+  // a flat system, like a Lorentz-contracted nucleus
+  const double spacing = 0.7 * min_cell_length;
+  Particles list;
+  for (int x = 0; x < 20; ++x) {
+    for (int y = 0; y < 20; ++y) {
+      list.insert(Test::smashon(
+          Position{0., x * spacing, y * spacing, 0.01 * ((x + y) % 3)}));
+    }
+  }
+  // The optimal strategy allows at most 7 cells per direction.
+  Grid<GridOptions::Normal> optimal(list, min_cell_length, timestep);
+  COMPARE(optimal.cell_count(), 7 * 7);
+  VERIFY(optimal.max_cell_occupancy() >= 8u);
+  // The anisotropic one only limits the total number of cells.
+  Grid<GridOptions::Normal> anisotropic(list, min_cell_length, timestep,
+                                        CellSizeStrategy::Anisotropic);
+  COMPARE(anisotropic.cell_count(), 14 * 14);
+  VERIFY(anisotropic.max_cell_occupancy() <= 4u);
+
+  // every close pair is still found
+  std::set<std::pair<int, int>> close_pairs;
+  auto &&add_pairs = [&](const ParticleListView &a,
+                         const ParticleListView &b) {
+    for (const ParticleData &p : a) {
+      for (const ParticleData &q : b) {
+        const auto sqr_distance =
+            (p.position().threevec() - q.position().threevec()).sqr();
+        if (p.id() != q.id() &&
+            sqr_distance < min_cell_length * min_cell_length) {
+          close_pairs.insert(
+              {std::min(p.id(), q.id()), std::max(p.id(), q.id())});
+        }
+      }
+    }
+  };
+  anisotropic.iterate_cells(
+      [&](const ParticleListView &search) { add_pairs(search, search); },
+      add_pairs);
+  std::size_t expected = 0;
+  for (const ParticleData &p : list) {
+    for (const ParticleData &q : list) {
+      const auto sqr_distance =
+          (p.position().threevec() - q.position().threevec()).sqr();
+      if (p.id() < q.id() &&
+          sqr_distance < min_cell_length * min_cell_length) {
+        ++expected;
+        VERIFY(close_pairs.count({p.id(), q.id()}) == 1)
+            << "\np: " << p << "\nq: " << q;
+      }
+    }
+  }
+  COMPARE(close_pairs.size(), expected);
+
+  // Too many cells are reduced evenly in the directions with several cells.
+  Particles sparse;
+  for (int x = 0; x < 40; ++x) {
+    sparse.insert(Test::smashon(Position{0., x * min_cell_length,
+                                         (x % 20) * min_cell_length, 0.}));
+  }
+  Grid<GridOptions::Normal> reduced(sparse, min_cell_length, timestep,
+                                    CellSizeStrategy::Anisotropic);
+  COMPARE(reduced.cell_count(), 8 * 4);
+}
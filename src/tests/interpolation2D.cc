@@ -85,3 +85,50 @@ TEST(extrapolate_constant) {
   FUZZY_COMPARE((*interp)(2, 0.8), (*interp)(2, 1));
   FUZZY_COMPARE((*interp)(5, 16), (*interp)(5, 12));
 }
+
+TEST(fail_not_increasing) {
+  std::vector<double> x = {1, 2, 3, 4, 5};
+  std::vector<double> y = {1, 4, 4, 12};
+  std::vector<double> z = {1, 3, 0, 5, 0, 7, 3, 8, 9, 1,
+                           2, 5, 4, 5, 6, 1, 4, 7, 9, 2};
+
+  // Try creating 2D interpolation with repeated nodes, which is expected to
+  // raise an exception
+  vir::test::expect_failure();
+  interp = make_unique<InterpolateData2DSpline>(x, y, z);
+}
+
+TEST(interpolate_log_grid) {
+  // logarithmically spaced x-values
+  std::vector<double> x = {0.01, 0.1, 1, 10, 100};
+  std::vector<double> y = {0.5, 1, 1.5, 2};
+  std::vector<double> z = {1, 3, 0, 5, 0, 7, 3, 8, 9, 1,
+                           2, 5, 4, 5, 6, 1, 4, 7, 9, 2};
+  interp = make_unique<InterpolateData2DSpline>(x, y, z);
+
+  // reference values follow the algorithm of gsl_interp2d_bicubic
+  COMPARE_RELATIVE_ERROR((*interp)(0.02, 0.7), 4.2742511, accuracy);
+  COMPARE_RELATIVE_ERROR((*interp)(0.5, 1.2), 1.6430131, accuracy);
+  COMPARE_RELATIVE_ERROR((*interp)(3, 1.9), -13.4740298, accuracy);
+  COMPARE_RELATIVE_ERROR((*interp)(70, 0.6), 17.4398505, accuracy);
+  COMPARE_RELATIVE_ERROR((*interp)(0.1, 1.25), 4.075, accuracy);
+}
+
+TEST(interpolate_batch) {
+  std::vector<double> x = {0.01, 0.1, 1, 10, 100};
+  std::vector<double> y = {1, 4, 8, 12};
+  std::vector<double> z = {1, 3, 0, 5, 0, 7, 3, 8, 9, 1,
+                           2, 5, 4, 5, 6, 1, 4, 7, 9, 2};
+  interp = make_unique<InterpolateData2DSpline>(x, y, z);
+
+  // the batch evaluation agrees with the single one, also out of bounds
+  const std::vector<double> xi = {0.001, 0.01, 0.05, 0.1, 3., 99., 200.};
+  std::vector<double> result(2, 0.);
+  for (const double yi : {0.5, 1., 5.5, 12., 13.}) {
+    (*interp)(xi, yi, result);
+    COMPARE(result.size(), xi.size());
+    for (size_t k = 0; k < xi.size(); k++) {
+      COMPARE(result[k], (*interp)(xi[k], yi)) << xi[k] << ", " << yi;
+    }
+  }
+}
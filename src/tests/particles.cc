@@ -222,6 +222,25 @@ TEST(erase_particle) {
   }
 }
 
+TEST(reused_slot_is_not_valid) {
+  Particles p;
+  p.create(3, 0x661);
+  const ParticleData old_copy = *(++p.begin());
+  p.remove(old_copy);
+  // the hole is filled by the new particle
+  const ParticleData new_copy = p.insert(Test::smashon());
+  COMPARE(new_copy.index(), old_copy.index());
+  VERIFY(!p.is_valid(old_copy));
+  VERIFY(p.is_valid(new_copy));
+  // the same for the last entry
+  const ParticleData last = p.back();
+  p.remove(last);
+  const ParticleData refill = p.insert(Test::smashon());
+  COMPARE(refill.index(), last.index());
+  VERIFY(!p.is_valid(last));
+  VERIFY(p.is_valid(refill));
+}
+
 TEST(id_process) {
   Particles p;
   p.create(1000, Test::smashon().pdgcode());
@@ -340,3 +359,174 @@ TEST(update) {
   COMPARE(p.front().position(), FourVector(3, 3, 3, 3));
   COMPARE(p.front().id_process(), 2u);
 }
+
+TEST(view) {
+  Particles p;
+  p.create(10, 0x211);
+  std::vector<unsigned> indices;
+  for (const auto &x : p) {
+    if (x.id() % 3 == 0) {
+      indices.push_back(x.index());
+    }
+  }
+  const ParticleListView indexed = p.view(indices);
+  COMPARE(indexed.size(), 4u);
+  std::vector<int> ids;
+  for (const ParticleData &x : indexed) {
+    VERIFY(p.is_valid(x));
+    ids.push_back(x.id());
+  }
+  COMPARE(ids, (std::vector<int>{0, 3, 6, 9}));
+  COMPARE(indexed[2].id(), 6);
+
+  const ParticleList list = p.copy_to_vector();
+  const ParticleListView contiguous = list;
+  COMPARE(contiguous.size(), list.size());
+  COMPARE(contiguous.copy_to_vector(), list);
+  COMPARE(&contiguous[5], &list[5]);
+}
+
+TEST(copy_from) {
+  Particles p;
+  p.create(150, 0x661);
+  const ParticleList all = p.copy_to_vector();
+  p.remove(all[3]);
+  p.remove(all[70]);
+
+  Particles copy;
+  copy.create(5, 0x211);
+  copy.remove(copy.front());
+  copy.copy_from(p);
+  COMPARE(copy.size(), p.size());
+  COMPARE(copy.copy_to_vector(), p.copy_to_vector());
+  for (const auto &x : p) {
+    VERIFY(copy.is_valid(x));
+  }
+
+  // new particles fill the same holes and get the same ids
+  const int new_id = p.insert(Test::smashon()).id();
+  COMPARE(copy.insert(Test::smashon()).id(), new_id);
+  COMPARE(copy.copy_to_vector(), p.copy_to_vector());
+}
+
+// Compare the columns to the ParticleData objects.
+static void verify_columns(const Particles &p) {
+  const ParticleColumns &columns = p.columns();
+  std::size_t n = 0;
+  for (unsigned i = 0; i < columns.size; ++i) {
+    if (!columns.is_particle(i)) {
+      continue;
+    }
+    ++n;
+    const ParticleData &x = p.at_index(i);
+    COMPARE(x.index(), i);
+    COMPARE(columns.position(i), x.position());
+    COMPARE(columns.momentum(i), x.momentum());
+    COMPARE(columns.type[i], &x.type());
+    COMPARE(columns.id[i], x.id());
+    if (x.momentum().sqr() > -really_small) {
+      COMPARE(columns.effective_mass[i], x.effective_mass());
+    } else {
+      VERIFY(std::isnan(columns.effective_mass[i]));
+    }
+    COMPARE(columns.formation_time[i], x.formation_time());
+    COMPARE(columns.begin_formation_time[i], x.begin_formation_time());
+  }
+  COMPARE(n, p.size());
+}
+
+TEST(columns) {
+  Particles p;
+  verify_columns(p);
+  p.create(150, 0x661);
+  verify_columns(p);
+  const ParticleList all = p.copy_to_vector();
+  p.remove(all[3]);
+  p.remove(all[70]);
+  p.remove(all[149]);
+  verify_columns(p);
+
+  auto pd =
+      Test::smashon(Test::Momentum{2, 1, 1, 1}, Test::Position{1, 2, 3, 4});
+  pd.set_formation_time(5.);
+  p.insert(pd);
+  verify_columns(p);
+
+  ParticleList to_add = {pd, pd, pd};
+  to_add[1].set_4position({7, 6, 5, 4});
+  p.replace({all[10], all[11]}, to_add);
+  verify_columns(p);
+
+  pd.set_4momentum({3, 0, 0, 1});
+  p.update_particle(to_add[1], pd);
+  verify_columns(p);
+
+  // modifications through the iterators are taken over
+  for (ParticleData &x : p) {
+    x.set_4position({1, 1, 1, 1});
+  }
+  verify_columns(p);
+  p.back().set_4position({2, 1, 1, 1});
+  verify_columns(p);
+
+  // spacelike momenta are allowed
+  pd.set_4momentum({1, 2, 0, 0});
+  p.update_particle(to_add[1], pd);
+  verify_columns(p);
+
+  // modifications through the created particle are taken over
+  p.create(0x211).set_4momentum(0.14, 0.1, 0.2, 0.3);
+  verify_columns(p);
+
+  p.update_all([](ParticleData &x) { x.set_formation_time(2.); });
+  const Particles &const_p = p;
+  COMPARE(const_p.columns().formation_time[const_p.front().index()], 2.);
+  verify_columns(p);
+
+  // modifications of the columns are taken over by the ParticleData records
+  const ParticleList before = p.copy_to_vector();
+  p.update_columns([](ParticleColumns &columns, unsigned i) {
+    columns.set_position(i, columns.position(i) + FourVector(1, 2, 3, 4));
+    columns.set_momentum(i, 0.5, ThreeVector(0.1, 0.2, 0.3));
+  });
+  for (const ParticleData &x : before) {
+    const ParticleData &updated = p.lookup(x);
+    COMPARE(updated.position(), x.position() + FourVector(1, 2, 3, 4));
+    COMPARE(updated.momentum().threevec(), ThreeVector(0.1, 0.2, 0.3));
+    FUZZY_COMPARE(p.columns().effective_mass[x.index()], 0.5);
+    COMPARE(updated.get_history().id_process, x.get_history().id_process);
+  }
+  verify_columns(p);
+
+  p.create(1000, 0x211);
+  verify_columns(p);
+  Particles copy;
+  copy.copy_from(p);
+  verify_columns(copy);
+  p.update_columns([](ParticleColumns &columns, unsigned i) {
+    columns.set_position(i, FourVector(9, 8, 7, 6));
+  });
+  copy.copy_from(p);
+  COMPARE(copy.front().position(), FourVector(9, 8, 7, 6));
+  verify_columns(copy);
+
+  // modifications of a created particle are not overwritten by the columns
+  // of a preceding update_columns
+  p.update_columns([](ParticleColumns &columns, unsigned i) {
+    columns.set_position(i, FourVector(5, 4, 3, 2));
+  });
+  ParticleData &created = p.create(0x211);
+  created.set_4position({1, 2, 3, 4});
+  created.set_4momentum(0.14, 0.1, 0.2, 0.3);
+  const ParticleData &stored = const_p.lookup(created);
+  COMPARE(stored.position(), FourVector(1, 2, 3, 4));
+  COMPARE(stored.momentum().threevec(), ThreeVector(0.1, 0.2, 0.3));
+  for (const ParticleData &x : const_p) {
+    if (x.id() != created.id()) {
+      COMPARE(x.position(), FourVector(5, 4, 3, 2));
+    }
+  }
+  verify_columns(p);
+  p.reset();
+  verify_columns(p);
+}
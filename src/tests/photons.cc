@@ -9,8 +9,20 @@
 
 #include "setup.h"
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+
 #include "../include/smash/bremsstrahlungaction.h"
+#include "../include/smash/crosssectionsbrems.h"
+#include "../include/smash/crosssectionsphoton.h"
+#include "../include/smash/outputinterface.h"
+#include "../include/smash/random.h"
 #include "../include/smash/scatteractionphoton.h"
+#include "../include/smash/sha256.h"
 
 using namespace smash;
 using smash::Test::Momentum;
@@ -50,6 +62,78 @@ TEST(pi_rho0_pi_gamma) {
   COMPARE_RELATIVE_ERROR(tot_weight, 0.000722419008, 0.08);
 }
 
+/// Records the photons written to the photon output.
+class PhotonRecorder : public OutputInterface {
+ public:
+  PhotonRecorder() : OutputInterface("Photons") {}
+  void at_eventstart(const Particles &, const int) override {}
+  void at_eventend(const Particles &, const int, double, bool) override {}
+  void at_interaction(const Action &action, const double) override {
+    weights.push_back(action.get_total_weight());
+    hadrons.push_back(action.outgoing_particles()[0].momentum());
+    photons.push_back(action.outgoing_particles()[1].momentum());
+  }
+  /// Weights of the photons
+  std::vector<double> weights;
+  /// Momenta of the hadrons produced together with the photons
+  std::vector<FourVector> hadrons;
+  /// Momenta of the photons
+  std::vector<FourVector> photons;
+};
+
+TEST(fractional_photons) {
+  // π+ + π- -> ρ0 + γ, where the ρ mass is sampled
+  const ParticleType &type_pip = ParticleType::find(0x211);
+  ParticleData pip{type_pip};
+  pip.set_4momentum(type_pip.mass(), ThreeVector(0.3, 0., 1.));
+  const ParticleType &type_pim = ParticleType::find(-0x211);
+  ParticleData pim{type_pim};
+  pim.set_4momentum(type_pim.mass(), ThreeVector(0., 0., -1.));
+  const ParticleList in{pip, pim};
+  const FourVector p_in = pip.momentum() + pim.momentum();
+  const int number_of_photons = 100;
+  // Later tests rely on the state of the engine for their reference values.
+  const random::Engine engine = random::engine;
+
+  // The mass of the ρ is sampled when the action is created.
+  ScatterActionPhoton batch(in, 0.05, number_of_photons, 5.0);
+  batch.add_single_process();
+  OutputsList outputs;
+  outputs.emplace_back(make_unique<PhotonRecorder>());
+  outputs.emplace_back(make_unique<PhotonRecorder>());
+  batch.perform_photons(outputs);
+  const auto &recorded = static_cast<PhotonRecorder &>(*outputs[0]);
+  COMPARE(recorded.weights.size(), size_t(number_of_photons));
+  // All photon outputs get the same photons.
+  const auto &recorded_twice = static_cast<PhotonRecorder &>(*outputs[1]);
+  COMPARE(recorded_twice.weights, recorded.weights);
+  // Each photon is sampled separately and conserves the momentum.
+  for (int i = 0; i < number_of_photons; i++) {
+    VERIFY(recorded.weights[i] > 0.) << i;
+    COMPARE_ABSOLUTE_ERROR(recorded.photons[i].sqr(), 0., 1e-10) << i;
+    const FourVector p_out = recorded.hadrons[i] + recorded.photons[i];
+    for (int mu = 0; mu < 4; mu++) {
+      COMPARE_ABSOLUTE_ERROR(p_out[mu], p_in[mu], 1e-10) << i;
+    }
+    if (i > 0) {
+      VERIFY(recorded.photons[i] != recorded.photons[i - 1]) << i;
+    }
+  }
+
+  /* The batch gives the same photons as sampling them one after another,
+   * where the kinematics are set up again for each photon. */
+  random::engine = engine;
+  ScatterActionPhoton single(in, 0.05, number_of_photons, 5.0);
+  single.add_single_process();
+  for (int i = 0; i < number_of_photons; i++) {
+    single.generate_final_state();
+    COMPARE(single.get_total_weight(), recorded.weights[i]) << i;
+    COMPARE(single.outgoing_particles()[1].momentum(), recorded.photons[i])
+        << i;
+  }
+  random::engine = engine;
+}
+
 TEST(photon_reaction_type_function) {
   const ParticleData pip{ParticleType::find(0x211)};
   const ParticleData pim{ParticleType::find(-0x211)};
@@ -119,6 +203,161 @@ TEST(check_kinematic_thresholds) {
       !photonAct_lowE.is_kinematically_possible(energy_a + energy_c, in_lowE));
 }
 
+////
+// Test the tabulated photon cross sections
+////
+
+namespace {
+using Analytic = CrosssectionsPhoton<ComputationMethod::Analytic>;
+using Lookup = CrosssectionsPhoton<ComputationMethod::Lookup>;
+
+/// A photon process with its analytic and tabulated cross sections
+struct PhotonProcess {
+  bool rho_out;
+  double (*xs_analytic)(double, double);
+  double (*xs_lookup)(double, double);
+  double (*diff_xs_analytic)(double, double, double);
+  double (*diff_xs_lookup)(double, double, double);
+};
+
+const PhotonProcess photon_processes[] = {
+    {true, Analytic::xs_pi_pi_rho0, Lookup::xs_pi_pi_rho0,
+     Analytic::xs_diff_pi_pi_rho0, Lookup::xs_diff_pi_pi_rho0},
+    {true, Analytic::xs_pi_pi0_rho, Lookup::xs_pi_pi0_rho,
+     Analytic::xs_diff_pi_pi0_rho, Lookup::xs_diff_pi_pi0_rho},
+    {false, Analytic::xs_pi0_rho0_pi0, Lookup::xs_pi0_rho0_pi0,
+     Analytic::xs_diff_pi0_rho0_pi0, Lookup::xs_diff_pi0_rho0_pi0},
+    {false, Analytic::xs_pi_rho0_pi, Lookup::xs_pi_rho0_pi,
+     Analytic::xs_diff_pi_rho0_pi, Lookup::xs_diff_pi_rho0_pi},
+    {false, Analytic::xs_pi_rho_pi0_rho_mediated,
+     Lookup::xs_pi_rho_pi0_rho_mediated,
+     Analytic::xs_diff_pi_rho_pi0_rho_mediated,
+     Lookup::xs_diff_pi_rho_pi0_rho_mediated},
+    {false, Analytic::xs_pi_rho_pi0_omega_mediated,
+     Lookup::xs_pi_rho_pi0_omega_mediated,
+     Analytic::xs_diff_pi_rho_pi0_omega_mediated,
+     Lookup::xs_diff_pi_rho_pi0_omega_mediated},
+    {false, Analytic::xs_pi0_rho_pi_rho_mediated,
+     Lookup::xs_pi0_rho_pi_rho_mediated,
+     Analytic::xs_diff_pi0_rho_pi_rho_mediated,
+     Lookup::xs_diff_pi0_rho_pi_rho_mediated},
+    {false, Analytic::xs_pi0_rho_pi_omega_mediated,
+     Lookup::xs_pi0_rho_pi_omega_mediated,
+     Analytic::xs_diff_pi0_rho_pi_omega_mediated,
+     Lookup::xs_diff_pi0_rho_pi_omega_mediated},
+};
+}  // unnamed namespace
+
+TEST(lookup_cross_sections) {
+  const bf::path tabulations_path = bf::absolute(SMASH_TEST_OUTPUT_PATH);
+  bf::create_directories(tabulations_path);
+  bf::remove(tabulations_path / "photons.bin");
+  VERIFY(!Lookup::is_tabulated());
+  // Before tabulating, the analytic cross sections are returned.
+  COMPARE(Lookup::xs_pi_rho0_pi(4., 0.776), Analytic::xs_pi_rho0_pi(4., 0.776));
+  Lookup::tabulate(sha256::Hash(), tabulations_path);
+  VERIFY(Lookup::is_tabulated());
+  VERIFY(bf::exists(tabulations_path / "photons.bin"));
+
+  /* Single points near steep structures may be off by several percent, but
+   * on average the tables have to be much more accurate. */
+  double sum_xs_error = 0., sum_diff_xs_error = 0.;
+  int n_xs = 0, n_diff_xs = 0;
+  for (const PhotonProcess &process : photon_processes) {
+    for (double m_rho = 0.3; m_rho < 1.3; m_rho += 0.07) {
+      const double sqrts_thr = process.rho_out ? m_rho : m_rho + pion_mass;
+      for (double sqrts = sqrts_thr + 0.05; sqrts < sqrts_thr + 3.5;
+           sqrts += 0.13) {
+        const double s = sqrts * sqrts;
+        const double xs_analytic = process.xs_analytic(s, m_rho);
+        const double xs_lookup = process.xs_lookup(s, m_rho);
+        COMPARE_RELATIVE_ERROR(xs_lookup, xs_analytic, 0.07)
+            << "sqrt(s) = " << sqrts << ", m_rho = " << m_rho;
+        if (xs_analytic > 0.) {
+          sum_xs_error += std::abs(xs_lookup / xs_analytic - 1.);
+          n_xs++;
+        }
+
+        /* The differential cross sections are compared relative to their
+         * largest value, because they might cross zero. */
+        const auto t_range =
+            process.rho_out
+                ? get_t_range(sqrts, pion_mass, pion_mass, m_rho, 0.)
+                : get_t_range(sqrts, pion_mass, m_rho, pion_mass, 0.);
+        constexpr int n_t = 50;
+        std::array<double, n_t> analytic, lookup;
+        double largest = 0.;
+        for (int i = 0; i < n_t; i++) {
+          const double t =
+              t_range[1] + (i + 0.5) / n_t * (t_range[0] - t_range[1]);
+          analytic[i] = process.diff_xs_analytic(s, t, m_rho);
+          lookup[i] = process.diff_xs_lookup(s, t, m_rho);
+          largest = std::max(largest, std::abs(analytic[i]));
+        }
+        for (int i = 0; i < n_t; i++) {
+          COMPARE_ABSOLUTE_ERROR(lookup[i], analytic[i], 0.09 * largest)
+              << "sqrt(s) = " << sqrts << ", m_rho = " << m_rho;
+          if (largest > 0.) {
+            sum_diff_xs_error += std::abs(lookup[i] - analytic[i]) / largest;
+            n_diff_xs++;
+          }
+        }
+      }
+    }
+  }
+  VERIFY(sum_xs_error < 0.005 * n_xs) << sum_xs_error / n_xs;
+  VERIFY(sum_diff_xs_error < 0.004 * n_diff_xs)
+      << sum_diff_xs_error / n_diff_xs;
+
+  // Outside of the tables, the analytic cross sections are returned.
+  const double s = 4.;
+  COMPARE(Lookup::xs_pi_rho0_pi(s, 2.5), Analytic::xs_pi_rho0_pi(s, 2.5));
+  COMPARE(Lookup::xs_diff_pi_rho0_pi(s, -1., 2.5),
+          Analytic::xs_diff_pi_rho0_pi(s, -1., 2.5));
+  // This is close to the omega pole.
+  const double sqrts_omega = omega_mass + 0.05;
+  const double s_omega = sqrts_omega * sqrts_omega;
+  COMPARE(Lookup::xs_pi0_rho0_pi0(s_omega, 0.5),
+          Analytic::xs_pi0_rho0_pi0(s_omega, 0.5));
+
+  // The tables are read back from the cache.
+  const double xs = Lookup::xs_pi_pi0_rho(s, 0.7);
+  const double diff_xs = Lookup::xs_diff_pi_pi0_rho(s, -1., 0.7);
+  Lookup::tabulate(sha256::Hash(), tabulations_path);
+  COMPARE(Lookup::xs_pi_pi0_rho(s, 0.7), xs);
+  COMPARE(Lookup::xs_diff_pi_pi0_rho(s, -1., 0.7), diff_xs);
+}
+
+TEST(pi_rho0_pi_gamma_lookup) {
+  /* Same as pi_rho0_pi_gamma, once with the analytic and once with the
+   * tabulated cross sections. Both use the same random numbers, so the
+   * photons only differ by the accuracy of the tables. */
+  const ParticleType &type_pi = ParticleType::find(0x211);
+  ParticleData pi{type_pi};
+  pi.set_4momentum(type_pi.mass(), ThreeVector(0., 0., 2.));
+  const ParticleType &type_rho0 = ParticleType::find(0x113);
+  ParticleData rho0{type_rho0};
+  rho0.set_4momentum(type_rho0.mass(), ThreeVector(0., 0., -2.));
+  const int number_of_photons = 10000;
+  ParticleList in{pi, rho0};
+  // Later tests rely on the state of the engine for their reference values.
+  const random::Engine engine = random::engine;
+  std::array<double, 2> tot_weight = {0., 0.};
+  const std::array<ComputationMethod, 2> methods = {
+      ComputationMethod::Analytic, ComputationMethod::Lookup};
+  for (size_t m = 0; m < methods.size(); m++) {
+    random::engine = engine;
+    ScatterActionPhoton act(in, 0.05, number_of_photons, 5.0, methods[m]);
+    act.add_single_process();
+    for (int i = 0; i < number_of_photons; i++) {
+      act.generate_final_state();
+      tot_weight[m] += act.get_total_weight();
+    }
+  }
+  random::engine = engine;
+  COMPARE_RELATIVE_ERROR(tot_weight[1], tot_weight[0], 0.02);
+}
+
 ////
 // Test photon production in Bremsstrahlung processes
 ////
@@ -181,3 +420,110 @@ TEST(bremsstrahlung_reaction_type_function) {
   VERIFY(BremsstrahlungAction::bremsstrahlung_reaction_type(l8) ==
          BremsstrahlungAction::ReactionType::no_reaction);
 }
+
+TEST(brems_total_cross_sections) {
+  // first two table entries of each channel, at sqrt(s) = 0.30 and 0.31 GeV
+  const std::vector<std::tuple<BremsChannel, double, double>> tabulated = {
+      std::make_tuple(BremsChannel::PiPi_PiPi_Opp, 0.00702915, 0.0116714),
+      std::make_tuple(BremsChannel::PiPi_PiPi_Same, 0.00108315, 0.00261623),
+      std::make_tuple(BremsChannel::PiPi0_PiPi0, 0.00238715, 0.00445382),
+      std::make_tuple(BremsChannel::PiPi_Pi0Pi0, 0.0152699, 0.0259448),
+      std::make_tuple(BremsChannel::Pi0Pi0_PiPi, 0.0165184, 0.0291163)};
+  for (const auto &entry : tabulated) {
+    const BremsChannel channel = std::get<0>(entry);
+    const double first = std::get<1>(entry);
+    const double second = std::get<2>(entry);
+    COMPARE_ABSOLUTE_ERROR(brems_xs(channel, 0.3), first, 1e-12);
+    COMPARE_ABSOLUTE_ERROR(brems_xs(channel, 0.31), second, 1e-12);
+    COMPARE_RELATIVE_ERROR(brems_xs(channel, 0.305), 0.5 * (first + second),
+                           1e-10);
+  }
+}
+
+TEST(brems_concurrent_first_use) {
+  // Several threads setting up the same interpolations at the same time must
+  // all see the complete interpolations.
+  const std::vector<BremsChannel> channels = {
+      BremsChannel::PiPi_PiPi_Opp, BremsChannel::PiPi_PiPi_Same,
+      BremsChannel::PiPi0_PiPi0, BremsChannel::PiPi_Pi0Pi0,
+      BremsChannel::Pi0Pi0_PiPi};
+  constexpr int n_threads = 8;
+  std::vector<std::vector<double>> results(n_threads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < n_threads; t++) {
+    threads.emplace_back([&channels, &results, t]() {
+      for (const BremsChannel channel : channels) {
+        results[t].push_back(brems_dsigma_dtheta(channel, 1.2, 0.55));
+        results[t].push_back(brems_dsigma_dk(channel, 0.07, 0.55));
+        results[t].push_back(brems_xs(channel, 0.55));
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < n_threads; t++) {
+    COMPARE(results[t], results[0]);
+  }
+  VERIFY(results[0][0] > 0.);
+}
+
+TEST(brems_cached_tables) {
+  const bf::path tabulations_path = bf::absolute(SMASH_TEST_OUTPUT_PATH);
+  bf::create_directories(tabulations_path);
+  const bf::path cache = tabulations_path / "bremsstrahlung.bin";
+  bf::remove(cache);
+  const BremsChannel channel = BremsChannel::PiPi_PiPi_Opp;
+  // the first value of the total cross section, at sqrt(s) = 0.3 GeV
+  const double first = 0.00702915;
+  set_brems_tabulations_path("");
+  const double dsigma_dk = brems_dsigma_dk(channel, 0.07, 0.55);
+  const double dsigma_dtheta = brems_dsigma_dtheta(channel, 1.2, 0.55);
+
+  // The tables are parsed and written to the cache, ...
+  set_brems_tabulations_path(tabulations_path);
+  COMPARE_ABSOLUTE_ERROR(brems_xs(channel, 0.3), first, 1e-12);
+  VERIFY(bf::exists(cache));
+  // ... and mapped from it the next time.
+  set_brems_tabulations_path(tabulations_path);
+  COMPARE(brems_dsigma_dk(channel, 0.07, 0.55), dsigma_dk);
+  COMPARE(brems_dsigma_dtheta(channel, 1.2, 0.55), dsigma_dtheta);
+
+  /* The cache holds the hash of the text, the values and their hash. The
+   * total cross section of the first channel follows the grids. */
+  const size_t values_size = bf::file_size(cache) - 2 * sha256::HASH_SIZE;
+  std::vector<char> content(bf::file_size(cache));
+  std::ifstream(cache.string(), std::ios::binary)
+      .read(content.data(), content.size());
+  const size_t first_offset = sha256::HASH_SIZE + (170 + 100 + 80) * 8;
+  const auto write = [&]() {
+    std::ofstream(cache.string(), std::ios::binary)
+        .write(content.data(), content.size());
+  };
+  const auto checksum = [&]() {
+    return sha256::calculate(
+        reinterpret_cast<const uint8_t *>(&content[sha256::HASH_SIZE]),
+        values_size);
+  };
+  // A modified value with a matching checksum is taken from the cache.
+  const double modified = 1.;
+  std::memcpy(&content[first_offset], &modified, sizeof(double));
+  const sha256::Hash modified_checksum = checksum();
+  std::copy(modified_checksum.begin(), modified_checksum.end(),
+            content.end() - sha256::HASH_SIZE);
+  write();
+  set_brems_tabulations_path(tabulations_path);
+  COMPARE_ABSOLUTE_ERROR(brems_xs(channel, 0.3), modified, 1e-12);
+  // Without a matching checksum, the cache is ignored and written again.
+  std::memcpy(&content[first_offset], &first, sizeof(double));
+  content[first_offset + 8] ^= 1;
+  write();
+  set_brems_tabulations_path(tabulations_path);
+  COMPARE_ABSOLUTE_ERROR(brems_xs(channel, 0.3), first, 1e-12);
+  set_brems_tabulations_path(tabulations_path);
+  COMPARE_ABSOLUTE_ERROR(brems_xs(channel, 0.3), first, 1e-12);
+  COMPARE(brems_dsigma_dk(channel, 0.07, 0.55), dsigma_dk);
+
+  set_brems_tabulations_path("");
+  bf::remove(cache);
+}
@@ -77,6 +77,28 @@ TEST(propagate_default_no_potentials) {
           FourVector(1.0, 0.2 - 0.3 / 0.51, 0.0, 4.8 + 0.4 / 0.51));
 }
 
+TEST(propagate_single_particle_in_steps) {
+  auto Pdef = create_box_particles();
+  auto Plazy = create_box_particles();
+  propagate_straight_line(Pdef.get(), 1.0, {});
+  // Propagating a particle in several steps from its own time gives the same
+  // position as moving all particles at once.
+  for (ParticleData &p : *Plazy) {
+    propagate_straight_line(p, 0.3, {});
+    COMPARE(p.position().x0(), 0.3);
+    FUZZY_COMPARE(propagate_straight_line(p, 1.0, {}), 0.7);
+  }
+  // The two steps round differently.
+  auto it = Pdef->begin();
+  for (const ParticleData &p : *Plazy) {
+    COMPARE(p.position().x0(), 1.0);
+    COMPARE_ABSOLUTE_ERROR(p.position().x1(), it->position().x1(), 1e-12);
+    COMPARE_ABSOLUTE_ERROR(p.position().x2(), it->position().x2(), 1e-12);
+    COMPARE_ABSOLUTE_ERROR(p.position().x3(), it->position().x3(), 1e-12);
+    ++it;
+  }
+}
+
 TEST(hubble) {
   // setting up some exeplary metrics with simple b_ for
   // easy analytic values. All ExpansionModes are tested.
@@ -271,15 +271,74 @@ TEST(increasing_scaling_factors) {
   const std::vector<bool> has_interacted = {};
   ScatterActionsFinder finder(config, exp_par, has_interacted, 0, 0);
   COMPARE(finder
-              .find_actions_in_cell({p_a, p_b}, 2. * delta_t_coll,
-                                    grid_cell_vol, {})
+              .find_actions_in_cell(ParticleList{p_a, p_b},
+                                    2. * delta_t_coll, grid_cell_vol, {})
               .size(),
           1u);
   // For a Power smaller than alpha, the particles should not collide.
   ParticleData::formation_power_ = alpha + 0.1;
   COMPARE(finder
-              .find_actions_in_cell({p_a, p_b}, 2. * delta_t_coll,
-                                    grid_cell_vol, {})
+              .find_actions_in_cell(ParticleList{p_a, p_b},
+                                    2. * delta_t_coll, grid_cell_vol, {})
               .size(),
           0u);
 }
+
+TEST(stochastic_pair_sampling) {
+  // particles with random positions and momenta in one cell
+  constexpr int n = 30;
+  const double cell_vol = 8.;  // fm^3
+  const double dt = 0.1;       // fm
+  const double xs = 10.;       // mb
+  ParticleList search_list;
+  for (int i = 0; i < n; i++) {
+    ParticleData p = create_smashon_particle(i);
+    p.set_4position(FourVector(0., random::uniform(0., 2.),
+                               random::uniform(0., 2.),
+                               random::uniform(0., 2.)));
+    p.set_4momentum(Test::smashon_mass,
+                    ThreeVector(random::uniform(-1., 1.),
+                                random::uniform(-1., 1.),
+                                random::uniform(-1., 1.)));
+    search_list.push_back(p);
+  }
+
+  // sum of the collision probabilities of all pairs
+  double expected = 0.;
+  for (int i = 0; i < n; i++) {
+    for (int j = i + 1; j < n; j++) {
+      const FourVector p1 = search_list[i].momentum();
+      const FourVector p2 = search_list[j].momentum();
+      const double s = (p1 + p2).sqr();
+      const double m1_sqr = p1.sqr(), m2_sqr = p2.sqr();
+      const double lambda = (s - m1_sqr - m2_sqr) * (s - m1_sqr - m2_sqr) -
+                            4. * m1_sqr * m2_sqr;
+      const double v_rel = std::sqrt(lambda) / (2. * p1.x0() * p2.x0());
+      expected += xs * fm2_mb * v_rel * dt / cell_vol;
+    }
+  }
+
+  // both methods find the expected number of collisions on average
+  ExperimentParameters exp_par = Test::default_parameters();
+  exp_par.two_to_one = false;
+  const std::vector<bool> has_interacted = {};
+  for (const bool sampling : {true, false}) {
+    Configuration config = Test::configuration(
+        "Collision_Term: {Collision_Criterion: Stochastic, Isotropic: true, "
+        "Elastic_Cross_Section: " +
+        std::to_string(xs) + ", Stochastic_Pair_Sampling: " +
+        (sampling ? "true" : "false") + "}");
+    ScatterActionsFinder finder(config, exp_par, has_interacted, 0, 0);
+    constexpr int trials = 1000;
+    int found = 0;
+    for (int k = 0; k < trials; k++) {
+      found +=
+          finder.find_actions_in_cell(search_list, dt, cell_vol, {}).size();
+    }
+    const double mean = static_cast<double>(found) / trials;
+    // The standard deviation of the mean is below sqrt(expected / trials).
+    VERIFY(std::abs(mean - expected) < 7. * std::sqrt(expected / trials))
+        << "sampling: " << sampling << ", mean: " << mean
+        << ", expected: " << expected;
+  }
+}
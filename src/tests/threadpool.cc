@@ -0,0 +1,97 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "../include/smash/threadpool.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace smash;
+
+TEST(size) {
+  COMPARE(ThreadPool(1).size(), 1);
+  COMPARE(ThreadPool(4).size(), 4);
+}
+
+TEST_CATCH(invalid_size, std::invalid_argument) { ThreadPool pool(0); }
+
+TEST(all_items_processed_once) {
+  for (int n_threads : {1, 2, 4}) {
+    ThreadPool pool(n_threads);
+    // repeat to check that the workers pick up consecutive loops
+    for (std::size_t n_items : {0u, 1u, 7u, 1000u}) {
+      std::vector<std::atomic<int>> calls(n_items);
+      for (auto &c : calls) {
+        c = 0;
+      }
+      pool.parallel_for(n_items, [&](std::size_t i) { ++calls[i]; });
+      for (std::size_t i = 0; i < n_items; ++i) {
+        COMPARE(calls[i].load(), 1) << "item " << i << " with " << n_threads
+                                    << " threads";
+      }
+    }
+  }
+}
+
+TEST(exception_is_rethrown) {
+  ThreadPool pool(3);
+  std::atomic<int> calls{0};
+  bool caught = false;
+  try {
+    pool.parallel_for(100, [&](std::size_t i) {
+      ++calls;
+      if (i == 42) {
+        throw std::runtime_error("item 42");
+      }
+    });
+  } catch (std::runtime_error &e) {
+    caught = true;
+    COMPARE(std::string(e.what()), "item 42");
+  }
+  VERIFY(caught);
+  // the items handed out before the failing one are completed
+  VERIFY(calls.load() >= 43) << calls.load();
+  // and the pool is still usable
+  calls = 0;
+  pool.parallel_for(10, [&](std::size_t) { ++calls; });
+  COMPARE(calls.load(), 10);
+}
+
+TEST(no_items_started_after_failure) {
+  ThreadPool pool(4);
+  std::vector<std::atomic<int>> calls(10000);
+  for (auto &c : calls) {
+    c = 0;
+  }
+  bool caught = false;
+  try {
+    pool.parallel_for(calls.size(), [&](std::size_t i) {
+      ++calls[i];
+      if (i == 0) {
+        throw std::runtime_error("item 0");
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+  } catch (std::runtime_error &) {
+    caught = true;
+  }
+  VERIFY(caught);
+  // The other threads finish the items they already started and then stop,
+  // instead of processing all items.
+  int processed = 0;
+  for (auto &c : calls) {
+    processed += c;
+  }
+  VERIFY(processed < 100) << processed;
+}
@@ -0,0 +1,116 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include <vir/test.h>  // This include has to be first
+
+#include "setup.h"
+
+#include <set>
+#include <utility>
+
+#include "../include/smash/verletlists.h"
+
+using namespace smash;
+
+// Formation times are not involved, so the timestep is a dummy value.
+static constexpr double timestep = 10.0;
+static constexpr double interaction_length = 1.0;
+static constexpr double skin = 0.5;
+
+TEST(init) { Test::create_smashon_particletypes(); }
+
+TEST_CATCH(invalid_skin, std::invalid_argument) { VerletLists lists(0.); }
+
+TEST(pairs) {
+  using Test::Position;
+  VerletLists lists(skin);
+  const double cell_length = lists.grid_cell_length(interaction_length);
+  COMPARE(cell_length, interaction_length + skin);
+  Particles particles;
+  for (int x = 0; x < 5; ++x) {
+    for (int y = 0; y < 5; ++y) {
+      for (int z = 0; z < 5; ++z) {
+        particles.insert(
+            Test::smashon(Position{0., 0.8 * x, 0.8 * y, 0.8 * z}));
+      }
+    }
+  }
+  Grid<GridOptions::Normal> grid(particles, cell_length, timestep);
+
+  // Checks that every pair closer than the interaction length is found once
+  // and that no pair is found twice.
+  auto &&verify_pairs = [&]() {
+    std::set<std::pair<int, int>> pairs;
+    std::vector<unsigned> partners;
+    for (const ParticleData &p : particles) {
+      lists.collect_partners(grid, particles, p, partners);
+      for (const ParticleData &q : particles.view(partners)) {
+        VERIFY(p.id() != q.id()) << p;
+        VERIFY(pairs.insert({std::min(p.id(), q.id()),
+                             std::max(p.id(), q.id())})
+                   .second)
+            << "\np: " << p << "\nq: " << q;
+      }
+    }
+    for (const ParticleData &p : particles) {
+      for (const ParticleData &q : particles) {
+        const double sqr_distance =
+            (p.position().threevec() - q.position().threevec()).sqr();
+        if (p.id() < q.id() &&
+            sqr_distance < interaction_length * interaction_length) {
+          VERIFY(pairs.count({p.id(), q.id()}) == 1)
+              << "\np: " << p << "\nq: " << q;
+        }
+      }
+    }
+  };
+
+  VERIFY(lists.update(grid, particles, interaction_length, timestep));
+  for (const ParticleData &p : particles) {
+    VERIFY(lists.is_listed(p)) << p;
+  }
+  verify_pairs();
+
+  // small moves keep the lists
+  int n = 0;
+  for (ParticleData &p : particles) {
+    if (n++ % 3 == 0) {
+      p.set_4position(p.position() + FourVector(0., 0.2, -0.1, 0.));
+    }
+  }
+  grid.update(particles, cell_length, timestep);
+  VERIFY(!lists.update(grid, particles, interaction_length, timestep));
+  verify_pairs();
+
+  // replace a particle, the new one is not listed
+  const ParticleData removed = particles.front();
+  grid.remove(removed);
+  particles.remove(removed);
+  const ParticleData &created =
+      particles.insert(Test::smashon(Position{0., 1.2, 0.3, 0.5}));
+  grid.insert(created, timestep);
+  VERIFY(!lists.is_listed(created));
+  VERIFY(!lists.update(grid, particles, interaction_length, timestep));
+  verify_pairs();
+
+  // larger moves require a rebuild
+  n = 0;
+  for (ParticleData &p : particles) {
+    if (n++ % 3 == 0) {
+      p.set_4position(p.position() + FourVector(0., 0.3, 0., 0.2));
+    }
+  }
+  grid.update(particles, cell_length, timestep);
+  VERIFY(lists.update(grid, particles, interaction_length, timestep));
+  VERIFY(lists.is_listed(particles.back()));
+  verify_pairs();
+
+  COMPARE(lists.number_of_builds(), 2u);
+  COMPARE(lists.number_of_updates(), 4u);
+}
@@ -9,6 +9,8 @@
 
 #include <vir/test.h>  // This include has to be first
 
+#include <vector>
+
 #include "setup.h"
 
 #include "../include/smash/integrate.h"
@@ -136,3 +138,70 @@ TEST(photon_widths) {
   COMPARE_ABSOLUTE_ERROR(phi.get_partial_width(phi.mass(), pi0, photon),
                          5.4068538571729e-6, err);
 }
+
+// This has to be the last test, since it changes the widths of all types.
+TEST(tabulated_widths) {
+  /* The spectral functions computed directly, for resonances of different
+   * widths, on the masses tested below and at the pole mass. This is slow,
+   * since the widths of the decay products are computed directly, too. */
+  const std::vector<PdgCode> resonances = {0x113, 0x223, 0x331, 0x229,
+                                           0x2224, 0x12212};
+  std::vector<std::vector<double>> spectral_functions;
+  for (const PdgCode pdg : resonances) {
+    const ParticleType &type = ParticleType::find(pdg);
+    const double m_min = type.min_mass_kinematic();
+    const double m_max = type.mass() + ParticleType::width_tabulation_range;
+    spectral_functions.emplace_back();
+    for (int i = 0; i <= 100; ++i) {
+      const double m = m_min + (m_max - m_min) * i * i / 1e4;
+      spectral_functions.back().push_back(type.spectral_function(m));
+    }
+    spectral_functions.back().push_back(type.spectral_function(type.mass()));
+  }
+
+  ParticleType::enable_width_tabulation(sha256::Hash(), "");
+  for (const ParticleType &type : ParticleType::list_all()) {
+    if (type.is_stable()) {
+      continue;
+    }
+    const double m_min = type.min_mass_kinematic();
+    const double m_max = type.mass() + ParticleType::width_tabulation_range;
+    /* The interpolation is least accurate at the kinks of the opening
+     * thresholds of the decay channels. */
+    const double tolerance = 0.01 * type.width_at_pole();
+    for (int i = 0; i <= 100; ++i) {
+      const double m = m_min + (m_max - m_min) * i * i / 1e4;
+      const double direct = type.total_width(m, WhichDecaymodes::All);
+      const double tabulated = type.total_width(m);
+      COMPARE_ABSOLUTE_ERROR(
+          tabulated, direct < ParticleType::width_cutoff ? 0. : direct,
+          tolerance)
+          << type.name() << " at m = " << m;
+    }
+    /* Above the range, the widths are computed, but they depend on the
+     * tabulated widths of unstable decay products. */
+    const double m = m_max + 1.;
+    const double direct = type.total_width(m, WhichDecaymodes::All);
+    COMPARE_ABSOLUTE_ERROR(type.total_width(m),
+                           direct < ParticleType::width_cutoff ? 0. : direct,
+                           tolerance)
+        << type.name();
+  }
+
+  for (size_t j = 0; j < resonances.size(); ++j) {
+    const ParticleType &type = ParticleType::find(resonances[j]);
+    const double m_min = type.min_mass_kinematic();
+    const double m_max = type.mass() + ParticleType::width_tabulation_range;
+    // relative to the value at the pole
+    const double tolerance = 0.01 * spectral_functions[j].back();
+    for (int i = 0; i <= 100; ++i) {
+      const double m = m_min + (m_max - m_min) * i * i / 1e4;
+      COMPARE_ABSOLUTE_ERROR(type.spectral_function(m),
+                             spectral_functions[j][i], tolerance)
+          << type.name() << " at m = " << m;
+    }
+    COMPARE_ABSOLUTE_ERROR(type.spectral_function(type.mass()),
+                           spectral_functions[j].back(), tolerance)
+        << type.name();
+  }
+}
@@ -0,0 +1,104 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/threadpool.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace smash {
+
+ThreadPool::ThreadPool(int n_threads) {
+  if (n_threads < 1) {
+    throw std::invalid_argument("The number of threads has to be positive, " +
+                                std::to_string(n_threads) + " was given.");
+  }
+  workers_.reserve(n_threads - 1);
+  for (int i = 1; i < n_threads; ++i) {
+    workers_.emplace_back(&ThreadPool::work, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::parallel_for(std::size_t n_items,
+                              const std::function<void(std::size_t)> &func) {
+  if (workers_.empty() || n_items < 2) {
+    for (std::size_t i = 0; i < n_items; ++i) {
+      func(i);
+    }
+    return;
+  }
+  failed_ = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    func_ = &func;
+    n_items_ = n_items;
+    next_item_ = 0;
+    busy_workers_ = workers_.size();
+    error_ = nullptr;
+    ++loop_count_;
+  }
+  start_.notify_all();
+  run_items();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this]() { return busy_workers_ == 0; });
+  func_ = nullptr;
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+void ThreadPool::work() {
+  std::size_t seen_loops = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock,
+                  [&]() { return stop_ || loop_count_ != seen_loops; });
+      if (stop_) {
+        return;
+      }
+      seen_loops = loop_count_;
+    }
+    run_items();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --busy_workers_;
+    }
+    done_.notify_one();
+  }
+}
+
+void ThreadPool::run_items() {
+  for (std::size_t i = next_item_++; i < n_items_ && !failed_;
+       i = next_item_++) {
+    try {
+      (*func_)(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+      failed_ = true;
+    }
+  }
+}
+
+}  // namespace smash
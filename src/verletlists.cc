@@ -0,0 +1,149 @@
+/*
+ *
+ *    Copyright (c) 2020 -
+ *      SMASH Team
+ *
+ *    GNU General Public License (GPLv3 or later)
+ *
+ */
+
+#include "smash/verletlists.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "smash/logging.h"
+
+namespace smash {
+static constexpr int LGrid = LogArea::Grid::id;
+
+VerletLists::VerletLists(double skin) : skin_(skin) {
+  if (!(skin_ > 0.)) {
+    throw std::invalid_argument("The skin of the Verlet lists (" +
+                                std::to_string(skin_) +
+                                " fm) has to be positive.");
+  }
+}
+
+template <GridOptions O>
+bool VerletLists::update(const Grid<O> &grid, const Particles &particles,
+                         double interaction_length,
+                         double timestep_duration) {
+  ++number_of_updates_;
+  bool rebuild = number_of_builds_ == 0;
+  if (!rebuild) {
+    // Largest displacement of a listed particle since the build
+    const ParticleColumns &columns = particles.columns();
+    double max_distance_sqr = 0.;
+    std::size_t unlisted = 0;
+    for (unsigned i = 0; i < columns.size; ++i) {
+      if (!columns.is_particle(i)) {
+        continue;
+      }
+      if (!is_listed(particles.at_index(i))) {
+        ++unlisted;
+        continue;
+      }
+      const double dx = columns.x[i] - x_[i], dy = columns.y[i] - y_[i],
+                   dz = columns.z[i] - z_[i];
+      max_distance_sqr =
+          std::max(max_distance_sqr, dx * dx + dy * dy + dz * dz);
+    }
+    /* Two particles approach each other by at most twice the largest
+     * displacement. */
+    rebuild = interaction_length + 2. * std::sqrt(max_distance_sqr) > radius_ ||
+              4 * unlisted > particles.size();
+  }
+  if (rebuild) {
+    build(grid, particles, interaction_length, timestep_duration);
+  }
+  return rebuild;
+}
+
+template <GridOptions O>
+void VerletLists::build(const Grid<O> &grid, const Particles &particles,
+                        double interaction_length,
+                        double timestep_duration) {
+  ++number_of_builds_;
+  radius_ = grid_cell_length(interaction_length);
+  const double radius_sqr = radius_ * radius_;
+  const ParticleColumns &columns = particles.columns();
+  ids_.assign(columns.size, -1);
+  x_.resize(columns.size);
+  y_.resize(columns.size);
+  z_.resize(columns.size);
+  offsets_.assign(columns.size + 1, 0);
+  neighbors_.clear();
+  for (unsigned i = 0; i < columns.size; ++i) {
+    offsets_[i] = neighbors_.size();
+    if (!columns.is_particle(i)) {
+      continue;
+    }
+    const ParticleData &p = particles.at_index(i);
+    if (!grid.is_on_grid(p, timestep_duration)) {
+      continue;
+    }
+    ids_[i] = p.id();
+    x_[i] = columns.x[i];
+    y_[i] = columns.y[i];
+    z_[i] = columns.z[i];
+    grid.iterate_neighborhood(p, [&](const ParticleListView &cell) {
+      for (const ParticleData &q : cell) {
+        const unsigned j = q.index();
+        const double dx = columns.x[j] - x_[i], dy = columns.y[j] - y_[i],
+                     dz = columns.z[j] - z_[i];
+        if (j != i && dx * dx + dy * dy + dz * dz < radius_sqr) {
+          neighbors_.push_back(j);
+        }
+      }
+    });
+  }
+  offsets_[columns.size] = neighbors_.size();
+  logg[LGrid].debug("Built Verlet lists with radius ", radius_, " fm and ",
+                    neighbors_.size(), " entries.");
+}
+
+template <GridOptions O>
+void VerletLists::collect_partners(const Grid<O> &grid,
+                                   const Particles &particles,
+                                   const ParticleData &p,
+                                   std::vector<unsigned> &partners) const {
+  partners.clear();
+  const int id = p.id();
+  if (is_listed(p)) {
+    const unsigned i = p.index();
+    for (std::size_t k = offsets_[i]; k < offsets_[i + 1]; ++k) {
+      const unsigned j = neighbors_[k];
+      // The pair is found from the particle with the smaller id, and the
+      // entry may have been reused for a new particle.
+      if (ids_[j] > id && particles.holds_particle(j) &&
+          particles.at_index(j).id() == ids_[j]) {
+        partners.push_back(j);
+      }
+    }
+    return;
+  }
+  grid.iterate_neighborhood(p, [&](const ParticleListView &cell) {
+    for (const ParticleData &q : cell) {
+      if (q.id() != id && (is_listed(q) || q.id() > id)) {
+        partners.push_back(q.index());
+      }
+    }
+  });
+}
+
+template bool VerletLists::update(const Grid<GridOptions::Normal> &,
+                                  const Particles &, double, double);
+template bool VerletLists::update(
+    const Grid<GridOptions::PeriodicBoundaries> &, const Particles &, double,
+    double);
+template void VerletLists::collect_partners(const Grid<GridOptions::Normal> &,
+                                            const Particles &,
+                                            const ParticleData &,
+                                            std::vector<unsigned> &) const;
+template void VerletLists::collect_partners(
+    const Grid<GridOptions::PeriodicBoundaries> &, const Particles &,
+    const ParticleData &, std::vector<unsigned> &) const;
+
+}  // namespace smash